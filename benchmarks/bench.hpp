@@ -0,0 +1,293 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include <strictpp/strict.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+// Minimal benchmark harness built on spp::timer, so that benchmarks only depend on strictpp.
+namespace spp::bench {
+
+
+// Prevents the compiler from removing the computation of x.
+template <typename T>
+inline void do_not_optimize(const T& x) {
+#if defined(__GNUC__)
+   asm volatile("" : : "g"(&x) : "memory");
+#else
+   static volatile const void* sink;
+   sink = &x;
+#endif
+}
+
+
+template <typename T>
+std::string type_name() {
+   if constexpr(SameAs<T, float>) {
+      return "float";
+   } else if constexpr(SameAs<T, double>) {
+      return "double";
+   } else if constexpr(SameAs<T, long double>) {
+      return "long double";
+   } else {
+      return "unknown";
+   }
+}
+
+
+// Bytes and floating-point operations are nominal, i.e. the ones of the straightforward
+// algorithm: each element of every operand is read once, each element of the result is
+// written once, and functions such as exp count as zero operations. Layout is "-" for
+// one-dimensional arrays.
+struct Case {
+   std::string name;
+   std::string type;
+   std::string layout;
+   long int size;
+   double bytes;
+   double flops;
+   std::function<void()> f;
+};
+
+
+struct Result {
+   std::string name;
+   std::string type;
+   std::string layout;
+   long int size;
+   long int iterations;
+   double seconds;
+   double bytes;
+   double flops;
+
+   double ns_per_element() const {
+      return seconds * 1.e9 / static_cast<double>(std::max(1L, size));
+   }
+
+   double gbs() const {
+      return bytes / seconds * 1.e-9;
+   }
+
+   double gflops() const {
+      return flops / seconds * 1.e-9;
+   }
+};
+
+
+struct Options {
+   std::string filter;
+   double min_time = 0.05;
+   long int repetitions = 3;
+   long int max_size = 1L << 22;
+   bool list = false;
+   std::string json;
+   std::string csv;
+};
+
+
+// Sizes of one-dimensional arrays of doubles that fit into L1, L2, L3 caches, and DRAM.
+inline std::vector<long int> sizes1D() {
+   return {1L << 10, 1L << 14, 1L << 18, 1L << 22};
+}
+
+
+// Number of rows and columns of square arrays of doubles for the same levels of memory.
+inline std::vector<long int> sizes2D() {
+   return {32, 128, 512, 2'048};
+}
+
+
+// Calls f a number of times that takes at least min_time seconds and returns the time of a
+// single call. Reported is the median over repetitions, which is robust to interruptions.
+inline Result run(const Case& c, const Options& opt) {
+   c.f();
+
+   long int iterations = 1;
+   while(true) {
+      timer t;
+      for(long int k = 0; k < iterations; ++k) {
+         c.f();
+      }
+      double s = t.wall_time().val();
+      if(s >= opt.min_time / 10. || iterations >= 1'000'000'000L) {
+         const double scale = opt.min_time / s;
+         iterations = std::max(1L, static_cast<long int>(scale * static_cast<double>(iterations)));
+         break;
+      }
+      iterations *= 10;
+   }
+
+   std::vector<double> times;
+   for(long int r = 0; r < opt.repetitions; ++r) {
+      timer t;
+      for(long int k = 0; k < iterations; ++k) {
+         c.f();
+      }
+      times.push_back(t.wall_time().val() / static_cast<double>(iterations));
+   }
+   std::sort(times.begin(), times.end());
+   return {c.name,  c.type,  c.layout, c.size, iterations, times[times.size() / 2],
+           c.bytes, c.flops};
+}
+
+
+inline void print_header(std::ostream& os) {
+   os << std::left << std::setw(32) << "benchmark" << std::setw(8) << "type" << std::setw(10)
+      << "layout" << std::right << std::setw(10) << "size" << std::setw(14) << "time(ns)"
+      << std::setw(10) << "GB/s" << std::setw(10) << "GFLOP/s" << '\n'
+      << std::string(94, '-') << '\n';
+}
+
+
+inline void print_result(std::ostream& os, const Result& r) {
+   std::ostringstream line;
+   line << std::left << std::setw(32) << r.name << std::setw(8) << r.type << std::setw(10)
+        << r.layout << std::right << std::setw(10) << r.size << std::fixed << std::setprecision(1)
+        << std::setw(14) << r.seconds * 1.e9
+        << std::setprecision(2) << std::setw(10) << r.gbs() << std::setw(10);
+   if(r.flops > 0.) {
+      line << r.gflops();
+   } else {
+      line << "-";
+   }
+   os << line.str() << '\n';
+}
+
+
+// Machine-readable results. Times are in nanoseconds and are written with enough digits
+// to compare results of different runs. JSON results are written one benchmark per line.
+inline void write_csv(std::ostream& os, const std::vector<Result>& results) {
+   os << "kernel,type,size,layout,iterations,time_ns,ns_per_element,gb_per_s,gflop_per_s\n";
+   os << std::setprecision(6);
+   for(const auto& r : results) {
+      os << r.name << ',' << r.type << ',' << r.size << ',' << r.layout << ',' << r.iterations
+         << ',' << r.seconds * 1.e9 << ',' << r.ns_per_element() << ',' << r.gbs() << ','
+         << r.gflops() << '\n';
+   }
+}
+
+
+inline void write_json(std::ostream& os, const std::vector<Result>& results) {
+   os << "{\n\"benchmarks\": [\n" << std::setprecision(6);
+   for(std::size_t i = 0; i < results.size(); ++i) {
+      const auto& r = results[i];
+      os << "{\"kernel\": \"" << r.name << "\", \"type\": \"" << r.type
+         << "\", \"size\": " << r.size << ", \"layout\": \"" << r.layout
+         << "\", \"iterations\": " << r.iterations << ", \"time_ns\": " << r.seconds * 1.e9
+         << ", \"ns_per_element\": " << r.ns_per_element() << ", \"gb_per_s\": " << r.gbs()
+         << ", \"gflop_per_s\": " << r.gflops() << '}' << (i + 1 < results.size() ? "," : "")
+         << '\n';
+   }
+   os << "]\n}\n";
+}
+
+
+inline bool write_file(const std::string& file_name, const std::vector<Result>& results,
+                       void (*write)(std::ostream&, const std::vector<Result>&)) {
+   std::ofstream os{file_name};
+   write(os, results);
+   if(!os) {
+      std::cerr << "could not write " << file_name << '\n';
+      return false;
+   }
+   return true;
+}
+
+
+class Suite {
+public:
+   // make is called by the harness to create the benchmark, so that operands of the benchmarks
+   // that are filtered out are never allocated.
+   void add(std::string name, std::string type, std::string layout, long int size, double bytes,
+            double flops, std::function<std::function<void()>()> make) {
+      entries_.push_back({{std::move(name), std::move(type), std::move(layout), size, bytes, flops,
+                           nullptr},
+                          std::move(make)});
+   }
+
+   int main(int argc, char* argv[]) {
+      auto usage = [argv](std::ostream& os) {
+         os << "usage: " << argv[0]
+            << " [--filter=substring] [--min-time=seconds] [--repetitions=n]"
+               " [--max-size=elements] [--list] [--json=file] [--csv=file] [--help]\n";
+      };
+      Options opt;
+      for(int i = 1; i < argc; ++i) {
+         std::string_view arg{argv[i]};
+         if(arg.starts_with("--filter=")) {
+            opt.filter = arg.substr(9);
+         } else if(arg.starts_with("--min-time=")) {
+            opt.min_time = std::stod(std::string{arg.substr(11)});
+         } else if(arg.starts_with("--repetitions=")) {
+            opt.repetitions = std::max(1L, std::stol(std::string{arg.substr(14)}));
+         } else if(arg.starts_with("--max-size=")) {
+            opt.max_size = std::stol(std::string{arg.substr(11)});
+         } else if(arg == "--list") {
+            opt.list = true;
+         } else if(arg.starts_with("--json=")) {
+            opt.json = arg.substr(7);
+         } else if(arg.starts_with("--csv=")) {
+            opt.csv = arg.substr(6);
+         } else if(arg == "--help") {
+            usage(std::cout);
+            return EXIT_SUCCESS;
+         } else {
+            usage(std::cerr);
+            return EXIT_FAILURE;
+         }
+      }
+
+      if(!opt.list) {
+         print_header(std::cout);
+      }
+      std::vector<Result> results;
+      for(const auto& e : entries_) {
+         const auto& c = e.c;
+         if(c.name.find(opt.filter) == std::string::npos || c.size > opt.max_size) {
+            continue;
+         }
+         if(opt.list) {
+            std::cout << c.name << ' ' << c.type << ' ' << c.layout << ' ' << c.size << '\n';
+            continue;
+         }
+         Case to_run = c;
+         to_run.f = e.make();
+         results.push_back(run(to_run, opt));
+         print_result(std::cout, results.back());
+      }
+
+      bool written = true;
+      if(!opt.json.empty()) {
+         written = write_file(opt.json, results, write_json) && written;
+      }
+      if(!opt.csv.empty()) {
+         written = write_file(opt.csv, results, write_csv) && written;
+      }
+      return written ? EXIT_SUCCESS : EXIT_FAILURE;
+   }
+
+private:
+   struct Entry {
+      Case c;
+      std::function<std::function<void()>()> make;
+   };
+
+   std::vector<Entry> entries_;
+};
+
+
+} // namespace spp::bench
@@ -0,0 +1,193 @@
+// Compares two result files written by strictpp_bench --json=file or --csv=file.
+//
+// usage: bench_compare baseline current [--threshold=fraction]
+//
+// A benchmark regressed if its time per element in current exceeds the one in baseline by
+// more than threshold, 0.1 by default, which accounts for the noise between runs. Benchmarks
+// are matched by kernel, type, size, and layout; the ones present in only one of the files
+// are reported but are not regressions. Returns 0 if there are no regressions, 1 if there
+// are, and 2 if the arguments are invalid or the files could not be read.
+
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+
+using Key = std::tuple<std::string, std::string, long int, std::string>;
+
+
+// Reads the value of "name": value on a line of JSON results.
+static bool json_value(const std::string& line, const std::string& name, std::string& value) {
+   const std::string pattern = '"' + name + "\": ";
+   auto first = line.find(pattern);
+   if(first == std::string::npos) {
+      return false;
+   }
+   first += pattern.size();
+   if(line[first] == '"') {
+      auto last = line.find('"', first + 1);
+      if(last == std::string::npos) {
+         return false;
+      }
+      value = line.substr(first + 1, last - first - 1);
+   } else {
+      value = line.substr(first, line.find_first_of(",}", first) - first);
+   }
+   return true;
+}
+
+
+static bool read_json_line(const std::string& line, Key& key, double& ns) {
+   std::string kernel, type, size, layout, time;
+   if(!json_value(line, "kernel", kernel) || !json_value(line, "type", type)
+      || !json_value(line, "size", size) || !json_value(line, "layout", layout)
+      || !json_value(line, "ns_per_element", time)) {
+      return false;
+   }
+   key = {kernel, type, std::stol(size), layout};
+   ns = std::stod(time);
+   return true;
+}
+
+
+static bool read_csv_line(const std::string& line, Key& key, double& ns) {
+   std::vector<std::string> fields;
+   std::istringstream is{line};
+   for(std::string field; std::getline(is, field, ',');) {
+      fields.push_back(field);
+   }
+   if(fields.size() != 9 || fields[0] == "kernel") {
+      return false;
+   }
+   key = {fields[0], fields[1], std::stol(fields[2]), fields[3]};
+   ns = std::stod(fields[6]);
+   return true;
+}
+
+
+static bool read_results(const std::string& file_name, std::map<Key, double>& results) {
+   std::ifstream is{file_name};
+   if(!is) {
+      std::cerr << "could not open " << file_name << '\n';
+      return false;
+   }
+
+   const bool json = std::string_view{file_name}.ends_with(".json");
+   try {
+      for(std::string line; std::getline(is, line);) {
+         Key key;
+         double ns;
+         if(json ? read_json_line(line, key, ns) : read_csv_line(line, key, ns)) {
+            results[key] = ns;
+         }
+      }
+   } catch(const std::exception&) {
+      std::cerr << "could not parse " << file_name << '\n';
+      return false;
+   }
+
+   if(results.empty()) {
+      std::cerr << "no results in " << file_name << '\n';
+      return false;
+   }
+   return true;
+}
+
+
+static void print_key(const Key& key) {
+   const auto& [kernel, type, size, layout] = key;
+   std::cout << std::left << std::setw(32) << kernel << std::setw(8) << type << std::setw(10)
+             << layout << std::right << std::setw(10) << size;
+}
+
+
+int main(int argc, char* argv[]) {
+   std::vector<std::string> files;
+   double threshold = 0.1;
+   for(int i = 1; i < argc; ++i) {
+      std::string_view arg{argv[i]};
+      if(arg.starts_with("--threshold=")) {
+         // Malformed and negative thresholds are invalid arguments.
+         const std::string value{arg.substr(12)};
+         std::size_t end = 0;
+         try {
+            threshold = std::stod(value, &end);
+         } catch(const std::exception&) {
+            end = 0;
+         }
+         if(end == 0 || end != value.size() || !(threshold >= 0.)) {
+            files.clear();
+            break;
+         }
+      } else if(!arg.starts_with("--")) {
+         files.emplace_back(arg);
+      } else {
+         files.clear();
+         break;
+      }
+   }
+   if(files.size() != 2) {
+      std::cerr << "usage: " << argv[0] << " baseline current [--threshold=fraction]\n";
+      return 2;
+   }
+
+   std::map<Key, double> baseline, current;
+   if(!read_results(files[0], baseline) || !read_results(files[1], current)) {
+      return 2;
+   }
+
+   std::cout << std::left << std::setw(32) << "benchmark" << std::setw(8) << "type"
+             << std::setw(10) << "layout" << std::right << std::setw(10) << "size"
+             << std::setw(14) << "base(ns/el)" << std::setw(14) << "new(ns/el)" << std::setw(10)
+             << "ratio" << '\n'
+             << std::string(98, '-') << '\n'
+             << std::fixed;
+
+   long int regressions = 0, improvements = 0;
+   for(const auto& [key, ns] : current) {
+      auto it = baseline.find(key);
+      if(it == baseline.end()) {
+         continue;
+      }
+      const double ratio = ns / it->second;
+      print_key(key);
+      std::cout << std::setprecision(4) << std::setw(14) << it->second << std::setw(14) << ns
+                << std::setprecision(3) << std::setw(10) << ratio;
+      if(ratio > 1. + threshold) {
+         std::cout << "  REGRESSION";
+         ++regressions;
+      } else if(ratio < 1. / (1. + threshold)) {
+         std::cout << "  improvement";
+         ++improvements;
+      }
+      std::cout << '\n';
+   }
+
+   for(const auto& [key, ns] : baseline) {
+      if(!current.contains(key)) {
+         std::cout << "only in " << files[0] << ": ";
+         print_key(key);
+         std::cout << '\n';
+      }
+   }
+   for(const auto& [key, ns] : current) {
+      if(!baseline.contains(key)) {
+         std::cout << "only in " << files[1] << ": ";
+         print_key(key);
+         std::cout << '\n';
+      }
+   }
+
+   std::cout << regressions << " regression(s), " << improvements
+             << " improvement(s), threshold " << std::setprecision(2) << threshold << '\n';
+   return regressions == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
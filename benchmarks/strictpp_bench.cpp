@@ -0,0 +1,272 @@
+#include "bench.hpp"
+
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+using namespace spp;
+using namespace spp::bench;
+
+
+template <typename T = double>
+static Array1D<T> init1D(long int n) {
+   return random(n, Strict<T>{T(-1)}, Strict<T>{T(1)});
+}
+
+
+template <typename T = double>
+static Array1D<T> init1D_positive(long int n) {
+   return random(n, Strict<T>{T(1)}, Strict<T>{T(2)});
+}
+
+
+static Array2D<double> init2D(long int n) {
+   Array2D<double> A(n, n);
+   random(A, Low{-1._sd}, High{1._sd});
+   return A;
+}
+
+
+template <typename T>
+static void add_expressions(Suite& s) {
+   for(long int n : sizes1D()) {
+      const auto d = static_cast<double>(n);
+      const auto b = static_cast<double>(sizeof(T));
+      s.add("expr/a+b+c", type_name<T>(), "-", n, 3. * b * d, 2. * d, [n] {
+         return [A = init1D<T>(n), B = init1D<T>(n), C = init1D<T>(n)]() mutable {
+            C = A + B + Strict<T>{T(2.5)};
+            do_not_optimize(C);
+         };
+      });
+      s.add("expr/a*b+c", type_name<T>(), "-", n, 4. * b * d, 2. * d, [n] {
+         return [A = init1D<T>(n), B = init1D<T>(n), C = init1D<T>(n), D = init1D<T>(n)]() mutable {
+            D = A * B + C;
+            do_not_optimize(D);
+         };
+      });
+      s.add("expr/compound_assign", type_name<T>(), "-", n, 3. * b * d, 2. * d, [n] {
+         return [A = init1D<T>(n), B = init1D<T>(n)]() mutable {
+            B += A * Strict<T>{T(1.e-9)};
+            do_not_optimize(B);
+         };
+      });
+   }
+}
+
+
+template <typename T>
+static void add_reductions(Suite& s) {
+   for(long int n : sizes1D()) {
+      const auto d = static_cast<double>(n);
+      const auto b = static_cast<double>(sizeof(T));
+      s.add("reduce/sum", type_name<T>(), "-", n, b * d, d, [n] {
+         return [A = init1D<T>(n)] { do_not_optimize(sum(A)); };
+      });
+      s.add("reduce/max", type_name<T>(), "-", n, b * d, d, [n] {
+         return [A = init1D<T>(n)] { do_not_optimize(max(A)); };
+      });
+      s.add("reduce/dot_prod", type_name<T>(), "-", n, 2. * b * d, 2. * d, [n] {
+         return [A = init1D<T>(n), B = init1D<T>(n)] { do_not_optimize(dot_prod(A, B)); };
+      });
+      s.add("reduce/norm2", type_name<T>(), "-", n, b * d, 2. * d, [n] {
+         return [A = init1D<T>(n)] { do_not_optimize(norm2(A)); };
+      });
+      s.add("reduce/reduce_many", type_name<T>(), "-", n, b * d, 3. * d, [n] {
+         return [A = init1D<T>(n)] {
+            do_not_optimize(reduce_many(A, sum_op{}, min_op{}, max_op{}));
+         };
+      });
+   }
+}
+
+
+template <typename T>
+static void add_stable_ops(Suite& s) {
+   for(long int n : sizes1D()) {
+      const auto d = static_cast<double>(n);
+      const auto b = static_cast<double>(sizeof(T));
+      s.add("stable/stable_sum", type_name<T>(), "-", n, b * d, d, [n] {
+         return [A = init1D<T>(n)] { do_not_optimize(stable_sum(A)); };
+      });
+      s.add("stable/stable_dot_prod", type_name<T>(), "-", n, 2. * b * d, 2. * d, [n] {
+         return [A = init1D<T>(n), B = init1D<T>(n)] { do_not_optimize(stable_dot_prod(A, B)); };
+      });
+      s.add("stable/stable_norm2", type_name<T>(), "-", n, b * d, 2. * d, [n] {
+         return [A = init1D<T>(n)] { do_not_optimize(stable_norm2(A)); };
+      });
+   }
+}
+
+
+template <typename T>
+static void add_math(Suite& s) {
+   for(long int n : sizes1D()) {
+      const auto d = static_cast<double>(n);
+      const auto b = static_cast<double>(sizeof(T));
+      s.add("math/exp", type_name<T>(), "-", n, 2. * b * d, 0., [n] {
+         return [A = init1D<T>(n), B = init1D<T>(n)]() mutable {
+            B = exp(A);
+            do_not_optimize(B);
+         };
+      });
+      s.add("math/exp_fast", type_name<T>(), "-", n, 2. * b * d, 0., [n] {
+         return [A = init1D<T>(n), B = init1D<T>(n)]() mutable {
+            B = exp(A, FastMath);
+            do_not_optimize(B);
+         };
+      });
+      s.add("math/log", type_name<T>(), "-", n, 2. * b * d, 0., [n] {
+         return [A = init1D_positive<T>(n), B = init1D<T>(n)]() mutable {
+            B = log(A);
+            do_not_optimize(B);
+         };
+      });
+      s.add("math/sin", type_name<T>(), "-", n, 2. * b * d, 0., [n] {
+         return [A = init1D<T>(n), B = init1D<T>(n)]() mutable {
+            B = sin(A);
+            do_not_optimize(B);
+         };
+      });
+      s.add("math/sqrt", type_name<T>(), "-", n, 2. * b * d, d, [n] {
+         return [A = init1D_positive<T>(n), B = init1D<T>(n)]() mutable {
+            B = sqrt(A);
+            do_not_optimize(B);
+         };
+      });
+   }
+}
+
+
+static void add_slices(Suite& s) {
+   for(long int n : sizes1D()) {
+      const auto h = static_cast<double>(n / 2);
+      s.add("slice/even", "double", "-", n, 24. * h, 2. * h, [n] {
+         return [A = init1D(n), B = init1D(n), C = init1D(n)]() mutable {
+            C(place::even) = A(place::even) + B(place::even) + 2.5_sd;
+            do_not_optimize(C);
+         };
+      });
+      // Index lists are read once for each of the three operands.
+      s.add("slice/index_list", "double", "-", n, 48. * h, 2. * h, [n] {
+         std::vector<ImplicitInt> indexes;
+         for(long int i = 0; i < n / 2; ++i) {
+            indexes.push_back((i * 7'919) % n);
+         }
+         return [A = init1D(n), B = init1D(n), C = init1D(n), indexes]() mutable {
+            const auto& i = indexes;
+            C(i) = A(i) + B(i) + 2.5_sd;
+            do_not_optimize(C);
+         };
+      });
+   }
+}
+
+
+static void add_2D(Suite& s) {
+   for(long int n : sizes2D()) {
+      const auto d = static_cast<double>(n * n);
+      s.add("2D/a+b+c", "double", "RowMajor", n * n, 24. * d, 2. * d, [n] {
+         return [A = init2D(n), B = init2D(n), C = init2D(n)]() mutable {
+            C = A + B + 2.5_sd;
+            do_not_optimize(C);
+         };
+      });
+      s.add("2D/row_reduce_sum", "double", "RowMajor", n * n, 8. * d, d, [n] {
+         return [A = init2D(n), x = init1D(n)]() mutable {
+            x = row_reduce(A, [](auto row) { return sum(row); });
+            do_not_optimize(x);
+         };
+      });
+      s.add("2D/col_reduce_sum", "double", "RowMajor", n * n, 8. * d, d, [n] {
+         return [A = init2D(n), x = init1D(n)]() mutable {
+            x = col_reduce(A, [](auto col) { return sum(col); });
+            do_not_optimize(x);
+         };
+      });
+      s.add("2D/transpose", "double", "RowMajor", n * n, 16. * d, 0., [n] {
+         return [A = init2D(n), B = init2D(n)]() mutable {
+            B = transpose(A);
+            do_not_optimize(B);
+         };
+      });
+      s.add("2D/col_major_assign", "double", "ColMajor", n * n, 16. * d, 0., [n] {
+         return [A = init2D(n), B = Array2D<double, Unaligned, ColMajor>(n, n)]() mutable {
+            B = A;
+            do_not_optimize(B);
+         };
+      });
+      s.add("2D/matrix_vector_prod", "double", "RowMajor", n * n, 8. * d, 2. * d, [n] {
+         return [A = init2D(n), x = init1D(n), y = init1D(n)]() mutable {
+            matrix_vector_prod(A, x, y);
+            do_not_optimize(y);
+         };
+      });
+      if(n <= 512) {
+         const double flops = 2. * d * static_cast<double>(n);
+         s.add("2D/matrix_prod", "double", "RowMajor", n * n, 24. * d, flops, [n] {
+            return [A = init2D(n), B = init2D(n), C = init2D(n)]() mutable {
+               matrix_prod(A, B, C);
+               do_not_optimize(C);
+            };
+         });
+      }
+   }
+}
+
+
+static void add_random(Suite& s) {
+   for(long int n : sizes1D()) {
+      const auto d = static_cast<double>(n);
+      s.add("random/uniform", "double", "-", n, 8. * d, 0., [n] {
+         return [A = init1D(n)]() mutable {
+            random(A, Low{-1._sd}, High{1._sd});
+            do_not_optimize(A);
+         };
+      });
+   }
+}
+
+
+// Bytes are the ones of the binary representation of the array.
+static void add_IO(Suite& s) {
+   for(long int n : sizes1D()) {
+      const auto d = static_cast<double>(n);
+      s.add("io/write", "double", "-", n, 8. * d, 0., [n] {
+         return [A = init1D(n)] {
+            std::ostringstream os;
+            os << A;
+            do_not_optimize(os);
+         };
+      });
+      s.add("io/read", "double", "-", n, 8. * d, 0., [n] {
+         std::ostringstream os;
+         os << init1D(n);
+         return [text = os.str()] {
+            std::istringstream is{text};
+            Array1D<double> A;
+            is >> A;
+            do_not_optimize(A);
+         };
+      });
+   }
+}
+
+
+int main(int argc, char* argv[]) {
+   Suite s;
+   add_expressions<float>(s);
+   add_expressions<double>(s);
+   add_reductions<float>(s);
+   add_reductions<double>(s);
+   add_stable_ops<float>(s);
+   add_stable_ops<double>(s);
+   add_math<float>(s);
+   add_math<double>(s);
+   add_slices(s);
+   add_2D(s);
+   add_random(s);
+   add_IO(s);
+   return s.main(argc, argv);
+}
@@ -6,28 +6,56 @@
 
 #include "../StrictCommon/config.hpp"
 #include "../StrictCommon/strict_literals.hpp"
+#include "../StrictCommon/strict_math.hpp"
 #include "../StrictCommon/strict_traits.hpp"
 #include "../StrictCommon/strict_val.hpp"
+#include "../Util/profiler.hpp"
 #include "array_traits.hpp"
+#include "layout.hpp"
+#include "packet.hpp"
+#include "parallel.hpp"
+#include "statistics.hpp"
 #include "use.hpp"
 
+#include <type_traits>
+#include <utility>
+
 
 namespace spp::detail {
 
 
-template <BaseType Base, typename F>
-STRICT_CONSTEXPR_INLINE void apply0(Base& A, F f) {
-   for(index_t i = 0_sl; i < A.size(); ++i) {
+// Calls f(i) for i in [0, n), in parallel if enabled. Base1 is the type of
+// the evaluated expression and Base2 is the type of the destination.
+template <BaseType Base1, BaseType Base2, typename F>
+STRICT_CONSTEXPR_INLINE void apply_range(index_t n, F f) {
+   count_evaluation();
+   if constexpr(ParallelEvaluable<Base1, Base2>) {
+      if(!std::is_constant_evaluated() && use_parallel(n)) {
+         parallel_for(n, cache_line_elements<ValueTypeOf<Base2>>(),
+                      [&f](index_t first, index_t last) {
+                         for(index_t i = first; i < last; ++i) {
+                            f(i);
+                         }
+                      });
+         return;
+      }
+   }
+
+   for(index_t i = 0_sl; i < n; ++i) {
       f(i);
    }
 }
 
 
+template <BaseType Base, typename F>
+STRICT_CONSTEXPR_INLINE void apply0(Base& A, F f) {
+   apply_range<Base, Base>(A.size(), f);
+}
+
+
 template <BaseType Base1, BaseType Base2, typename F>
 STRICT_CONSTEXPR_INLINE void apply1(Base1& A1, [[maybe_unused]] const Base2& A2, F f) {
-   for(index_t i = 0_sl; i < A1.size(); ++i) {
-      f(i);
-   }
+   apply_range<Base2, Base1>(A1.size(), f);
 }
 
 
@@ -58,29 +86,210 @@ STRICT_CONSTEXPR_INLINE void copy(use::List2D<T> L, Base& A) {
 }
 
 
+template <long int N, bool aligned, PacketType Base, Builtin T>
+STRICT_INLINE void copy_packets(const Base& A, Strict<T>* STRICT_RESTRICT p, index_t first,
+                                index_t last) {
+   for(index_t i = first; i < last; i += index_t{N}) {
+      store_packet<N, aligned>(p + i.val(), packet_at<N>(A, i));
+   }
+}
+
+
+// Elements are copied one at a time up to the first multiple of N, so that packets
+// of Aligned arrays are aligned, then N at a time, and the remainder one at a time.
+template <PacketType Base1, LinearArrayType Base2>
+STRICT_INLINE void copy_range_packet(const Base1& STRICT_RESTRICT A1, Base2& STRICT_RESTRICT A2,
+                                     index_t first, index_t last) {
+   constexpr long int N = packet_size<BuiltinTypeOf<Base2>>;
+   const index_t n{N};
+   const index_t head = mins((first + n - 1_sl) / n * n, last);
+   const index_t tail = maxs(head, last / n * n);
+
+   for(index_t i = first; i < head; ++i) {
+      A2.un(i) = A1.un(i);
+   }
+   if(head < tail) {
+      copy_packets<N, Base2::alignment() == 64>(A1, &A2.un(0_sl), head, tail);
+   }
+   for(index_t i = tail; i < last; ++i) {
+      A2.un(i) = A1.un(i);
+   }
+}
+
+
 template <BaseType Base1, BaseType Base2>
-STRICT_CONSTEXPR_INLINE void copy(const Base1& STRICT_RESTRICT A1, Base2& STRICT_RESTRICT A2) {
-   for(index_t i = 0_sl; i < A1.size(); ++i) {
+STRICT_CONSTEXPR_INLINE void copy_range(const Base1& STRICT_RESTRICT A1, Base2& STRICT_RESTRICT A2,
+                                        index_t first, index_t last) {
+   if constexpr(PacketType<Base1> && LinearArrayType<Base2>) {
+      if(!std::is_constant_evaluated() && is_packet_ready(A1)) {
+         copy_range_packet(A1, A2, first, last);
+         return;
+      }
+   }
+
+   for(index_t i = first; i < last; ++i) {
       A2.un(i) = A1.un(i);
    }
 }
 
 
-template <ArrayTwoDimType Base1, ArrayTwoDimType Base2>
+// Number of rows and columns of square blocks that are copied between different layouts.
+// Blocks of both arrays fit into L1 cache.
+template <typename T>
+consteval long int copy_block_size() {
+   return sizeof(T) <= 8 ? 32 : 16;
+}
+
+
+// Number of rows and columns of tiles within blocks, so that a tile fits into vector registers.
+template <typename T>
+consteval long int copy_tile_size() {
+   return sizeof(T) <= 4 ? 8 : 4;
+}
+
+
+template <TwoDimBaseType Base1, TwoDimBaseType Base2>
+STRICT_CONSTEXPR_INLINE void copy_block(const Base1& STRICT_RESTRICT A1, Base2& STRICT_RESTRICT A2,
+                                        index_t i0, index_t i1, index_t j0, index_t j1) {
+   for(index_t i = i0; i < i1; ++i) {
+      for(index_t j = j0; j < j1; ++j) {
+         A2.un(i, j) = A1.un(i, j);
+      }
+   }
+}
+
+
+// Tile is read in the order of A1 and written in the order of A2. Loops of constant length
+// allow the compiler to perform the transpose in registers.
+template <long int N, TwoDimBaseType Base1, TwoDimBaseType Base2>
+STRICT_CONSTEXPR_INLINE void copy_tile(const Base1& STRICT_RESTRICT A1, Base2& STRICT_RESTRICT A2,
+                                       index_t i0, index_t j0) {
+   constexpr auto m = static_cast<std::size_t>(N);
+   BuiltinTypeOf<Base2> t[m][m];
+   if constexpr(layout_of<Base1>() == RowMajor) {
+      for(long int i = 0; i < N; ++i) {
+         for(long int j = 0; j < N; ++j) {
+            t[i][j] = A1.un(i0 + index_t{i}, j0 + index_t{j}).val();
+         }
+      }
+   } else {
+      for(long int j = 0; j < N; ++j) {
+         for(long int i = 0; i < N; ++i) {
+            t[i][j] = A1.un(i0 + index_t{i}, j0 + index_t{j}).val();
+         }
+      }
+   }
+
+   if constexpr(layout_of<Base2>() == RowMajor) {
+      for(long int i = 0; i < N; ++i) {
+         for(long int j = 0; j < N; ++j) {
+            A2.un(i0 + index_t{i}, j0 + index_t{j}) = Strict{t[i][j]};
+         }
+      }
+   } else {
+      for(long int j = 0; j < N; ++j) {
+         for(long int i = 0; i < N; ++i) {
+            A2.un(i0 + index_t{i}, j0 + index_t{j}) = Strict{t[i][j]};
+         }
+      }
+   }
+}
+
+
+// If layouts differ, rows are copied by blocks, so that the elements of A1 and A2 that are
+// accessed by a block stay in cache even though one of them is accessed with a large stride.
+// Blocks are copied by tiles, remaining elements one at a time.
+template <TwoDimBaseType Base1, TwoDimBaseType Base2>
+STRICT_CONSTEXPR_INLINE void copy_row_range(const Base1& STRICT_RESTRICT A1,
+                                            Base2& STRICT_RESTRICT A2, index_t first,
+                                            index_t last) {
+   if constexpr(layout_of<Base1>() != layout_of<Base2>()) {
+      constexpr long int n = copy_tile_size<ValueTypeOf<Base2>>();
+      const index_t b{copy_block_size<ValueTypeOf<Base2>>()};
+      for(index_t ib = first; ib < last; ib += b) {
+         for(index_t jb = 0_sl; jb < A1.cols(); jb += b) {
+            const index_t ie = mins(ib + b, last);
+            const index_t je = mins(jb + b, A1.cols());
+            index_t i = ib;
+            for(; i + index_t{n} <= ie; i += index_t{n}) {
+               index_t j = jb;
+               for(; j + index_t{n} <= je; j += index_t{n}) {
+                  copy_tile<n>(A1, A2, i, j);
+               }
+               copy_block(A1, A2, i, i + index_t{n}, j, je);
+            }
+            copy_block(A1, A2, i, ie, jb, je);
+         }
+      }
+   } else {
+      copy_block(A1, A2, first, last, 0_sl, A1.cols());
+   }
+}
+
+
+template <BaseType Base1, BaseType Base2>
+STRICT_CONSTEXPR_INLINE void copy_linear(const Base1& STRICT_RESTRICT A1,
+                                         Base2& STRICT_RESTRICT A2) {
+   STRICT_PROFILE_SCOPE("assign");
+   count_evaluation();
+   if constexpr(ParallelEvaluable<Base1, Base2>) {
+      if(!std::is_constant_evaluated() && use_parallel(A1.size())) {
+         parallel_for(A1.size(), cache_line_elements<ValueTypeOf<Base2>>(),
+                      [&A1, &A2](index_t first, index_t last) { copy_range(A1, A2, first, last); });
+         return;
+      }
+   }
+   copy_range(A1, A2, 0_sl, A1.size());
+}
+
+
+template <BaseType Base1, BaseType Base2>
 STRICT_CONSTEXPR_INLINE void copy(const Base1& STRICT_RESTRICT A1, Base2& STRICT_RESTRICT A2) {
-   for(index_t i = 0_sl; i < A1.size(); ++i) {
-      A2.un(i) = A1.un(i);
+   copy_linear(A1, A2);
+}
+
+
+template <TwoDimBaseType Base1, TwoDimBaseType Base2>
+STRICT_CONSTEXPR_INLINE void copy_by_rows(const Base1& STRICT_RESTRICT A1,
+                                          Base2& STRICT_RESTRICT A2) {
+   STRICT_PROFILE_SCOPE("assign_by_rows");
+   count_evaluation();
+   if constexpr(ParallelEvaluable<Base1, Base2>) {
+      if(!std::is_constant_evaluated() && use_parallel(A1.size())) {
+         parallel_for(A1.rows(), 1_sl, [&A1, &A2](index_t first, index_t last) {
+            copy_row_range(A1, A2, first, last);
+         });
+         return;
+      }
    }
+   copy_row_range(A1, A2, 0_sl, A1.rows());
 }
 
 
+// Two-dimensional expressions are partitioned by rows, unless they can be evaluated by packets
+// in which case elements are accessed linearly.
 template <TwoDimBaseType Base1, TwoDimBaseType Base2>
 STRICT_CONSTEXPR_INLINE void copy(const Base1& STRICT_RESTRICT A1, Base2& STRICT_RESTRICT A2) {
-   for(index_t i = 0_sl; i < A1.rows(); ++i) {
-      for(index_t j = 0_sl; j < A1.cols(); ++j) {
-         A2.un(i, j) = A1.un(i, j);
+   if constexpr(PacketType<Base1> && LinearArrayType<Base2>) {
+      if(!std::is_constant_evaluated() && is_packet_ready(A1)) {
+         copy_linear(A1, A2);
+         return;
       }
    }
+   copy_by_rows(A1, A2);
+}
+
+
+// Column-major arrays are copied in storage order if both arrays are column-major.
+template <ArrayTwoDimType Base1, ArrayTwoDimType Base2>
+STRICT_CONSTEXPR_INLINE void copy(const Base1& STRICT_RESTRICT A1, Base2& STRICT_RESTRICT A2) {
+   if constexpr(layout_of<Base1>() == RowMajor && layout_of<Base2>() == RowMajor) {
+      copy_linear(A1, A2);
+   } else if constexpr(layout_of<Base1>() == ColMajor && layout_of<Base2>() == ColMajor) {
+      copy_linear(A1.storage(), A2.storage());
+   } else {
+      copy_by_rows(A1, A2);
+   }
 }
 
 
@@ -146,11 +355,25 @@ STRICT_CONSTEXPR_INLINE void copy_cols(const Base1& STRICT_RESTRICT A1, Base2& S
 }
 
 
+// Blocks above the diagonal are swapped with the transposed blocks below the diagonal.
+template <TwoDimBaseType Base>
+STRICT_CONSTEXPR_INLINE void transpose_square(Base& A) {
+   const index_t b{copy_block_size<ValueTypeOf<Base>>()};
+   for(index_t ib = 0_sl; ib < A.rows(); ib += b) {
+      for(index_t jb = ib; jb < A.cols(); jb += b) {
+         for(index_t i = ib; i < mins(ib + b, A.rows()); ++i) {
+            for(index_t j = jb == ib ? i + 1_sl : jb; j < mins(jb + b, A.cols()); ++j) {
+               std::swap(A.un(i, j), A.un(j, i));
+            }
+         }
+      }
+   }
+}
+
+
 template <BaseType Base>
 STRICT_CONSTEXPR_INLINE void fill(ValueTypeOf<Base> val, Base& A) {
-   for(index_t i = 0_sl; i < A.size(); ++i) {
-      A.un(i) = val;
-   }
+   apply_range<Base, Base>(A.size(), [val, &A](index_t i) { A.un(i) = val; });
 }
 
 
@@ -9,5 +9,9 @@
 #include "array_auxiliary.hpp"
 #include "array_traits.hpp"
 #include "index_helper.hpp"
+#include "layout.hpp"
+#include "memory_resource.hpp"
+#include "packet.hpp"
+#include "statistics.hpp"
 #include "use.hpp"
 #include "valid.hpp"
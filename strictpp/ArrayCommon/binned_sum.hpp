@@ -0,0 +1,197 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include "../StrictCommon/config.hpp"
+#include "../StrictCommon/strict_math.hpp"
+#include "../StrictCommon/strict_traits.hpp"
+#include "../StrictCommon/strict_val.hpp"
+#include "float_traits.hpp"
+#include "packet.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+
+namespace spp::detail {
+
+
+// Terms of float are summed in double.
+template <Floating T>
+using BinnedWorkType = std::conditional_t<SameAs<T, float>, double, T>;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Reproducible summation by pre-rounding(Demmel and Nguyen, as in ReproBLAS). The exponent
+// range of T is split into bins of width bits, bin j consists of multiples of
+// g_j = 2^(min_exponent - digits + j * width). A term x with |x| < 2^(width - 1) * g_t is
+// rounded to a multiple of g_t, the remainder to a multiple of g_(t - 1), and so on for folds
+// bins, the last remainder is dropped. The parts only depend on x and t, and are counted exactly
+// by integers. Parts of terms rounded from a lower bin t are zero in the bins above it and the
+// same in the bins below, hence blocks of terms are rounded from the bin of their largest term,
+// and sums of blocks are aligned to the highest bin when merged. The result therefore only
+// depends on the terms, and neither on their order nor on how they are split into blocks,
+// packets, and threads. The error is less than n * 2^(-(folds - 1) * width) times the largest
+// term, where (folds - 1) * width exceeds digits by at least 27 bits. Counts do not overflow for
+// fewer than 2^37 terms.
+template <Floating T>
+class BinnedSum {
+   using F = FloatTraits<T>;
+
+public:
+   static constexpr int width = 27;
+   static constexpr int folds = 1 + (F::digits + 27 + width - 1) / width;
+
+   template <typename V>
+   using Folds = std::array<V, static_cast<std::size_t>(folds)>;
+
+   // Extractors of bins top, ..., top - folds + 1 for terms multiplied by scale. Bins close to
+   // the largest numbers are scaled down by 2^shift so that extractors do not overflow.
+   struct Grid {
+      int top;
+      int shift;
+      T scale;
+      Folds<T> extractors;
+   };
+
+   // Grid of terms not exceeding m in magnitude, m must be finite.
+   static Grid grid(T m) {
+      int t = folds - 1;
+      if(m != T(0)) {
+         int e;
+         F::frexp(m, &e);
+         const int a = e - base - width + 1;
+         t = std::max(t, a > 0 ? (a + width - 1) / width : 0);
+      }
+
+      Grid g;
+      g.top = t;
+      g.shift = std::max(0, base + t * width + F::digits - F::max_exponent);
+      g.scale = F::ldexp(T(1), -g.shift);
+      for(int k = 0; k < folds; ++k) {
+         g.extractors[to_size_t(k)] = F::ldexp(T(1.5), exponent(t - k) + F::digits - 1 - g.shift);
+      }
+      return g;
+   }
+
+   // Adds the parts of x to parts. Rounding x + e to the multiple of the grid of e only depends on
+   // x, since the extractor e is an even multiple of its grid. x must be scaled. Packets of
+   // float and double are disabled under -ffast-math, while scalars use volatile temporaries.
+   template <typename V>
+   STRICT_INLINE static void deposit(const V& x, const Folds<V>& e, Folds<V>& parts) {
+      constexpr auto last = to_size_t(folds - 1);
+      V r = x;
+      for(std::size_t k = 0; k < last; ++k) {
+         V q = extract(r, e[k]);
+         r = r - q;
+         parts[k] = parts[k] + q;
+      }
+      parts[last] = parts[last] + extract(r, e[last]);
+   }
+
+   // Adds the parts of terms rounded on grid g, returns false if they are not finite.
+   bool add(const Grid& g, const Folds<T>& parts) {
+      Folds<std::int64_t> counts;
+      for(int k = 0; k < folds; ++k) {
+         const T p = parts[to_size_t(k)];
+         if(!isfinites(Strict<T>{p})) {
+            return false;
+         }
+         const T count = F::ldexp(p, g.shift - exponent(g.top - k));
+         counts[to_size_t(k)] = static_cast<std::int64_t>(count);
+      }
+      this->merge(g.top, counts);
+      return true;
+   }
+
+   void add(T x) {
+      if(isnans(Strict<T>{x})) {
+         nan_ = true;
+      } else if(!isfinites(Strict<T>{x})) {
+         (x > T(0) ? pos_inf_ : neg_inf_) = true;
+      } else {
+         const auto g = grid(x < T(0) ? -x : x);
+         Folds<T> parts{};
+         deposit(x * g.scale, g.extractors, parts);
+         this->add(g, parts);
+      }
+   }
+
+   void merge(const BinnedSum& other) {
+      this->merge(other.top_, other.counts_);
+      nan_ = nan_ || other.nan_;
+      pos_inf_ = pos_inf_ || other.pos_inf_;
+      neg_inf_ = neg_inf_ || other.neg_inf_;
+   }
+
+   // Bins are added from the lowest, compensating rounding errors. Zero is returned as positive
+   // zero.
+   STRICT_NODISCARD Strict<T> result() const {
+      if(nan_ || (pos_inf_ && neg_inf_)) {
+         return Strict<T>{F::quiet_NaN()};
+      }
+      if(pos_inf_ || neg_inf_) {
+         return Strict<T>{pos_inf_ ? F::infinity() : -F::infinity()};
+      }
+
+      Strict<T> s{T(0)}, c{T(0)};
+      auto add_term = [&s, &c](T x) {
+         const auto [r, q] = two_sums(s, Strict<T>{x});
+         s = r;
+         c += q;
+      };
+      for(int k = folds - 1; k >= 0; --k) {
+         const std::int64_t count = counts_[to_size_t(k)];
+         const std::int64_t hi = count >> 32;
+         const std::int64_t lo = count - hi * (std::int64_t{1} << 32);
+         add_term(F::ldexp(static_cast<T>(lo), exponent(top_ - k)));
+         add_term(F::ldexp(static_cast<T>(hi), exponent(top_ - k) + 32));
+      }
+      return s + c;
+   }
+
+private:
+   // Exponent of the grid of bin 0, the smallest subnormal number.
+   static constexpr int base = F::min_exponent - F::digits;
+
+   Folds<std::int64_t> counts_{};
+   int top_ = folds - 1;
+   bool nan_ = false;
+   bool pos_inf_ = false;
+   bool neg_inf_ = false;
+
+   static constexpr int exponent(int bin) {
+      return base + bin * width;
+   }
+
+   STRICT_INLINE static T extract(T x, T e) {
+      volatile T s = e + x;
+      return s - e;
+   }
+
+   template <long int N>
+   STRICT_INLINE static Packet<T, N> extract(const Packet<T, N>& x, const Packet<T, N>& e) {
+      return (e + x) - e;
+   }
+
+   void merge(int top, const Folds<std::int64_t>& counts) {
+      if(top > top_) {
+         const int d = top - top_;
+         for(int k = folds - 1; k >= 0; --k) {
+            counts_[to_size_t(k)] = k >= d ? counts_[to_size_t(k - d)] : 0;
+         }
+         top_ = top;
+      }
+      for(int k = top_ - top; k < folds; ++k) {
+         counts_[to_size_t(k)] += counts[to_size_t(k - (top_ - top))];
+      }
+   }
+};
+
+
+} // namespace spp::detail
@@ -0,0 +1,84 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include "../StrictCommon/config.hpp"
+#include "../StrictCommon/strict_traits.hpp"
+
+#include <cmath>
+#include <limits>
+
+
+namespace spp::detail {
+
+
+// Parameters of floating-point formats and exact operations on them.
+template <Floating T>
+struct FloatTraits {
+   static constexpr int digits = std::numeric_limits<T>::digits;
+   static constexpr int min_exponent = std::numeric_limits<T>::min_exponent;
+   static constexpr int max_exponent = std::numeric_limits<T>::max_exponent;
+
+   static T frexp(T x, int* e) {
+      return std::frexp(x, e);
+   }
+
+   static T ldexp(T x, int e) {
+      return std::ldexp(x, e);
+   }
+
+   static T nextafter(T x, T y) {
+      return std::nextafter(x, y);
+   }
+
+   static T denorm_min() {
+      return std::numeric_limits<T>::denorm_min();
+   }
+
+   static T infinity() {
+      return std::numeric_limits<T>::infinity();
+   }
+
+   static T quiet_NaN() {
+      return std::numeric_limits<T>::quiet_NaN();
+   }
+};
+
+
+#ifdef STRICT_QUAD_PRECISION
+template <>
+struct FloatTraits<float128> {
+   static constexpr int digits = FLT128_MANT_DIG;
+   static constexpr int min_exponent = FLT128_MIN_EXP;
+   static constexpr int max_exponent = FLT128_MAX_EXP;
+
+   static float128 frexp(float128 x, int* e) {
+      return frexpq(x, e);
+   }
+
+   static float128 ldexp(float128 x, int e) {
+      return ldexpq(x, e);
+   }
+
+   static float128 nextafter(float128 x, float128 y) {
+      return nextafterq(x, y);
+   }
+
+   static float128 denorm_min() {
+      return FLT128_DENORM_MIN;
+   }
+
+   static float128 infinity() {
+      return HUGE_VALQ;
+   }
+
+   static float128 quiet_NaN() {
+      return nanq("");
+   }
+};
+#endif
+
+
+} // namespace spp::detail
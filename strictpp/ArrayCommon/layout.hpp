@@ -0,0 +1,47 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include "../StrictCommon/common_traits.hpp"
+#include "array_traits.hpp"
+
+
+namespace spp {
+
+
+// Order in which elements of two-dimensional arrays are stored. Linear indexing, e.g. un(i)
+// and view1D(), is row-major for all layouts, so that arrays of different layouts can be
+// mixed in expressions. Elements of column-major arrays are accessed in storage order by
+// columns, storage(), and data().
+enum LayoutFlag { RowMajor, ColMajor };
+
+
+namespace detail {
+
+
+// Types that do not specify a layout are row-major. Expressions may specify the order in which
+// their elements are accessed contiguously, e.g. the transpose of a row-major array.
+template <typename Base>
+consteval LayoutFlag layout_of() {
+   if constexpr(requires { RemoveCVRef<Base>::layout(); }) {
+      return RemoveCVRef<Base>::layout();
+   } else {
+      return RowMajor;
+   }
+}
+
+
+// Arrays whose linear index coincides with the position of the element in memory.
+template <typename Base> concept LinearArrayType = ArrayType<Base> && layout_of<Base>() == RowMajor;
+
+
+template <typename Base> concept ColMajorArrayType =
+   ArrayType<Base> && layout_of<Base>() == ColMajor;
+
+
+} // namespace detail
+
+
+} // namespace spp
@@ -0,0 +1,225 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include "../StrictCommon/config.hpp"
+#include "../StrictCommon/strict_math.hpp"
+#include "../StrictCommon/strict_traits.hpp"
+#include "../StrictCommon/strict_val.hpp"
+#include "float_traits.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+
+namespace spp::detail {
+
+
+// Distance from |x| to the preceding number of T, which is the smaller of the distances to the
+// neighbors of x. Returns the smallest subnormal number if x is zero.
+template <Floating T>
+STRICT_NODISCARD_INLINE T gap_below(T x) {
+   using F = FloatTraits<T>;
+   x = x < T(0) ? -x : x;
+   return x == T(0) ? F::denorm_min() : x - F::nextafter(x, T(0));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Fixed-point accumulator that represents sums of numbers of T and of their products exactly
+// (Kulisch's long accumulator). Values are split into 32-bit digits, which are added to limbs
+// of 64 bits, each representing 32 bits of the sum, so that carries are only propagated every
+// normalize_period additions. The result is rounded once to the nearest number of T(ties to
+// even). Infinities and NaNs are tracked separately, as in floating-point arithmetic.
+template <Floating T>
+class LongAccumulator {
+   using F = FloatTraits<T>;
+
+   // Number of digits of the significand of T.
+   static constexpr int ndigits = (F::digits + 31) / 32;
+   using Digits = std::array<std::uint32_t, static_cast<std::size_t>(ndigits)>;
+
+   // Exponent of the least significant bit of the first limb, below the least significant digit
+   // of the product of two subnormal numbers.
+   static constexpr int base = 2 * (F::min_exponent - F::digits - 32 * ndigits);
+
+   // Products are less than 2^(2 * max_exponent), the rest leaves room for carries of sums of
+   // up to 2^63 terms and for the sign.
+   static constexpr int nlimbs = (2 * F::max_exponent + 64 - base) / 32 + 3;
+
+   // An addition changes a limb by less than 2^38, hence limbs do not overflow between
+   // normalizations.
+   static constexpr long int normalize_period = 1L << 20;
+
+public:
+   void add(Strict<T> x) {
+      if(!this->add_special(x.val())) {
+         return;
+      }
+      Digits d;
+      int e;
+      const bool negative = split(x.val(), d, e);
+      for(int k = 0; k < ndigits; ++k) {
+         add_digit(d[to_size_t(k)], e - 32 * (k + 1), negative);
+      }
+      this->count();
+   }
+
+   void add_product(Strict<T> x, Strict<T> y) {
+      if(!isfinites(x) || !isfinites(y)) {
+         this->add_special(x.val() * y.val());
+         return;
+      }
+      if(x.val() == T(0) || y.val() == T(0)) {
+         return;
+      }
+      Digits dx, dy;
+      int ex, ey;
+      const bool negative = split(x.val(), dx, ex) != split(y.val(), dy, ey);
+      for(int i = 0; i < ndigits; ++i) {
+         for(int j = 0; j < ndigits; ++j) {
+            const auto p = std::uint64_t{dx[to_size_t(i)]} * dy[to_size_t(j)];
+            const int e = ex + ey - 32 * (i + j + 2);
+            add_digit(static_cast<std::uint32_t>(p), e, negative);
+            add_digit(static_cast<std::uint32_t>(p >> 32), e + 32, negative);
+         }
+      }
+      this->count();
+   }
+
+   void merge(const LongAccumulator& other) {
+      for(std::size_t j = 0; j < limbs_.size(); ++j) {
+         limbs_[j] += other.limbs_[j];
+      }
+      this->normalize();
+      nan_ = nan_ || other.nan_;
+      pos_inf_ = pos_inf_ || other.pos_inf_;
+      neg_inf_ = neg_inf_ || other.neg_inf_;
+   }
+
+   // Zero is returned as positive zero.
+   STRICT_NODISCARD Strict<T> result() const {
+      if(nan_ || (pos_inf_ && neg_inf_)) {
+         return Strict<T>{F::quiet_NaN()};
+      }
+      if(pos_inf_ || neg_inf_) {
+         return Strict<T>{pos_inf_ ? F::infinity() : -F::infinity()};
+      }
+
+      LongAccumulator a = *this;
+      a.normalize();
+      const bool negative = a.limbs_.back() < 0;
+      if(negative) {
+         for(auto& l : a.limbs_) {
+            l = -l;
+         }
+         a.normalize();
+      }
+
+      int top = nlimbs - 1;
+      while(top >= 0 && a.limb(top) == 0) {
+         --top;
+      }
+      if(top < 0) {
+         return Strict<T>{T(0)};
+      }
+
+      // Bits from q to msb are kept, q is limited by the exponent of subnormal numbers.
+      const auto width = static_cast<int>(std::bit_width(static_cast<std::uint64_t>(a.limb(top))));
+      const int msb = 32 * top + width - 1;
+      const int q = std::max(msb - F::digits + 1, F::min_exponent - F::digits - base);
+      T significand{0};
+      for(int i = msb; i >= q; --i) {
+         significand = T(2) * significand + T(a.bit(i));
+      }
+
+      const bool round = a.bit(q - 1);
+      bool sticky = (a.limb((q - 1) / 32) & ((std::int64_t{1} << ((q - 1) % 32)) - 1)) != 0;
+      for(int j = (q - 1) / 32 - 1; j >= 0 && !sticky; --j) {
+         sticky = a.limb(j) != 0;
+      }
+      if(round && (sticky || a.bit(q))) {
+         significand += T(1);
+      }
+
+      const T r = F::ldexp(significand, q + base);
+      return Strict<T>{negative ? -r : r};
+   }
+
+private:
+   std::array<std::int64_t, static_cast<std::size_t>(nlimbs)> limbs_{};
+   long int additions_ = 0;
+   bool nan_ = false;
+   bool pos_inf_ = false;
+   bool neg_inf_ = false;
+
+   // x = sign * (d[0] * 2^(e - 32) + d[1] * 2^(e - 64) + ...). Returns true if x is negative.
+   static bool split(T x, Digits& d, int& e) {
+      T m = F::frexp(x < T(0) ? -x : x, &e);
+      for(auto& dk : d) {
+         m = F::ldexp(m, 32);
+         dk = static_cast<std::uint32_t>(m);
+         m -= T(dk);
+      }
+      return x < T(0);
+   }
+
+   void add_digit(std::uint32_t d, int e, bool negative) {
+      const int pos = e - base;
+      const auto v = std::uint64_t{d} << (pos % 32);
+      const auto lo = static_cast<std::int64_t>(v & 0xFFFF'FFFF);
+      const auto hi = static_cast<std::int64_t>(v >> 32);
+      this->limb(pos / 32) += negative ? -lo : lo;
+      this->limb(pos / 32 + 1) += negative ? -hi : hi;
+   }
+
+   // Returns true if x is finite and nonzero.
+   bool add_special(T x) {
+      if(isnans(Strict<T>{x})) {
+         nan_ = true;
+      } else if(!isfinites(Strict<T>{x})) {
+         (x > T(0) ? pos_inf_ : neg_inf_) = true;
+      } else {
+         return x != T(0);
+      }
+      return false;
+   }
+
+   void count() {
+      if(++additions_ == normalize_period) {
+         this->normalize();
+      }
+   }
+
+   // Limbs except for the last one are reduced to [0, 2^32), the last one keeps the sign.
+   void normalize() {
+      for(std::size_t j = 0; j + 1 < limbs_.size(); ++j) {
+         const std::int64_t carry = limbs_[j] >> 32;
+         limbs_[j] -= carry * (std::int64_t{1} << 32);
+         limbs_[j + 1] += carry;
+      }
+      additions_ = 0;
+   }
+
+   std::int64_t& limb(int j) {
+      return limbs_[to_size_t(j)];
+   }
+
+   std::int64_t limb(int j) const {
+      return limbs_[to_size_t(j)];
+   }
+
+   int bit(int i) const {
+      return static_cast<int>((this->limb(i / 32) >> (i % 32)) & 1);
+   }
+};
+
+
+} // namespace spp::detail
@@ -0,0 +1,29 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+namespace spp {
+
+
+// Selects how exp, log, sin, cos, pow, and sqrt are applied to arrays of float and double.
+// ExactMath calls the standard library one element at a time. FastMath evaluates vectorized
+// kernels for packets of consecutive elements, with maximum errors, measured in units in the
+// last place(ULP) against quadruple precision:
+//
+//    exp          1.5 ULP
+//    log          1 ULP
+//    sin, cos     2.5 ULP
+//    sqrt         0.5 ULP(correctly rounded)
+//    pow(x, p)    2 + |p| / 8 ULP
+//
+// Kernels of float evaluate in double and round the result, with errors of at most 1 ULP.
+// Arguments outside of the ranges covered by the kernels(non-finite values, subnormals,
+// |x| > 708 for exp, |x| > 2^20 for sin and cos, non-positive bases of pow, etc.) are passed to
+// the standard library, so that special values are the same for both flags. Other
+// floating-point types always use ExactMath.
+enum MathFlag { ExactMath, FastMath };
+
+
+} // namespace spp
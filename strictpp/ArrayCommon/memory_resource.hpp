@@ -0,0 +1,121 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include "../StrictCommon/config.hpp"
+#include "alignment.hpp"
+#include "statistics.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+namespace spp {
+
+
+namespace detail {
+
+
+inline thread_local std::pmr::memory_resource* default_resource = nullptr;
+
+
+} // namespace detail
+
+
+// Memory resource of arrays that are created by the calling thread without specifying a
+// resource. nullptr, which is the default, means that operator new and operator delete are
+// used. Arrays reallocate from the resource they were created with, copies use the default
+// resource, and moves transfer the storage together with its resource. A resource must outlive
+// all arrays allocated from it.
+inline std::pmr::memory_resource* get_default_array_resource() {
+   return detail::default_resource;
+}
+
+
+// Returns the previous default resource.
+inline std::pmr::memory_resource* set_default_array_resource(std::pmr::memory_resource* mr) {
+   return std::exchange(detail::default_resource, mr);
+}
+
+
+// Sets the default resource of the calling thread for the lifetime of the object.
+class STRICT_NODISCARD ScopedArrayResource {
+public:
+   explicit ScopedArrayResource(std::pmr::memory_resource* mr)
+      : previous_{set_default_array_resource(mr)} {
+   }
+
+   ScopedArrayResource(const ScopedArrayResource&) = delete;
+   ScopedArrayResource& operator=(const ScopedArrayResource&) = delete;
+
+   ~ScopedArrayResource() {
+      set_default_array_resource(previous_);
+   }
+
+private:
+   std::pmr::memory_resource* previous_;
+};
+
+
+namespace detail {
+
+
+// Arrays are never allocated from memory resources during constant evaluation.
+STRICT_CONSTEXPR_INLINE std::pmr::memory_resource* current_resource() {
+   return std::is_constant_evaluated() ? nullptr : get_default_array_resource();
+}
+
+
+// Aligned arrays request the same alignment from memory resources as from operator new.
+template <typename T, AlignmentFlag AF>
+consteval std::size_t resource_alignment_of() {
+   return AF == Aligned ? std::size_t(alignment_of<T, AF>()) : alignof(T);
+}
+
+
+// Allocates storage for n elements from mr, or by operator new if mr is nullptr. Elements are
+// value-initialized if init is true and are left uninitialized otherwise.
+template <typename T, AlignmentFlag AF>
+T* allocate_elements(std::pmr::memory_resource* mr, std::size_t n, bool init) {
+   void* p{};
+   if(mr) {
+      p = mr->allocate(n * sizeof(T), resource_alignment_of<T, AF>());
+   } else if constexpr(AF == Aligned) {
+      p = ::operator new[](n * sizeof(T), std::align_val_t{alignment_of<T, AF>()});
+   } else {
+      p = ::operator new[](n * sizeof(T));
+   }
+
+   count_allocation(n * sizeof(T));
+
+   if(init) {
+      std::uninitialized_default_construct_n(static_cast<T*>(p), n);
+   }
+   return static_cast<T*>(p);
+}
+
+
+template <typename T, AlignmentFlag AF>
+void deallocate_elements(std::pmr::memory_resource* mr, T* p, std::size_t n) {
+   count_deallocation();
+   std::destroy_n(p, n);
+   if(mr) {
+      mr->deallocate(p, n * sizeof(T), resource_alignment_of<T, AF>());
+   } else if constexpr(AF == Aligned) {
+      ::operator delete[](p, std::align_val_t{alignment_of<T, AF>()});
+   } else {
+      ::operator delete[](p);
+   }
+}
+
+
+} // namespace detail
+
+
+} // namespace spp
@@ -0,0 +1,348 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include "../StrictCommon/auxiliary_types.hpp"
+#include "../StrictCommon/config.hpp"
+#include "../StrictCommon/strict_traits.hpp"
+#include "../StrictCommon/strict_val.hpp"
+#include "array_traits.hpp"
+#include "layout.hpp"
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+
+namespace spp::detail {
+
+
+// Number of lanes of a packet of T, chosen so that a packet occupies 64 bytes(the width of
+// AVX-512 registers and of a cache line). Narrower targets split packets into several registers.
+template <Builtin T>
+inline constexpr long int packet_size =
+   sizeof(T) < 64 ? 64 / static_cast<long int>(sizeof(T)) : 1;
+
+
+// Lanes are builtin types or fixed-width integers used to manipulate bits of floating-point lanes.
+template <typename T> concept PacketLane = Builtin<T> || std::is_integral_v<T>;
+
+
+#if defined(__GNUC__)
+// GCC and Clang vector extensions are portable across targets: vectors wider than the
+// registers of the target are split, and vectors are lowered to scalars if SIMD is unavailable.
+template <typename T> concept VectorLane =
+   PacketLane<T> && !Boolean<T>
+   && (std::is_integral_v<T> || SameAs<T, float> || SameAs<T, double>);
+#else
+template <typename T> concept VectorLane = false;
+#endif
+
+
+template <PacketLane T, long int N>
+struct PacketStorage {
+   using type = T[static_cast<std::size_t>(N)];
+};
+
+
+#if defined(__GNUC__)
+template <VectorLane T, long int N>
+struct PacketStorage<T, N> {
+   typedef T type __attribute__((vector_size(sizeof(T) * static_cast<std::size_t>(N))));
+};
+#endif
+
+
+// Packet of N lanes. Operations are either applied to vectors directly or are loops over
+// lanes with a compile-time trip count, which compilers map onto SIMD instructions.
+template <PacketLane T, long int N>
+struct Packet {
+   using value_type = T;
+   static constexpr bool is_vector = VectorLane<T>;
+
+   STRICT_NODISCARD_INLINE static Packet broadcast(T x) {
+      Packet p;
+      if constexpr(is_vector) {
+         // Subtracting zeros preserves the sign of x if x is zero.
+         p.v = x - decltype(v){};
+      } else {
+         for(long int k = 0; k < N; ++k) {
+            p.v[k] = x;
+         }
+      }
+      return p;
+   }
+
+   // Lanes i, i + 1, ..., i + N - 1.
+   STRICT_NODISCARD_INLINE static Packet iota(T i) {
+      Packet p;
+      for(long int k = 0; k < N; ++k) {
+         p.v[k] = static_cast<T>(k);
+      }
+      return broadcast(i) + p;
+   }
+
+   typename PacketStorage<T, N>::type v;
+};
+
+
+// Tag of functors that provide overloads for packets in addition to Strict types. Other
+// functions(e.g. generic lambdas passed to generate) are always evaluated one element at a time.
+struct PacketOperation {};
+
+
+// Converts each lane as static_cast, consistent with strict_cast.
+template <PacketLane U, PacketLane T, long int N>
+STRICT_NODISCARD_INLINE Packet<U, N> packet_cast(const Packet<T, N>& x) {
+   Packet<U, N> p;
+#if defined(__GNUC__)
+   if constexpr(Packet<U, N>::is_vector && Packet<T, N>::is_vector) {
+      p.v = __builtin_convertvector(x.v, typename PacketStorage<U, N>::type);
+      return p;
+   }
+#endif
+   for(long int k = 0; k < N; ++k) {
+      p.v[k] = static_cast<U>(x.v[k]);
+   }
+   return p;
+}
+
+
+#define STRICT_GENERATE_PACKET_UNARY_OPERATOR(op)                            \
+   template <PacketLane T, long int N>                                       \
+   STRICT_NODISCARD_INLINE Packet<T, N> operator op(const Packet<T, N>& x) { \
+      Packet<T, N> p;                                                        \
+      if constexpr(Packet<T, N>::is_vector) {                                \
+         p.v = op x.v;                                                       \
+      } else {                                                               \
+         for(long int k = 0; k < N; ++k) {                                   \
+            p.v[k] = op x.v[k];                                              \
+         }                                                                   \
+      }                                                                      \
+      return p;                                                              \
+   }
+
+
+#define STRICT_GENERATE_PACKET_BINARY_OPERATOR(op)                           \
+   template <PacketLane T, long int N>                                       \
+   STRICT_NODISCARD_INLINE Packet<T, N> operator op(const Packet<T, N>& x,   \
+                                                    const Packet<T, N>& y) { \
+      Packet<T, N> p;                                                        \
+      if constexpr(Packet<T, N>::is_vector) {                                \
+         p.v = x.v op y.v;                                                   \
+      } else {                                                               \
+         for(long int k = 0; k < N; ++k) {                                   \
+            p.v[k] = x.v[k] op y.v[k];                                       \
+         }                                                                   \
+      }                                                                      \
+      return p;                                                              \
+   }
+
+
+// Integer division, modulo, and shifts are not generated since their Strict
+// counterparts validate operands.
+STRICT_GENERATE_PACKET_UNARY_OPERATOR(+)
+STRICT_GENERATE_PACKET_UNARY_OPERATOR(-)
+STRICT_GENERATE_PACKET_UNARY_OPERATOR(~)
+STRICT_GENERATE_PACKET_BINARY_OPERATOR(+)
+STRICT_GENERATE_PACKET_BINARY_OPERATOR(-)
+STRICT_GENERATE_PACKET_BINARY_OPERATOR(*)
+STRICT_GENERATE_PACKET_BINARY_OPERATOR(/)
+STRICT_GENERATE_PACKET_BINARY_OPERATOR(&)
+STRICT_GENERATE_PACKET_BINARY_OPERATOR(|)
+STRICT_GENERATE_PACKET_BINARY_OPERATOR(^)
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Masks have unsigned lanes of the same width as the compared lanes, all bits of which are set
+// if the comparison is true and cleared otherwise.
+template <PacketLane T>
+using MaskLane = std::conditional_t<sizeof(T) == 8, std::uint64_t, std::uint32_t>;
+
+
+template <PacketLane U, PacketLane T, long int N>
+STRICT_NODISCARD_INLINE Packet<U, N> packet_bit_cast(const Packet<T, N>& x) {
+   static_assert(sizeof(U) == sizeof(T));
+   return std::bit_cast<Packet<U, N>>(x);
+}
+
+
+// Width of the widest vector registers of the target. GCC lowers comparisons of vectors wider
+// than registers to scalar comparisons, so that such vectors are compared in parts.
+inline constexpr std::size_t native_vector_bytes =
+#if defined(__AVX512F__)
+   64;
+#elif defined(__AVX__)
+   32;
+#else
+   16;
+#endif
+
+
+template <PacketLane T, long int N, typename Op>
+STRICT_NODISCARD_INLINE Packet<MaskLane<T>, N> packet_compare(const Packet<T, N>& x,
+                                                             const Packet<T, N>& y, Op op) {
+   Packet<MaskLane<T>, N> m;
+   if constexpr(Packet<T, N>::is_vector) {
+      constexpr long int bytes = static_cast<long int>(native_vector_bytes / sizeof(T));
+      constexpr long int L = N < bytes ? N : bytes;
+      using V = typename PacketStorage<T, L>::type;
+      using M = typename PacketStorage<MaskLane<T>, L>::type;
+
+      auto compare_part = [&](std::size_t offset) {
+         V a, b;
+         std::memcpy(&a, reinterpret_cast<const char*>(&x.v) + offset, sizeof(V));
+         std::memcpy(&b, reinterpret_cast<const char*>(&y.v) + offset, sizeof(V));
+         M c = (M)op(a, b);
+         std::memcpy(reinterpret_cast<char*>(&m.v) + offset, &c, sizeof(M));
+      };
+      [&]<std::size_t... I>(std::index_sequence<I...>) {
+         (compare_part(I * sizeof(V)), ...);
+      }(std::make_index_sequence<static_cast<std::size_t>(N / L)>{});
+   } else {
+      for(long int k = 0; k < N; ++k) {
+         m.v[k] = op(x.v[k], y.v[k]) ? static_cast<MaskLane<T>>(-1) : MaskLane<T>{0};
+      }
+   }
+   return m;
+}
+
+
+template <PacketLane T, long int N>
+STRICT_NODISCARD_INLINE Packet<MaskLane<T>, N> packet_less(const Packet<T, N>& x,
+                                                          const Packet<T, N>& y) {
+   return packet_compare(x, y, [](const auto& a, const auto& b) { return a < b; });
+}
+
+
+template <PacketLane T, long int N>
+STRICT_NODISCARD_INLINE Packet<MaskLane<T>, N> packet_less_equal(const Packet<T, N>& x,
+                                                                const Packet<T, N>& y) {
+   return packet_compare(x, y, [](const auto& a, const auto& b) { return a <= b; });
+}
+
+
+// Selects lanes of x where m is set and lanes of y otherwise.
+template <PacketLane T, long int N>
+STRICT_NODISCARD_INLINE Packet<T, N> packet_select(const Packet<MaskLane<T>, N>& m,
+                                                   const Packet<T, N>& x, const Packet<T, N>& y) {
+   auto bx = packet_bit_cast<MaskLane<T>>(x);
+   auto by = packet_bit_cast<MaskLane<T>>(y);
+   return packet_bit_cast<T>((m & bx) | (~m & by));
+}
+
+
+template <PacketLane T, long int N>
+STRICT_NODISCARD_INLINE bool packet_all(const Packet<T, N>& m) {
+   return [&]<std::size_t... I>(std::index_sequence<I...>) {
+      return (... && (m.v[I] != T{0}));
+   }(std::make_index_sequence<static_cast<std::size_t>(N)>{});
+}
+
+
+template <std::unsigned_integral T, long int N>
+STRICT_NODISCARD_INLINE Packet<T, N> packet_shift_left(const Packet<T, N>& x, int s) {
+   Packet<T, N> p;
+   if constexpr(Packet<T, N>::is_vector) {
+      p.v = x.v << s;
+   } else {
+      for(long int k = 0; k < N; ++k) {
+         p.v[k] = static_cast<T>(x.v[k] << s);
+      }
+   }
+   return p;
+}
+
+
+template <std::unsigned_integral T, long int N>
+STRICT_NODISCARD_INLINE Packet<T, N> packet_shift_right(const Packet<T, N>& x, int s) {
+   Packet<T, N> p;
+   if constexpr(Packet<T, N>::is_vector) {
+      p.v = x.v >> s;
+   } else {
+      for(long int k = 0; k < N; ++k) {
+         p.v[k] = static_cast<T>(x.v[k] >> s);
+      }
+   }
+   return p;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <Builtin T, long int N>
+consteval std::size_t packet_alignment() {
+   return sizeof(T) * N < 64 ? sizeof(T) * N : 64;
+}
+
+
+// If aligned is true, p must be aligned to the 64-byte boundary of an Aligned array
+// shifted by a multiple of N elements.
+template <long int N, bool aligned, Builtin T>
+STRICT_NODISCARD_INLINE Packet<T, N> load_packet(const Strict<T>* p) {
+   if constexpr(aligned) {
+      p = std::assume_aligned<packet_alignment<T, N>()>(p);
+   }
+   Packet<T, N> x;
+   std::memcpy(&x.v, p, sizeof(x.v));
+   return x;
+}
+
+
+template <long int N, bool aligned, Builtin T>
+STRICT_INLINE void store_packet(Strict<T>* p, const Packet<T, N>& x) {
+   if constexpr(aligned) {
+      p = std::assume_aligned<packet_alignment<T, N>()>(p);
+   }
+   std::memcpy(static_cast<void*>(p), &x.v, sizeof(x.v));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Arrays whose linear index is the position in memory always support packet evaluation, while
+// column-major arrays do not. Other types(expressions and slices) provide un_packet<N>(i) and
+// packet_ready(), where the latter verifies at run time that every leaf is contiguous, e.g.
+// that slices have stride 1.
+template <typename Base> concept PacketType =
+   BaseType<Base> && (LinearArrayType<Base> || requires(const Base& A) { A.packet_ready(); });
+
+
+template <PacketType Base>
+STRICT_NODISCARD_INLINE bool is_packet_ready(const Base& A) {
+   if constexpr(LinearArrayType<Base>) {
+      return true;
+   } else {
+      return A.packet_ready();
+   }
+}
+
+
+// Functors may disable packet evaluation at run time by providing packet_ready().
+template <typename F>
+STRICT_NODISCARD_INLINE bool is_packet_op_ready(const F& f) {
+   if constexpr(requires { f.packet_ready(); }) {
+      return f.packet_ready();
+   } else {
+      return true;
+   }
+}
+
+
+// Loads elements i, ..., i + N - 1. i must be a multiple of N.
+template <long int N, PacketType Base>
+STRICT_NODISCARD_INLINE auto packet_at(const Base& A, index_t i) {
+   if constexpr(LinearArrayType<Base>) {
+      return load_packet<N, Base::alignment() == 64>(&A.un(i));
+   } else {
+      return A.template un_packet<N>(i);
+   }
+}
+
+
+} // namespace spp::detail
@@ -0,0 +1,367 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include "../StrictCommon/config.hpp"
+#include "../StrictCommon/strict_traits.hpp"
+#include "math_flag.hpp"
+#include "packet.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+
+namespace spp::detail {
+
+
+// Vectorized kernels of FastMath, see math_flag.hpp for error bounds. Kernels of double use
+// Cody-Waite argument reduction followed by polynomial approximations(fdlibm coefficients for
+// log, sin, and cos, Taylor coefficients for exp). Lanes outside of the ranges covered by the
+// kernels are recomputed by the standard library.
+template <typename T> concept FastMathType = SameAs<T, float> || SameAs<T, double>;
+
+
+// Kernels are not evaluated at compile time.
+STRICT_CONSTEXPR_INLINE bool use_fast_math(MathFlag mf) {
+   if(std::is_constant_evaluated()) {
+      return false;
+   }
+   return mf == FastMath;
+}
+
+
+template <long int N>
+using PacketD = Packet<double, N>;
+
+
+template <long int N>
+using PacketU = Packet<std::uint64_t, N>;
+
+
+template <long int N>
+STRICT_NODISCARD_INLINE PacketD<N> bcd(double x) {
+   return PacketD<N>::broadcast(x);
+}
+
+
+template <long int N>
+STRICT_NODISCARD_INLINE PacketU<N> bcu(std::uint64_t x) {
+   return PacketU<N>::broadcast(x);
+}
+
+
+// Evaluates c[0] + x * (c[1] + x * (c[2] + ...)). The fold is unrolled regardless of
+// optimization flags.
+template <long int N, std::size_t M>
+STRICT_NODISCARD_INLINE PacketD<N> horner(const PacketD<N>& x, const double (&c)[M]) {
+   auto y = bcd<N>(c[M - 1]);
+   [&]<std::size_t... I>(std::index_sequence<I...>) {
+      ((y = y * x + bcd<N>(c[M - 2 - I])), ...);
+   }(std::make_index_sequence<M - 1>{});
+   return y;
+}
+
+
+// Clears sign bits.
+template <FastMathType T, long int N>
+STRICT_NODISCARD_INLINE Packet<T, N> packet_abs(const Packet<T, N>& x) {
+   using U = MaskLane<T>;
+   const auto mask = Packet<U, N>::broadcast(~(U{1} << (8 * sizeof(T) - 1)));
+   return packet_bit_cast<T>(packet_bit_cast<U>(x) & mask);
+}
+
+
+// Not set for zeros, subnormals, negative numbers, infinities, and NaNs.
+template <long int N>
+STRICT_NODISCARD_INLINE PacketU<N> positive_normal(const PacketD<N>& x) {
+   return packet_less_equal(bcd<N>(std::numeric_limits<double>::min()), x)
+        & packet_less_equal(x, bcd<N>(std::numeric_limits<double>::max()));
+}
+
+
+// Recomputes lanes of y for which valid is not set as f(x).
+template <long int N, typename F>
+STRICT_INLINE void fix_lanes(PacketD<N>& y, const PacketD<N>& x, const PacketU<N>& valid, F f) {
+   if(!packet_all(valid)) {
+      for(long int k = 0; k < N; ++k) {
+         if(!valid.v[k]) {
+            y.v[k] = f(x.v[k]);
+         }
+      }
+   }
+}
+
+
+// Error-free transformations, x + y = s + e and x * y = p + e. The products are split into
+// halves(Dekker's algorithm) unless fused multiply-add is implemented in hardware.
+template <FastMathType T, long int N>
+STRICT_INLINE void two_sum(const Packet<T, N>& x, const Packet<T, N>& y, Packet<T, N>& s,
+                           Packet<T, N>& e) {
+   s = x + y;
+   auto t = s - x;
+   e = (x - (s - t)) + (y - t);
+}
+
+
+template <FastMathType T, long int N>
+STRICT_INLINE void two_prod(const Packet<T, N>& x, const Packet<T, N>& y, Packet<T, N>& p,
+                            Packet<T, N>& e) {
+   p = x * y;
+#if defined(__FP_FAST_FMA) && defined(__FP_FAST_FMAF)
+   for(long int k = 0; k < N; ++k) {
+      e.v[k] = std::fma(x.v[k], y.v[k], -p.v[k]);
+   }
+#else
+   // 2^27 + 1 for double and 2^12 + 1 for float.
+   constexpr T split = T(1UL << (std::numeric_limits<T>::digits + 1) / 2) + T(1);
+   auto split_x = Packet<T, N>::broadcast(split) * x;
+   auto split_y = Packet<T, N>::broadcast(split) * y;
+   auto xh = split_x - (split_x - x);
+   auto yh = split_y - (split_y - y);
+   auto xl = x - xh;
+   auto yl = y - yh;
+   e = ((xh * yh - p) + xh * yl + xl * yh) + xl * yl;
+#endif
+}
+
+
+// Rounds x * 2^s to the nearest integer k for |x| < 2^50. Returns k as double and the bits
+// of k + 1.5 * 2^52, the low bits of which coincide with those of k.
+template <long int N>
+STRICT_INLINE PacketD<N> round_to_int(const PacketD<N>& x, double s, PacketU<N>& bits) {
+   constexpr double shifter = 6'755'399'441'055'744.; // 1.5 * 2^52
+   auto t = x * bcd<N>(s) + bcd<N>(shifter);
+   bits = packet_bit_cast<std::uint64_t>(t);
+   return t - bcd<N>(shifter);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <std::size_t M>
+consteval auto inverse_factorials() {
+   struct {
+      double c[M];
+   } r{};
+   double f = 1.;
+   for(std::size_t i = 0; i < M; ++i) {
+      f *= i > 0 ? static_cast<double>(i) : 1.;
+      r.c[i] = 1. / f;
+   }
+   return r;
+}
+
+
+// Requires |x| <= 708, so that 2^k is a normal number.
+template <long int N>
+STRICT_NODISCARD_INLINE PacketD<N> exp_kernel(const PacketD<N>& x) {
+   constexpr double ln2_hi = 6.93147180369123816490e-01;
+   constexpr double ln2_lo = 1.90821492927058770002e-10;
+   static constexpr auto c = inverse_factorials<14>();
+
+   PacketU<N> bits;
+   auto k = round_to_int(x, 1.44269504088896338700e+00, bits);
+   auto r = (x - k * bcd<N>(ln2_hi)) - k * bcd<N>(ln2_lo);
+   auto scale = packet_bit_cast<double>(packet_shift_left(bits + bcu<N>(1'023), 52));
+   return horner(r, c.c) * scale;
+}
+
+
+template <long int N>
+STRICT_NODISCARD_INLINE PacketD<N> fast_exp(const PacketD<N>& x) {
+   auto y = exp_kernel(x);
+   fix_lanes(y, x, packet_less_equal(packet_abs(x), bcd<N>(708.)),
+             [](double z) { return std::exp(z); });
+   return y;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <long int N>
+struct LogParts {
+   PacketD<N> e;    // exponent
+   PacketD<N> f;    // m - 1, where x = m * 2^e and sqrt(2) / 2 <= m < sqrt(2)
+   PacketD<N> s;    // f / (2 + f)
+   PacketD<N> hfsq; // f * f / 2
+   PacketD<N> r;    // remainder of log(1 + f) = 2 * atanh(s) = 2 * s + s * r
+};
+
+
+// Requires x to be positive, normal, and finite.
+template <long int N>
+STRICT_NODISCARD_INLINE LogParts<N> log_parts(const PacketD<N>& x) {
+   static constexpr double lg[] = {6.666666666666735130e-01, 3.999999999940941908e-01,
+                                   2.857142874366239149e-01, 2.222219843214978396e-01,
+                                   1.818357216161805012e-01, 1.531383769920937332e-01,
+                                   1.479819860511658591e-01};
+
+   // Biased exponent of x / sqrt(2), computed by adding the difference of bits of 1
+   // and sqrt(2) / 2, and x reduced to [sqrt(2) / 2, sqrt(2)).
+   auto ix = packet_bit_cast<std::uint64_t>(x);
+   auto eb = packet_shift_right(ix + bcu<N>(0x0009'5f61'9980'c433ULL), 52);
+   auto iz = ix - packet_shift_left(eb, 52) + bcu<N>(0x3ff0'0000'0000'0000ULL);
+
+   LogParts<N> p;
+   // 2^52 + eb is exact, subtracting 2^52 + 1023 converts eb to the unbiased exponent.
+   p.e = packet_bit_cast<double>(eb | bcu<N>(0x4330'0000'0000'0000ULL))
+       - bcd<N>(4'503'599'627'371'519.);
+   p.f = packet_bit_cast<double>(iz) - bcd<N>(1.);
+   p.s = p.f / (bcd<N>(2.) + p.f);
+   auto z = p.s * p.s;
+   p.hfsq = bcd<N>(0.5) * p.f * p.f;
+   p.r = z * horner(z, lg);
+   return p;
+}
+
+
+inline constexpr double log_ln2_hi = 6.93147180369123816490e-01;
+inline constexpr double log_ln2_lo = 1.90821492927058770002e-10;
+
+
+template <long int N>
+STRICT_NODISCARD_INLINE PacketD<N> fast_log(const PacketD<N>& x) {
+   auto p = log_parts(x);
+   auto y = p.e * bcd<N>(log_ln2_hi)
+          - ((p.hfsq - (p.s * (p.hfsq + p.r) + p.e * bcd<N>(log_ln2_lo))) - p.f);
+
+   fix_lanes(y, x, positive_normal(x), [](double z) { return std::log(z); });
+   return y;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// log(x) is evaluated as hi + lo in double-double arithmetic, p * (hi + lo) = yh + yl, and
+// exp(yh + yl) = exp(yh) * (1 + yl).
+template <long int N>
+STRICT_NODISCARD_INLINE PacketD<N> fast_pow(const PacketD<N>& x, double pw) {
+   auto p = log_parts(x);
+
+   PacketD<N> h, l, q, ql, h2, l2;
+   two_sum(p.e * bcd<N>(log_ln2_hi), p.f, h, l);
+   two_prod(p.f, p.f, q, ql);
+   two_sum(h, bcd<N>(-0.5) * q, h2, l2);
+   auto lo = l + l2 - bcd<N>(0.5) * ql + (p.s * (p.hfsq + p.r) + p.e * bcd<N>(log_ln2_lo));
+   auto hi = h2 + lo;
+   lo = lo - (hi - h2);
+
+   PacketD<N> yh, yl;
+   two_prod(bcd<N>(pw), hi, yh, yl);
+   yl = yl + bcd<N>(pw) * lo;
+   auto e = exp_kernel(yh);
+   auto y = e + e * yl;
+
+   auto valid = positive_normal(x) & packet_less_equal(packet_abs(yh), bcd<N>(708.));
+   fix_lanes(y, x, valid, [pw](double z) { return std::pow(z, pw); });
+   return y;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Returns sin(x) if sine is true and cos(x) otherwise. x - k * pi / 2 is reduced in
+// four steps, the first three of which are exact for |k| <= 2^20.
+template <long int N, bool sine>
+STRICT_NODISCARD_INLINE PacketD<N> sin_cos_kernel(const PacketD<N>& x) {
+   constexpr double pio2_1 = 1.57079632673412561417e+00;
+   constexpr double pio2_2 = 6.07710050630396597660e-11;
+   constexpr double pio2_3 = 2.02226624871116645580e-21;
+   constexpr double pio2_3t = 8.47842766036889956997e-32;
+   static constexpr double sc[] = {-1.66666666666666324348e-01, 8.33333333332248946124e-03,
+                                   -1.98412698298579493134e-04, 2.75573137070700676789e-06,
+                                   -2.50507602534068634195e-08, 1.58969099521155010221e-10};
+   static constexpr double cc[] = {4.16666666666666019037e-02,  -1.38888888888741095749e-03,
+                                   2.48015872894767294178e-05,  -2.75573143513906633035e-07,
+                                   2.08757232129817482790e-09,  -1.13596475577881948265e-11};
+
+   PacketU<N> bits;
+   auto k = round_to_int(x, 6.36619772367581382433e-01, bits);
+   auto r = (((x - k * bcd<N>(pio2_1)) - k * bcd<N>(pio2_2)) - k * bcd<N>(pio2_3))
+          - k * bcd<N>(pio2_3t);
+   auto z = r * r;
+
+   auto s = r + r * z * horner(z, sc);
+   auto hz = bcd<N>(0.5) * z;
+   auto w = bcd<N>(1.) - hz;
+   auto c = w + (((bcd<N>(1.) - w) - hz) + z * z * horner(z, cc));
+
+   // Quadrants 0, 1, 2, 3 of sine are s, c, -s, -c, and of cosine are c, -s, -c, s.
+   // cos(x) = sin(x + pi / 2) corresponds to the next quadrant.
+   auto q = sine ? bits : bits + bcu<N>(1);
+   auto odd = bcu<N>(0) - (q & bcu<N>(1));
+   auto sign = packet_shift_left(q & bcu<N>(2), 62);
+   auto y = packet_select(odd, c, s);
+   y = packet_bit_cast<double>(packet_bit_cast<std::uint64_t>(y) ^ sign);
+
+   // sin(x) = x for |x| < 2^-27, which preserves the sign of zeros.
+   if constexpr(sine) {
+      y = packet_select(packet_less(packet_abs(x), bcd<N>(0x1p-27)), x, y);
+   }
+   return y;
+}
+
+
+template <long int N>
+STRICT_NODISCARD_INLINE PacketD<N> fast_sin(const PacketD<N>& x) {
+   auto y = sin_cos_kernel<N, true>(x);
+   fix_lanes(y, x, packet_less_equal(packet_abs(x), bcd<N>(0x1p+20)),
+             [](double z) { return std::sin(z); });
+   return y;
+}
+
+
+template <long int N>
+STRICT_NODISCARD_INLINE PacketD<N> fast_cos(const PacketD<N>& x) {
+   auto y = sin_cos_kernel<N, false>(x);
+   fix_lanes(y, x, packet_less_equal(packet_abs(x), bcd<N>(0x1p+20)),
+             [](double z) { return std::cos(z); });
+   return y;
+}
+
+
+// Correctly rounded. Loops over lanes are vectorized if sqrt does not set errno, e.g. if
+// compiled with -fno-math-errno.
+template <long int N>
+STRICT_NODISCARD_INLINE PacketD<N> fast_sqrt(const PacketD<N>& x) {
+   PacketD<N> y;
+   for(long int k = 0; k < N; ++k) {
+      y.v[k] = std::sqrt(x.v[k]);
+   }
+   return y;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Kernels of float are evaluated in double.
+#define STRICT_GENERATE_FAST_MATH_FLOAT(name)                                 \
+   template <long int N>                                                      \
+   STRICT_NODISCARD_INLINE Packet<float, N> name(const Packet<float, N>& x) { \
+      return packet_cast<float>(name(packet_cast<double>(x)));                \
+   }
+
+
+STRICT_GENERATE_FAST_MATH_FLOAT(fast_exp)
+STRICT_GENERATE_FAST_MATH_FLOAT(fast_log)
+STRICT_GENERATE_FAST_MATH_FLOAT(fast_sin)
+STRICT_GENERATE_FAST_MATH_FLOAT(fast_cos)
+
+
+template <long int N>
+STRICT_NODISCARD_INLINE Packet<float, N> fast_sqrt(const Packet<float, N>& x) {
+   Packet<float, N> y;
+   for(long int k = 0; k < N; ++k) {
+      y.v[k] = std::sqrt(x.v[k]);
+   }
+   return y;
+}
+
+
+template <long int N>
+STRICT_NODISCARD_INLINE Packet<float, N> fast_pow(const Packet<float, N>& x, float pw) {
+   return packet_cast<float>(fast_pow(packet_cast<double>(x), static_cast<double>(pw)));
+}
+
+
+} // namespace spp::detail
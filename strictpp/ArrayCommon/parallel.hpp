@@ -0,0 +1,429 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include "../StrictCommon/auxiliary_types.hpp"
+#include "../StrictCommon/config.hpp"
+#include "../StrictCommon/error.hpp"
+#include "../StrictCommon/strict_literals.hpp"
+#include "../StrictCommon/strict_math.hpp"
+#include "../StrictCommon/strict_traits.hpp"
+#include "../StrictCommon/strict_val.hpp"
+#include "../Util/profiler.hpp"
+#include "array_traits.hpp"
+#include "math_flag.hpp"
+#include "sum_flag.hpp"
+
+#include <bit>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace spp {
+
+
+namespace detail {
+
+
+// Number of elements of blocks of parallel reductions, see parallel_reduce.
+inline constexpr long int reduction_block = 4'096;
+
+
+inline constexpr long int default_pairwise_block = 256;
+
+
+// Parallel evaluation is disabled by default. When enabled, the index range of an expression
+// is split into contiguous chunks, one per thread, whose boundaries are multiples of the
+// number of elements in a cache line. Expressions with side effects(e.g. random expressions)
+// are always evaluated serially. Functions passed to generate(...) must be free of side
+// effects if parallel evaluation is enabled.
+class ExecutionPolicy {
+public:
+   ExecutionPolicy& reset() {
+      parallel_ = false;
+      threads_ = default_threads();
+      threshold_ = default_threshold;
+      math_ = ExactMath;
+      sum_ = RecursiveSum;
+      pairwise_block_ = default_pairwise_block;
+      return *this;
+   }
+
+   StrictBool is_parallel() const {
+      return StrictBool{parallel_};
+   }
+
+   ExecutionPolicy& parallel(ImplicitBool b) {
+      parallel_ = b.get().val();
+      return *this;
+   }
+
+   index_t threads() const {
+      return index_t{threads_};
+   }
+
+   // Zero threads corresponds to the number of hardware threads. Must not
+   // be called while an expression is being evaluated in parallel.
+   ExecutionPolicy& threads(ImplicitNonNegInt n) {
+      threads_ = n.get() == 0_sl ? default_threads() : n.get().val();
+      return *this;
+   }
+
+   index_t threshold() const {
+      return index_t{threshold_};
+   }
+
+   // Expressions with fewer elements than threshold are evaluated serially.
+   ExecutionPolicy& threshold(ImplicitNonNegInt n) {
+      threshold_ = n.get().val();
+      return *this;
+   }
+
+   MathFlag math() const {
+      return math_;
+   }
+
+   // Default flag of exp, log, sin, cos, pow, and sqrt, which is read when
+   // expressions are created, see math_flag.hpp.
+   ExecutionPolicy& math(MathFlag mf) {
+      math_ = mf;
+      return *this;
+   }
+
+   SumFlag summation() const {
+      return sum_;
+   }
+
+   // Default flag of sum, mean, dot_prod, norms, and polynomials, see sum_flag.hpp.
+   ExecutionPolicy& summation(SumFlag sf) {
+      sum_ = sf;
+      return *this;
+   }
+
+   index_t pairwise_block() const {
+      return index_t{pairwise_block_};
+   }
+
+   // Number of terms of blocks of PairwiseSum, which must be a power of two that does not
+   // exceed reduction_block, so that blocks of serial and parallel sums are the same.
+   ExecutionPolicy& pairwise_block(ImplicitInt n) {
+      const long int b = n.get().val();
+      ASSERT_STRICT_ALWAYS_MSG(b > 0 && b <= reduction_block
+                                  && std::has_single_bit(static_cast<unsigned long int>(b)),
+                               "Block size must be a power of two not exceeding 4096.\n");
+      pairwise_block_ = b;
+      return *this;
+   }
+
+private:
+   static constexpr long int default_threshold = 65'536;
+
+   static long int default_threads() {
+      auto n = static_cast<long int>(std::thread::hardware_concurrency());
+      return n > 0 ? n : 1;
+   }
+
+   bool parallel_ = false;
+   long int threads_ = default_threads();
+   long int threshold_ = default_threshold;
+   MathFlag math_ = ExactMath;
+   SumFlag sum_ = RecursiveSum;
+   long int pairwise_block_ = default_pairwise_block;
+};
+
+
+} // namespace detail
+inline detail::ExecutionPolicy execution;
+
+
+namespace detail {
+
+
+// Expressions created and reductions evaluated during constant evaluation cannot read
+// spp::execution.
+STRICT_CONSTEXPR_INLINE MathFlag default_math() {
+   if(std::is_constant_evaluated()) {
+      return ExactMath;
+   }
+   return execution.math();
+}
+
+
+STRICT_CONSTEXPR_INLINE SumFlag default_summation() {
+   if(std::is_constant_evaluated()) {
+      return RecursiveSum;
+   }
+   return execution.summation();
+}
+
+
+STRICT_CONSTEXPR_INLINE index_t pairwise_block() {
+   if(std::is_constant_evaluated()) {
+      return index_t{default_pairwise_block};
+   }
+   return execution.pairwise_block();
+}
+
+
+// Set for the threads executing a parallel region so that nested
+// parallel calls(e.g. reductions inside of expressions) run serially.
+inline thread_local bool in_parallel_region = false;
+
+
+// Set by ParallelGuard to evaluate expressions in parallel regardless of spp::execution.
+inline thread_local bool force_parallel = false;
+
+
+class ParallelGuard {
+public:
+   explicit ParallelGuard() : previous_{std::exchange(force_parallel, true)} {
+   }
+
+   ParallelGuard(const ParallelGuard&) = delete;
+   ParallelGuard& operator=(const ParallelGuard&) = delete;
+
+   ~ParallelGuard() {
+      force_parallel = previous_;
+   }
+
+private:
+   bool previous_;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Threads are created once and wait for work, task k always being executed by thread k.
+// The latter guarantees that the same thread touches the same chunk of an array during
+// initialization and subsequent evaluations.
+class ThreadPool {
+public:
+   explicit ThreadPool(long int nthreads) {
+      for(long int k = 1; k < nthreads; ++k) {
+         workers_.emplace_back([this, k] { this->work(k); });
+      }
+   }
+
+   ThreadPool(const ThreadPool&) = delete;
+   ThreadPool& operator=(const ThreadPool&) = delete;
+
+   ~ThreadPool() {
+      {
+         std::lock_guard lock{m_};
+         stop_ = true;
+      }
+      start_.notify_all();
+      for(auto& w : workers_) {
+         w.join();
+      }
+   }
+
+   long int size() const {
+      return static_cast<long int>(workers_.size()) + 1;
+   }
+
+   // Calls f(k) for k = 0, ..., size() - 1, where f(0) is executed by the calling thread.
+   // If the pool is used by another thread, tasks are executed serially by the calling thread.
+   // The first exception thrown by any of the tasks is rethrown after all tasks complete.
+   template <typename F>
+   void run(F&& f) {
+      std::unique_lock run_lock{run_m_, std::try_to_lock};
+      if(!run_lock.owns_lock() || workers_.empty()) {
+         for(long int k = 0; k < this->size(); ++k) {
+            f(k);
+         }
+         return;
+      }
+
+      {
+         std::lock_guard lock{m_};
+         task_ = &f;
+         invoke_ = [](const void* t, long int k) { (*static_cast<const RemoveRef<F>*>(t))(k); };
+         pending_ = static_cast<long int>(workers_.size());
+         error_ = nullptr;
+         ++generation_;
+      }
+      start_.notify_all();
+
+      this->execute(0);
+
+      std::unique_lock lock{m_};
+      done_.wait(lock, [this] { return pending_ == 0; });
+      if(error_) {
+         std::rethrow_exception(std::exchange(error_, nullptr));
+      }
+   }
+
+private:
+   void work(long int k) {
+      long int generation = 0;
+      while(true) {
+         {
+            std::unique_lock lock{m_};
+            start_.wait(lock, [this, generation] { return stop_ || generation_ != generation; });
+            if(stop_) {
+               return;
+            }
+            generation = generation_;
+         }
+
+         this->execute(k);
+
+         {
+            std::lock_guard lock{m_};
+            --pending_;
+         }
+         done_.notify_one();
+      }
+   }
+
+   void execute(long int k) {
+      in_parallel_region = true;
+      try {
+         invoke_(task_, k);
+      } catch(...) {
+         std::lock_guard lock{m_};
+         if(!error_) {
+            error_ = std::current_exception();
+         }
+      }
+      in_parallel_region = false;
+   }
+
+   std::vector<std::thread> workers_;
+   std::mutex run_m_;
+   std::mutex m_;
+   std::condition_variable start_;
+   std::condition_variable done_;
+
+   const void* task_{};
+   void (*invoke_)(const void*, long int){};
+   long int pending_{};
+   long int generation_{};
+   bool stop_{};
+   std::exception_ptr error_;
+};
+
+
+// The pool is recreated when the number of threads is changed.
+inline std::shared_ptr<ThreadPool> thread_pool() {
+   static std::mutex m;
+   static std::shared_ptr<ThreadPool> pool;
+
+   std::lock_guard lock{m};
+   if(!pool || pool->size() != execution.threads().val()) {
+      pool.reset();
+      pool = std::make_shared<ThreadPool>(execution.threads().val());
+   }
+   return pool;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename T>
+STRICT_NODISCARD_CONSTEXPR_INLINE index_t cache_line_elements() {
+   constexpr long int n = 64 / static_cast<long int>(sizeof(T));
+   return index_t{n > 0 ? n : 1};
+}
+
+
+inline bool use_parallel(index_t n) {
+   return (execution.is_parallel() || force_parallel) && !in_parallel_region
+       && execution.threads() > 1_sl && n >= execution.threshold();
+}
+
+
+// Splits [0, n) into contiguous chunks, one per thread, whose boundaries
+// are multiples of block, and calls f(first, last) for each non-empty chunk.
+template <typename F>
+void parallel_for(index_t n, index_t block, F f) {
+   STRICT_PROFILE_SCOPE("parallel_for");
+   auto pool = thread_pool();
+   const index_t nthreads{pool->size()};
+   const index_t nblocks = (n + block - 1_sl) / block;
+   const index_t per_thread = (nblocks + nthreads - 1_sl) / nthreads * block;
+
+   pool->run([&](long int k) {
+      const index_t first = mins(per_thread * index_t{k}, n);
+      const index_t last = mins(per_thread * index_t{k + 1}, n);
+      if(first < last) {
+         f(first, last);
+      }
+   });
+}
+
+
+// Default-initializes n elements of uninitialized storage by the threads of the pool, using the
+// same chunks as parallel evaluation of assignments.
+template <typename T>
+void first_touch_fill(T* p, index_t n) {
+   auto fill = [p](index_t first, index_t last) {
+      std::uninitialized_default_construct_n(p + first.val(), to_size_t(last - first));
+   };
+   if(!in_parallel_region && execution.threads() > 1_sl) {
+      parallel_for(n, cache_line_elements<T>(), fill);
+   } else {
+      fill(0_sl, n);
+   }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Reductions use the blocked algorithm below whenever parallel evaluation is enabled, including
+// the case of a single thread, so that the result does not depend on the number of threads.
+inline bool use_parallel_reduction(index_t n) {
+   return (execution.is_parallel() || force_parallel) && n >= execution.threshold();
+}
+
+
+// Splits [0, n) into blocks of reduction_block elements, reduces each block by f(first, last),
+// and combines block results by op in a fixed pairwise order. The result is deterministic
+// since both the blocks and the order of combination only depend on n. If parallel is false,
+// blocks are reduced by the calling thread, which gives the same result. Requires n > 0.
+template <typename R, typename F, typename Op>
+R parallel_reduce(index_t n, F f, Op op, bool parallel = true) {
+   const index_t block{reduction_block};
+   const index_t nblocks = (n + block - 1_sl) / block;
+   if(nblocks == 1_sl) {
+      return f(0_sl, n);
+   }
+   std::vector<R> partial(to_size_t(nblocks));
+
+   auto reduce_blocks = [&](index_t first, index_t last) {
+      for(index_t b = first; b < last; ++b) {
+         partial[to_size_t(b)] = f(b * block, mins((b + 1_sl) * block, n));
+      }
+   };
+
+   if(parallel && !in_parallel_region && execution.threads() > 1_sl) {
+      parallel_for(nblocks, 1_sl, reduce_blocks);
+   } else {
+      reduce_blocks(0_sl, nblocks);
+   }
+
+   for(std::size_t stride = 1; stride < partial.size(); stride *= 2) {
+      for(std::size_t i = 0; i + stride < partial.size(); i += 2 * stride) {
+         partial[i] = op(partial[i], partial[i + stride]);
+      }
+   }
+   return partial[0];
+}
+
+
+// Expressions that cannot be copied generate random values and modify their state.
+template <typename Base1, typename Base2> concept ParallelEvaluable =
+   ArrayType<Base2> && std::is_copy_constructible_v<Base1>;
+
+
+} // namespace detail
+
+
+} // namespace spp
@@ -0,0 +1,141 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include "../StrictCommon/config.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+
+namespace spp {
+
+
+// Counts of operations performed by arrays, which are only recorded if STRICT_STATISTICS is
+// defined and are always zero otherwise. Allocations and deallocations are the ones of array
+// storage, copies and moves are the ones of arrays(including the storage of two-dimensional
+// arrays), and evaluations are element-wise passes that write an array, i.e. assignments of
+// expressions, compound assignments, fills, and copies. Counts include all threads and do not
+// include constant evaluation.
+struct ArrayStatistics {
+   long int allocations = 0;
+   long int bytes_allocated = 0;
+   long int deallocations = 0;
+   long int copies = 0;
+   long int moves = 0;
+   long int evaluations = 0;
+
+   bool operator==(const ArrayStatistics&) const = default;
+
+   ArrayStatistics operator-(const ArrayStatistics& s) const {
+      return {allocations - s.allocations, bytes_allocated - s.bytes_allocated,
+              deallocations - s.deallocations, copies - s.copies, moves - s.moves,
+              evaluations - s.evaluations};
+   }
+};
+
+
+namespace detail {
+
+
+struct StatisticsCounters {
+   std::atomic<long int> allocations{0};
+   std::atomic<long int> bytes_allocated{0};
+   std::atomic<long int> deallocations{0};
+   std::atomic<long int> copies{0};
+   std::atomic<long int> moves{0};
+   std::atomic<long int> evaluations{0};
+};
+
+
+inline StatisticsCounters statistics_counters;
+
+
+STRICT_INLINE void increment([[maybe_unused]] std::atomic<long int>& counter,
+                             [[maybe_unused]] long int n = 1) {
+#ifdef STRICT_STATISTICS
+   counter.fetch_add(n, std::memory_order_relaxed);
+#endif
+}
+
+
+STRICT_INLINE void count_allocation(std::size_t bytes) {
+   increment(statistics_counters.allocations);
+   increment(statistics_counters.bytes_allocated, static_cast<long int>(bytes));
+}
+
+
+STRICT_INLINE void count_deallocation() {
+   increment(statistics_counters.deallocations);
+}
+
+
+STRICT_CONSTEXPR_INLINE void count_copy() {
+   if(!std::is_constant_evaluated()) {
+      increment(statistics_counters.copies);
+   }
+}
+
+
+STRICT_CONSTEXPR_INLINE void count_move() {
+   if(!std::is_constant_evaluated()) {
+      increment(statistics_counters.moves);
+   }
+}
+
+
+STRICT_CONSTEXPR_INLINE void count_evaluation() {
+   if(!std::is_constant_evaluated()) {
+      increment(statistics_counters.evaluations);
+   }
+}
+
+
+} // namespace detail
+
+
+inline ArrayStatistics array_statistics() {
+   const auto& c = detail::statistics_counters;
+   return {c.allocations.load(), c.bytes_allocated.load(), c.deallocations.load(),
+           c.copies.load(), c.moves.load(), c.evaluations.load()};
+}
+
+
+inline void reset_array_statistics() {
+   auto& c = detail::statistics_counters;
+   c.allocations = 0;
+   c.bytes_allocated = 0;
+   c.deallocations = 0;
+   c.copies = 0;
+   c.moves = 0;
+   c.evaluations = 0;
+}
+
+
+// Counts the operations performed during the lifetime of the object, e.g.
+//
+// ArrayStatisticsScope s;
+// y = A * x + b;
+// assert(s.count().allocations == 0);
+class STRICT_NODISCARD ArrayStatisticsScope {
+public:
+   explicit ArrayStatisticsScope() : start_{array_statistics()} {
+   }
+
+   ArrayStatistics count() const {
+      return array_statistics() - start_;
+   }
+
+   void reset() {
+      start_ = array_statistics();
+   }
+
+private:
+   ArrayStatistics start_;
+};
+
+
+} // namespace spp
@@ -0,0 +1,27 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+namespace spp {
+
+
+// Selects how sum, mean, dot_prod, norm1, norm2, norm_lp(and their scaled versions), and
+// polynomials with powers add floating-point terms. RecursiveSum adds terms from left to right,
+// with the error bound (n - 1)u * sum(|x_i|), where u is the unit roundoff. PairwiseSum adds
+// blocks of execution.pairwise_block() terms, and then the sums of blocks pairwise, with the
+// error bound of order (b + log2(n / b))u * sum(|x_i|) for blocks of b terms. Blocks of float
+// and double are summed by packets of independent sums, which reduces the error within blocks
+// further, so that PairwiseSum is usually as fast as RecursiveSum. Partial sums of blocks are
+// kept on the stack. The results of serial and parallel(see parallel_reduce) pairwise sums are
+// the same. ReproducibleSum rounds terms to a grid selected by the largest terms(see
+// binned_sum.hpp), so that the result only depends on the terms, and not on their order, the
+// number of threads, or the width of packets of the instruction set. Its error is below 2^-80
+// times the number of terms times the largest term for double(terms of float are summed in
+// double), and it is not available during constant evaluation. Sums of reduce_many(see
+// array_reduce.hpp) also use the flag, other reductions and integer types ignore it.
+enum SumFlag { RecursiveSum, PairwiseSum, ReproducibleSum };
+
+
+} // namespace spp
@@ -0,0 +1,246 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include "../StrictCommon/auxiliary_types.hpp"
+#include "../StrictCommon/error.hpp"
+#include "../StrictCommon/strict_literals.hpp"
+#include "../StrictCommon/strict_traits.hpp"
+#include "../StrictCommon/strict_val.hpp"
+#include "../Util/profiler.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <istream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+
+// Parsing of arrays from text. Values are separated by whitespace or, if a delimiter is given,
+// by the delimiter and optional whitespace. Rows of two-dimensional arrays are separated by
+// newlines, and lines consisting of whitespace only are skipped. Integers and floating-point
+// numbers are parsed by std::from_chars(strtoflt128 for float128) and may be preceded by +,
+// booleans are 0, 1, false, or true. Input that is not fully consumed by the values is invalid,
+// e.g. 1.5 is an invalid integer and -1 is an invalid unsigned integer.
+//
+// Large inputs are parsed in parallel if parallel evaluation is enabled(see spp::execution), in
+// which case the threshold is the number of bytes. The input is then split into one chunk per
+// thread at newlines(or whitespace for one-dimensional arrays without delimiter), and the
+// values of the chunks are concatenated, so that the result does not depend on the number of
+// threads.
+namespace spp::detail {
+
+
+template <Builtin T>
+struct TextChunk {
+   std::vector<Strict<T>> values;
+   long int rows = 0;
+   long int cols = 0;
+};
+
+
+STRICT_INLINE bool is_blank(char c) {
+   return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+
+STRICT_INLINE const char* skip_blanks(const char* first, const char* last) {
+   while(first != last && is_blank(*first)) {
+      ++first;
+   }
+   return first;
+}
+
+
+inline void validate_delimiter(char delimiter) {
+   ASSERT_STRICT_ALWAYS_MSG(delimiter != '\n' && !is_blank(delimiter)
+                               && std::strchr("+-.0123456789", delimiter) == nullptr
+                               && !(delimiter >= 'a' && delimiter <= 'z')
+                               && !(delimiter >= 'A' && delimiter <= 'Z'),
+                            "Invalid delimiter.\n");
+}
+
+
+// Parses the value at the beginning of [first, last) and returns the end of the value, or
+// nullptr if the input is invalid. The value must be followed by a blank, the delimiter, or
+// the end of the range.
+template <Builtin T>
+const char* parse_value(const char* first, const char* last, char delimiter, T& x) {
+   const char* p = first;
+   if constexpr(Boolean<T>) {
+      auto matches = [&](const char* word, std::size_t n) {
+         return std::size_t(last - first) >= n && std::memcmp(first, word, n) == 0;
+      };
+      if(matches("false", 5) || matches("true", 4)) {
+         x = *first == 't';
+         p += x ? 4 : 5;
+      } else if(first != last && (*first == '0' || *first == '1')) {
+         x = *first == '1';
+         ++p;
+      } else {
+         return nullptr;
+      }
+   } else {
+      if(p != last && *p == '+') {
+         ++p;
+         if(p == last || *p == '-') {
+            return nullptr;
+         }
+      }
+#ifdef STRICT_QUAD_PRECISION
+      if constexpr(Quadruple<T>) {
+         char buf[128];
+         const char* q = p;
+         while(q != last && !is_blank(*q) && *q != delimiter && q - p < 127) {
+            ++q;
+         }
+         std::memcpy(buf, p, std::size_t(q - p));
+         buf[q - p] = '\0';
+         char* end;
+         x = strtoflt128(buf, &end);
+         if(end == buf) {
+            return nullptr;
+         }
+         p += end - buf;
+      } else
+#endif
+      {
+         auto [ptr, ec] = std::from_chars(p, last, x);
+         if(ec != std::errc{}) {
+            return nullptr;
+         }
+         p = ptr;
+      }
+   }
+
+   if(p != last && !is_blank(*p) && *p != delimiter) {
+      return nullptr;
+   }
+   return p;
+}
+
+
+// Parses values of the line [first, last), which does not contain newlines, and returns the
+// number of values.
+template <Builtin T>
+long int parse_line(const char* first, const char* last, char delimiter, TextChunk<T>& chunk) {
+   long int n = 0;
+   const char* p = skip_blanks(first, last);
+   while(p != last) {
+      T x{};
+      p = parse_value(p, last, delimiter, x);
+      ASSERT_STRICT_ALWAYS_MSG(p != nullptr, "Invalid input.\n");
+      chunk.values.push_back(Strict{x});
+      ++n;
+
+      p = skip_blanks(p, last);
+      if(delimiter != '\0' && p != last) {
+         ASSERT_STRICT_ALWAYS_MSG(*p == delimiter, "Invalid input.\n");
+         p = skip_blanks(p + 1, last);
+         ASSERT_STRICT_ALWAYS_MSG(p != last, "Invalid input.\n");
+      }
+   }
+   return n;
+}
+
+
+template <Builtin T>
+TextChunk<T> parse_chunk(const char* first, const char* last, char delimiter, bool by_rows) {
+   TextChunk<T> chunk;
+   // Rough estimate of the number of values, which assumes short numbers.
+   chunk.values.reserve(std::size_t(last - first) / 8);
+   while(first != last) {
+      const auto* nl =
+          static_cast<const char*>(std::memchr(first, '\n', std::size_t(last - first)));
+      const char* line_end = nl != nullptr ? nl : last;
+      if(const long int n = parse_line(first, line_end, delimiter, chunk); n > 0) {
+         if(chunk.rows == 0) {
+            chunk.cols = n;
+         }
+         ASSERT_STRICT_ALWAYS_MSG(!by_rows || n == chunk.cols,
+                                  "Rows have different numbers of columns.\n");
+         ++chunk.rows;
+      }
+      first = nl != nullptr ? nl + 1 : last;
+   }
+   return chunk;
+}
+
+
+// Parses the text into chunks whose values are concatenated in order. If by_rows is true,
+// checks that all rows have the same number of values.
+template <Builtin T>
+std::vector<TextChunk<T>> parse_text(const char* first, const char* last, char delimiter,
+                                     bool by_rows) {
+   STRICT_PROFILE_SCOPE("io/parse");
+   if(!use_parallel(index_t{long(last - first)})) {
+      std::vector<TextChunk<T>> chunks;
+      chunks.push_back(parse_chunk<T>(first, last, delimiter, by_rows));
+      return chunks;
+   }
+
+   // Chunks may also be split at blanks if values are not separated by delimiters or rows.
+   const bool split_at_blanks = !by_rows && delimiter == '\0';
+   // Chunks are not empty, so that searches for bounds start after first.
+   const long int length = long(last - first);
+   const long int nchunks = std::min(execution.threads().val(), std::max(length, 1L));
+   std::vector<const char*> bounds{first};
+   for(long int k = 1; k < nchunks; ++k) {
+      const char* p = std::max(bounds.back(), first + length / nchunks * k);
+      while(p != last && p[-1] != '\n' && !(split_at_blanks && is_blank(p[-1]))) {
+         ++p;
+      }
+      bounds.push_back(p);
+   }
+   bounds.push_back(last);
+
+   std::vector<TextChunk<T>> chunks(static_cast<std::size_t>(nchunks));
+   parallel_for(index_t{nchunks}, 1_sl, [&](index_t k_first, index_t k_last) {
+      for(long int k = k_first.val(); k < k_last.val(); ++k) {
+         const auto i = std::size_t(k);
+         chunks[i] = parse_chunk<T>(bounds[i], bounds[i + 1], delimiter, by_rows);
+      }
+   });
+
+   if(by_rows) {
+      long int cols = 0;
+      for(const auto& c : chunks) {
+         if(c.rows > 0) {
+            cols = cols == 0 ? c.cols : cols;
+            ASSERT_STRICT_ALWAYS_MSG(c.cols == cols, "Rows have different numbers of columns.\n");
+         }
+      }
+   }
+   return chunks;
+}
+
+
+template <Builtin T>
+void copy_chunks(const std::vector<TextChunk<T>>& chunks, Strict<T>* data) {
+   for(const auto& c : chunks) {
+      data = std::copy(c.values.begin(), c.values.end(), data);
+   }
+}
+
+
+// Remaining characters of the stream.
+inline std::string read_all(std::istream& is) {
+   std::string s;
+   constexpr std::size_t block = 1 << 20;
+   while(is) {
+      const std::size_t size = s.size();
+      s.resize(size + block);
+      is.read(s.data() + size, std::streamsize(block));
+      s.resize(size + std::size_t(is.gcount()));
+   }
+   return s;
+}
+
+
+} // namespace spp::detail
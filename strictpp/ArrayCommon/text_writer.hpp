@@ -0,0 +1,171 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include "../StrictCommon/auxiliary_types.hpp"
+#include "../StrictCommon/strict_IO.hpp"
+#include "../StrictCommon/strict_traits.hpp"
+#include "../StrictCommon/strict_val.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+
+
+// Formatting of values as text by std::to_chars(quadmath_snprintf for float128) into buffers
+// that are reused and written in large blocks. Values are formatted as by operator<< for
+// Strict types, including the options of spp::format.
+namespace spp::detail {
+
+
+// Buffers are flushed once they contain at least text_flush_size characters.
+inline constexpr std::size_t text_flush_size = 1 << 20;
+
+
+class TextBuffer {
+public:
+   // Pointer to at least n characters past the end of the text, which are then
+   // filled by the caller and appended by commit.
+   char* reserve(std::size_t n) {
+      if(buf_.size() - size_ < n) {
+         buf_.resize(std::max(2 * buf_.size(), size_ + n));
+      }
+      return buf_.data() + size_;
+   }
+
+   void commit(const char* end) {
+      size_ = static_cast<std::size_t>(end - buf_.data());
+   }
+
+   void append(std::string_view s) {
+      char* p = this->reserve(s.size());
+      std::memcpy(p, s.data(), s.size());
+      this->commit(p + s.size());
+   }
+
+   void append(char c, std::size_t count = 1) {
+      char* p = this->reserve(count);
+      std::memset(p, c, count);
+      this->commit(p + count);
+   }
+
+   const char* data() const {
+      return buf_.data();
+   }
+
+   std::size_t size() const {
+      return size_;
+   }
+
+   void clear() {
+      size_ = 0;
+   }
+
+private:
+   std::string buf_;
+   std::size_t size_ = 0;
+};
+
+
+// Upper bound on the number of characters of a formatted value. Values in fixed notation have
+// up to max_exponent10 digits before the decimal point.
+template <Builtin T>
+std::size_t max_text_size() {
+   if constexpr(Boolean<T>) {
+      return 5;
+   } else if constexpr(Integer<T>) {
+      return static_cast<std::size_t>(std::numeric_limits<T>::digits10) + 3;
+   }
+#ifdef STRICT_QUAD_PRECISION
+   else if constexpr(Quadruple<T>) {
+      return static_cast<std::size_t>(4'932 + format.precision<T>().val()) + 16;
+   }
+#endif
+   else {
+      constexpr int max_exponent10 = std::numeric_limits<T>::max_exponent10;
+      return static_cast<std::size_t>(max_exponent10 + format.precision<T>().val()) + 16;
+   }
+}
+
+
+// Writes x to [first, last), which must have at least max_text_size<T>() characters, and
+// returns the end of the text.
+template <Builtin T>
+char* write_value(char* first, char* last, T x) {
+   if constexpr(Boolean<T>) {
+      const std::string_view s = x ? "true" : "false";
+      return std::copy(s.begin(), s.end(), first);
+   } else if constexpr(Integer<T>) {
+      if constexpr(SignedInteger<T>) {
+         if(x >= 0) {
+            *first++ = '+';
+         }
+      }
+      return std::to_chars(first, last, x).ptr;
+   }
+#ifdef STRICT_QUAD_PRECISION
+   else if constexpr(Quadruple<T>) {
+      const int n = quad_to_chars(first, static_cast<std::size_t>(last - first), x);
+      return first + std::min(static_cast<long int>(n), long(last - first) - 1);
+   }
+#endif
+   else {
+      if(!std::signbit(x)) {
+         *first++ = '+';
+      }
+      if(format.is_shortest()) {
+         return std::to_chars(first, last, x).ptr;
+      }
+
+      const int precision = format.precision<T>().val();
+      const auto fmt = format.is_scientific() ? std::chars_format::scientific
+                                              : std::chars_format::fixed;
+      char* end = std::to_chars(first, last, x, fmt, precision).ptr;
+      // Decimal point is always printed, as by std::showpoint.
+      if(precision == 0 && std::isfinite(x)) {
+         const auto size = static_cast<std::size_t>(end - first);
+         auto* e = static_cast<char*>(std::memchr(first, 'e', size));
+         char* point = e != nullptr ? e : end;
+         std::memmove(point + 1, point, static_cast<std::size_t>(end - point));
+         *point = '.';
+         ++end;
+      }
+      return end;
+   }
+}
+
+
+// Appends x right-aligned in a field of the given width, as by std::setw.
+template <Builtin T>
+void append_value(TextBuffer& buf, T x, int width = 0) {
+   const auto w = static_cast<std::size_t>(width);
+   const std::size_t n = std::max(max_text_size<T>(), w);
+   char* first = buf.reserve(n);
+   char* end = write_value(first, first + n, x);
+   const auto size = static_cast<std::size_t>(end - first);
+   if(size < w) {
+      std::memmove(first + (w - size), first, size);
+      std::memset(first, ' ', w - size);
+      end = first + w;
+   }
+   buf.commit(end);
+}
+
+
+// Appends the index and returns the number of its digits.
+STRICT_INLINE int append_index(TextBuffer& buf, index_t i) {
+   char* first = buf.reserve(24);
+   char* end = std::to_chars(first, first + 24, i.sul().val()).ptr;
+   buf.commit(end);
+   return static_cast<int>(end - first);
+}
+
+
+} // namespace spp::detail
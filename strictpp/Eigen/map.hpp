@@ -61,16 +61,18 @@ auto map(Base&& A) {
    using namespace Eigen;
    using builtin_type = BuiltinTypeOf<Base>;
    using base = RemoveRef<Base>;
+   constexpr auto order =
+      spp::detail::layout_of<base>() == spp::ColMajor ? Eigen::ColMajor : Eigen::RowMajor;
 
    if constexpr(base::is_fixed()) {
       using matrix_type = detail::CopyConstTo<
          base,
-         Matrix<builtin_type, base::rows().val(), base::cols().val(), RowMajor>>::value_type;
+         Matrix<builtin_type, base::rows().val(), base::cols().val(), order>>::value_type;
 
       return Map<matrix_type, detail::eigen_align<base>()>{A.blas_data()};
    } else {
       using matrix_type =
-         detail::CopyConstTo<base, Matrix<builtin_type, Dynamic, Dynamic, RowMajor>>::value_type;
+         detail::CopyConstTo<base, Matrix<builtin_type, Dynamic, Dynamic, order>>::value_type;
 
       return Map<matrix_type, detail::eigen_align<base>()>{
          A.blas_data(), A.rows().val(), A.cols().val()};
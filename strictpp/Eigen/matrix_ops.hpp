@@ -9,17 +9,18 @@
 #include "map.hpp"
 
 
-namespace spp {
+namespace spp { namespace eigen {
 
 
+// Eigen backend of the native matrix products in matrix_ops.hpp, e.g. for comparison.
 void matrix_prod(TwoDimOwnerType auto const& A, TwoDimOwnerType auto const& B,
                  TwoDimOwnerType auto& C) {
    ASSERT_STRICT_DEBUG(A.cols() == B.rows());
    ASSERT_STRICT_DEBUG(C.rows() == A.rows());
    ASSERT_STRICT_DEBUG(C.cols() == B.cols());
-   auto AE = eigen::map(A);
-   auto BE = eigen::map(B);
-   auto CE = eigen::map(C);
+   auto AE = map(A);
+   auto BE = map(B);
+   auto CE = map(C);
    CE = AE * BE;
 }
 
@@ -33,4 +34,4 @@ Array2D<BuiltinTypeOf<Base1>> matrix_prod(const Base1& A, const Base2& B) {
 }
 
 
-} // namespace spp
+}} // namespace spp::eigen
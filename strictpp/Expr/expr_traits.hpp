@@ -5,6 +5,7 @@
 
 
 #include "../ArrayCommon/array_traits.hpp"
+#include "../ArrayCommon/packet.hpp"
 #include "../StrictCommon/common_traits.hpp"
 #include "../StrictCommon/strict_traits.hpp"
 
@@ -22,6 +23,17 @@ template <typename T1, typename T2, typename F> concept BinaryOperation =
    StrictBuiltin<std::invoke_result_t<F, ValueTypeOf<T1>, ValueTypeOf<T2>>>;
 
 
+template <typename T, typename F> concept UnaryPacketOperation =
+   BaseOf<detail::PacketOperation, F>
+   && requires(const F& f, const detail::Packet<BuiltinTypeOf<T>, 1>& x) { f(x); };
+
+
+template <typename T1, typename T2, typename F> concept BinaryPacketOperation =
+   BaseOf<detail::PacketOperation, F>
+   && requires(const F& f, const detail::Packet<BuiltinTypeOf<T1>, 1>& x,
+               const detail::Packet<BuiltinTypeOf<T2>, 1>& y) { f(x, y); };
+
+
 } // namespace spp::expr
 
 
@@ -4,22 +4,35 @@
 #pragma once
 
 
+#include "../ArrayCommon/packet.hpp"
+#include "../ArrayCommon/packet_math.hpp"
 #include "../StrictCommon/strict_common.hpp"
 
 
 namespace spp::expr {
 
 
+// Functors derived from PacketOperation are also applied to packets of consecutive elements
+// when all arrays of an expression are contiguous. Functions that are not vectorized by
+// compilers(e.g. exps) or validate their arguments(e.g. integer division) are always
+// applied to one element at a time, unless FastMath is requested.
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-struct UnaryPlus {
+struct UnaryPlus : detail::PacketOperation {
    template <Real T>
    STRICT_CONSTEXPR Strict<T> operator()(Strict<T> x) const {
       return +x;
    }
+
+   template <Real T, long int N>
+   detail::Packet<T, N> operator()(const detail::Packet<T, N>& x) const {
+      return +x;
+   }
 };
 
 
-struct UnaryMinus {
+struct UnaryMinus : detail::PacketOperation {
    template <Real T>
    STRICT_CONSTEXPR Strict<T> operator()(Strict<T> x) const {
       if constexpr(Integer<T>) {
@@ -27,14 +40,27 @@ struct UnaryMinus {
       }
       return -x;
    }
+
+   template <Real T, long int N>
+   detail::Packet<T, N> operator()(const detail::Packet<T, N>& x) const {
+      if constexpr(Integer<T>) {
+         static_assert(SignedInteger<T>);
+      }
+      return -x;
+   }
 };
 
 
-struct UnaryBitwiseNot {
+struct UnaryBitwiseNot : detail::PacketOperation {
    template <Integer T>
    STRICT_CONSTEXPR Strict<T> operator()(Strict<T> x) const {
       return ~x;
    }
+
+   template <Integer T, long int N>
+   detail::Packet<T, N> operator()(const detail::Packet<T, N>& x) const {
+      return ~x;
+   }
 };
 
 
@@ -46,27 +72,72 @@ struct UnaryLogicalNot {
 };
 
 
-struct UnaryAbs {
+struct UnaryAbs : detail::PacketOperation {
    template <Real T>
    STRICT_CONSTEXPR Strict<T> operator()(Strict<T> x) const {
       return abss(x);
    }
+
+   template <detail::FastMathType T, long int N>
+   detail::Packet<T, N> operator()(const detail::Packet<T, N>& x) const {
+      return detail::packet_abs(x);
+   }
 };
 
 
-struct UnaryExp {
+struct UnaryExp : detail::PacketOperation {
+   STRICT_CONSTEXPR explicit UnaryExp(MathFlag mf = ExactMath) : mf_{mf} {
+   }
+
    template <Floating T>
    STRICT_CONSTEXPR_2026 Strict<T> operator()(Strict<T> x) const {
+      if constexpr(detail::FastMathType<T>) {
+         if(detail::use_fast_math(mf_)) {
+            return Strict<T>{detail::fast_exp(detail::Packet<T, 1>::broadcast(x.val())).v[0]};
+         }
+      }
       return exps(x);
    }
+
+   template <detail::FastMathType T, long int N>
+   detail::Packet<T, N> operator()(const detail::Packet<T, N>& x) const {
+      return detail::fast_exp(x);
+   }
+
+   bool packet_ready() const {
+      return mf_ == FastMath;
+   }
+
+private:
+   MathFlag mf_;
 };
 
 
-struct UnaryLog {
+struct UnaryLog : detail::PacketOperation {
+   STRICT_CONSTEXPR explicit UnaryLog(MathFlag mf = ExactMath) : mf_{mf} {
+   }
+
    template <Floating T>
    STRICT_CONSTEXPR_2026 Strict<T> operator()(Strict<T> x) const {
+      if constexpr(detail::FastMathType<T>) {
+         if(detail::use_fast_math(mf_)) {
+            return Strict<T>{detail::fast_log(detail::Packet<T, 1>::broadcast(x.val())).v[0]};
+         }
+      }
       return logs(x);
    }
+
+   template <detail::FastMathType T, long int N>
+   detail::Packet<T, N> operator()(const detail::Packet<T, N>& x) const {
+      return detail::fast_log(x);
+   }
+
+   bool packet_ready() const {
+      return mf_ == FastMath;
+   }
+
+private:
+   MathFlag mf_;
 };
 
 
@@ -86,11 +157,31 @@ struct UnaryLog10 {
 };
 
 
-struct UnarySqrt {
+struct UnarySqrt : detail::PacketOperation {
+   STRICT_CONSTEXPR explicit UnarySqrt(MathFlag mf = ExactMath) : mf_{mf} {
+   }
+
    template <Floating T>
    STRICT_CONSTEXPR_2026 Strict<T> operator()(Strict<T> x) const {
+      if constexpr(detail::FastMathType<T>) {
+         if(detail::use_fast_math(mf_)) {
+            return Strict<T>{detail::fast_sqrt(detail::Packet<T, 1>::broadcast(x.val())).v[0]};
+         }
+      }
       return sqrts(x);
    }
+
+   template <detail::FastMathType T, long int N>
+   detail::Packet<T, N> operator()(const detail::Packet<T, N>& x) const {
+      return detail::fast_sqrt(x);
+   }
+
+   bool packet_ready() const {
+      return mf_ == FastMath;
+   }
+
+private:
+   MathFlag mf_;
 };
 
 
@@ -102,19 +193,59 @@ struct UnaryCbrt {
 };
 
 
-struct UnarySin {
+struct UnarySin : detail::PacketOperation {
+   STRICT_CONSTEXPR explicit UnarySin(MathFlag mf = ExactMath) : mf_{mf} {
+   }
+
    template <Floating T>
    STRICT_CONSTEXPR_2026 Strict<T> operator()(Strict<T> x) const {
+      if constexpr(detail::FastMathType<T>) {
+         if(detail::use_fast_math(mf_)) {
+            return Strict<T>{detail::fast_sin(detail::Packet<T, 1>::broadcast(x.val())).v[0]};
+         }
+      }
       return sins(x);
    }
+
+   template <detail::FastMathType T, long int N>
+   detail::Packet<T, N> operator()(const detail::Packet<T, N>& x) const {
+      return detail::fast_sin(x);
+   }
+
+   bool packet_ready() const {
+      return mf_ == FastMath;
+   }
+
+private:
+   MathFlag mf_;
 };
 
 
-struct UnaryCos {
+struct UnaryCos : detail::PacketOperation {
+   STRICT_CONSTEXPR explicit UnaryCos(MathFlag mf = ExactMath) : mf_{mf} {
+   }
+
    template <Floating T>
    STRICT_CONSTEXPR_2026 Strict<T> operator()(Strict<T> x) const {
+      if constexpr(detail::FastMathType<T>) {
+         if(detail::use_fast_math(mf_)) {
+            return Strict<T>{detail::fast_cos(detail::Packet<T, 1>::broadcast(x.val())).v[0]};
+         }
+      }
       return coss(x);
    }
+
+   template <detail::FastMathType T, long int N>
+   detail::Packet<T, N> operator()(const detail::Packet<T, N>& x) const {
+      return detail::fast_cos(x);
+   }
+
+   bool packet_ready() const {
+      return mf_ == FastMath;
+   }
+
+private:
+   MathFlag mf_;
 };
 
 
@@ -127,16 +258,36 @@ struct UnaryTan {
 
 
 template <Floating T>
-struct UnaryPow {
-   STRICT_CONSTEXPR_2026 explicit UnaryPow(Strict<T> p) : p_{p} {
+struct UnaryPow : detail::PacketOperation {
+   STRICT_CONSTEXPR_2026 explicit UnaryPow(Strict<T> p, MathFlag mf = ExactMath)
+      : p_{p},
+        mf_{mf} {
    }
 
    STRICT_CONSTEXPR_2026 Strict<T> operator()(Strict<T> x) const {
+      if constexpr(detail::FastMathType<T>) {
+         if(detail::use_fast_math(mf_)) {
+            auto y = detail::fast_pow(detail::Packet<T, 1>::broadcast(x.val()), p_.val());
+            return Strict<T>{y.v[0]};
+         }
+      }
       return pows(x, p_);
    }
 
+   template <long int N>
+   detail::Packet<T, N> operator()(const detail::Packet<T, N>& x) const
+      requires detail::FastMathType<T>
+   {
+      return detail::fast_pow(x, p_.val());
+   }
+
+   bool packet_ready() const {
+      return mf_ == FastMath;
+   }
+
 private:
    Strict<T> p_;
+   MathFlag mf_;
 };
 
 
@@ -164,44 +315,94 @@ struct UnaryInv {
 
 
 template <Builtin T>
-struct UnaryCast {
+struct UnaryCast : detail::PacketOperation {
    template <Builtin U>
    STRICT_CONSTEXPR Strict<T> operator()(Strict<U> x) const {
       return strict_cast<T>(x);
    }
+
+   template <Builtin U, long int N>
+   detail::Packet<T, N> operator()(const detail::Packet<U, N>& x) const {
+      return detail::packet_cast<T>(x);
+   }
+};
+
+
+// Ignores its argument, used for arrays of constants.
+template <Builtin T>
+struct UnaryConstant : detail::PacketOperation {
+   STRICT_CONSTEXPR explicit UnaryConstant(Strict<T> c) : c_{c} {
+   }
+
+   template <Builtin U>
+   STRICT_CONSTEXPR Strict<T> operator()([[maybe_unused]] Strict<U> x) const {
+      return c_;
+   }
+
+   template <Builtin U, long int N>
+   detail::Packet<T, N> operator()([[maybe_unused]] const detail::Packet<U, N>& x) const {
+      return detail::Packet<T, N>::broadcast(c_.val());
+   }
+
+private:
+   Strict<T> c_;
 };
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-struct BinaryPlus {
+struct BinaryPlus : detail::PacketOperation {
    template <Real T>
    STRICT_CONSTEXPR Strict<T> operator()(Strict<T> x, Strict<T> y) const {
       return x + y;
    }
+
+   template <Real T, long int N>
+   detail::Packet<T, N> operator()(const detail::Packet<T, N>& x,
+                                   const detail::Packet<T, N>& y) const {
+      return x + y;
+   }
 };
 
 
-struct BinaryMinus {
+struct BinaryMinus : detail::PacketOperation {
    template <Real T>
    STRICT_CONSTEXPR Strict<T> operator()(Strict<T> x, Strict<T> y) const {
       return x - y;
    }
+
+   template <Real T, long int N>
+   detail::Packet<T, N> operator()(const detail::Packet<T, N>& x,
+                                   const detail::Packet<T, N>& y) const {
+      return x - y;
+   }
 };
 
 
-struct BinaryMult {
+struct BinaryMult : detail::PacketOperation {
    template <Real T>
    STRICT_CONSTEXPR Strict<T> operator()(Strict<T> x, Strict<T> y) const {
       return x * y;
    }
+
+   template <Real T, long int N>
+   detail::Packet<T, N> operator()(const detail::Packet<T, N>& x,
+                                   const detail::Packet<T, N>& y) const {
+      return x * y;
+   }
 };
 
 
-struct BinaryDivide {
+struct BinaryDivide : detail::PacketOperation {
    template <Real T>
    STRICT_CONSTEXPR Strict<T> operator()(Strict<T> x, Strict<T> y) const {
       return x / y;
    }
+
+   template <Floating T, long int N>
+   detail::Packet<T, N> operator()(const detail::Packet<T, N>& x,
+                                   const detail::Packet<T, N>& y) const {
+      return x / y;
+   }
 };
 
 
@@ -229,27 +430,45 @@ struct BinaryLeftShift {
 };
 
 
-struct BinaryBitwiseAnd {
+struct BinaryBitwiseAnd : detail::PacketOperation {
    template <Integer T>
    STRICT_CONSTEXPR Strict<T> operator()(Strict<T> x, Strict<T> y) const {
       return x & y;
    }
+
+   template <Integer T, long int N>
+   detail::Packet<T, N> operator()(const detail::Packet<T, N>& x,
+                                   const detail::Packet<T, N>& y) const {
+      return x & y;
+   }
 };
 
 
-struct BinaryBitwiseOr {
+struct BinaryBitwiseOr : detail::PacketOperation {
    template <Integer T>
    STRICT_CONSTEXPR Strict<T> operator()(Strict<T> x, Strict<T> y) const {
       return x | y;
    }
+
+   template <Integer T, long int N>
+   detail::Packet<T, N> operator()(const detail::Packet<T, N>& x,
+                                   const detail::Packet<T, N>& y) const {
+      return x | y;
+   }
 };
 
 
-struct BinaryBitwiseXor {
+struct BinaryBitwiseXor : detail::PacketOperation {
    template <Integer T>
    STRICT_CONSTEXPR Strict<T> operator()(Strict<T> x, Strict<T> y) const {
       return x ^ y;
    }
+
+   template <Integer T, long int N>
+   detail::Packet<T, N> operator()(const detail::Packet<T, N>& x,
+                                   const detail::Packet<T, N>& y) const {
+      return x ^ y;
+   }
 };
 
 
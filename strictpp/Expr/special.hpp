@@ -147,6 +147,7 @@ template <Real T>
 STRICT_CONSTEXPR auto identity(ImplicitInt n);
 
 
+// Assigning the transpose to an array copies the elements by cache-sized blocks.
 template <TwoDimBaseType Base>
 STRICT_CONSTEXPR auto transpose(const Base& A);
 
@@ -261,10 +262,19 @@ STRICT_CONSTEXPR auto col_broadcast(Base&& A) = delete;
 namespace detail {
 
 
+// Pure index operation, which can therefore be evaluated by packets.
+struct LinearIndex2D : PacketOperation {
+   STRICT_CONSTEXPR_INLINE index_t operator()(index_t i, index_t j) const {
+      return i * n + j;
+   }
+
+   index_t n;
+};
+
+
 STRICT_CONSTEXPR_INLINE auto irange2D(ImplicitInt m, ImplicitInt n) {
-   auto op = [n](index_t i, index_t j) { return i * n.get() + j; };
-   using E = detail::IndexExpr2D<long int, decltype(op)>;
-   return StrictArrayBase2D<E>{m.get(), n.get(), op};
+   using E = detail::IndexExpr2D<long int, LinearIndex2D>;
+   return StrictArrayBase2D<E>{m.get(), n.get(), LinearIndex2D{{}, n.get()}};
 }
 
 
@@ -512,9 +522,7 @@ STRICT_CONSTEXPR auto identity(ImplicitInt n) {
 
 template <TwoDimBaseType Base>
 STRICT_CONSTEXPR auto transpose(const Base& A) {
-   auto op = [&A](index_t i, index_t j) { return A.un(j, i); };
-   using E = detail::IndexExpr2D<BuiltinTypeOf<Base>, decltype(op)>;
-   return StrictArrayBase2D<E>{A.cols(), A.rows(), op};
+   return StrictArrayBase2D<detail::TransposeExpr<Base>>{A};
 }
 
 
@@ -522,7 +530,7 @@ STRICT_CONSTEXPR auto transpose(const Base& A) {
 template <Builtin T>
 STRICT_CONSTEXPR auto const1D(ImplicitInt size, Strict<T> c) {
    ASSERT_STRICT_DEBUG(size.get() > -1_sl);
-   return generate(irange(size), [c]([[maybe_unused]] auto i) { return c; });
+   return generate(irange(size), expr::UnaryConstant<T>{c});
 }
 
 
@@ -537,7 +545,7 @@ STRICT_CONSTEXPR auto const2D(ImplicitInt rows, ImplicitInt cols, Strict<T> c) {
    ASSERT_STRICT_DEBUG(rows.get() > -1_sl);
    ASSERT_STRICT_DEBUG(cols.get() > -1_sl);
    ASSERT_STRICT_DEBUG(detail::semi_valid_row_col_sizes(rows.get(), cols.get()));
-   return generate(detail::irange2D(rows, cols), [c]([[maybe_unused]] auto i) { return c; });
+   return generate(detail::irange2D(rows, cols), expr::UnaryConstant<T>{c});
 }
 
 
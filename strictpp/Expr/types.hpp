@@ -6,6 +6,8 @@
 
 #include "../ArrayCommon/array_auxiliary.hpp"
 #include "../ArrayCommon/array_traits.hpp"
+#include "../ArrayCommon/layout.hpp"
+#include "../ArrayCommon/packet.hpp"
 #include "../ArrayCommon/valid.hpp"
 #include "../StrictCommon/strict_common.hpp"
 #include "expr_traits.hpp"
@@ -53,6 +55,17 @@ public:
       return op_(A_.un(i));
    }
 
+   template <long int N>
+   STRICT_NODISCARD_INLINE Packet<builtin_type, N> un_packet(index_t i) const {
+      return op_(packet_at<N>(A_, i));
+   }
+
+   STRICT_NODISCARD_INLINE bool packet_ready() const
+      requires PacketType<Base> && expr::UnaryPacketOperation<Base, Op>
+   {
+      return is_packet_op_ready(op_) && is_packet_ready(A_);
+   }
+
    STRICT_NODISCARD_CONSTEXPR_INLINE index_t size() const {
       return A_.size();
    }
@@ -135,6 +148,18 @@ public:
       return op_(A1_.un(i), A2_.un(i));
    }
 
+   template <long int N>
+   STRICT_NODISCARD_INLINE Packet<builtin_type, N> un_packet(index_t i) const {
+      return op_(packet_at<N>(A1_, i), packet_at<N>(A2_, i));
+   }
+
+   STRICT_NODISCARD_INLINE bool packet_ready() const
+      requires PacketType<Base1> && PacketType<Base2>
+            && expr::BinaryPacketOperation<Base1, Base2, Op>
+   {
+      return is_packet_op_ready(op_) && is_packet_ready(A1_) && is_packet_ready(A2_);
+   }
+
    STRICT_NODISCARD_CONSTEXPR_INLINE index_t size() const {
       return A1_.size();
    }
@@ -209,6 +234,16 @@ public:
       return start_ + incr_ * strict_cast<builtin_type>(i.get());
    }
 
+   template <long int N>
+   STRICT_NODISCARD_INLINE Packet<T, N> un_packet(index_t i) const {
+      auto x = packet_cast<T>(Packet<long int, N>::iota(i.val()));
+      return Packet<T, N>::broadcast(start_.val()) + Packet<T, N>::broadcast(incr_.val()) * x;
+   }
+
+   STRICT_NODISCARD_INLINE bool packet_ready() const {
+      return true;
+   }
+
    STRICT_NODISCARD_CONSTEXPR_INLINE index_t size() const {
       return size_;
    }
@@ -248,6 +283,21 @@ public:
       return op_(i.get(), j.get());
    }
 
+   template <long int N>
+   STRICT_NODISCARD_INLINE Packet<T, N> un_packet(index_t i) const {
+      Packet<T, N> x;
+      for(long int k = 0; k < N; ++k) {
+         x.v[k] = this->un(i + index_t{k}).val();
+      }
+      return x;
+   }
+
+   STRICT_NODISCARD_INLINE bool packet_ready() const
+      requires BaseOf<PacketOperation, Op>
+   {
+      return true;
+   }
+
    STRICT_NODISCARD_CONSTEXPR_INLINE index_t size() const {
       return rows_ * cols_;
    }
@@ -352,6 +402,52 @@ private:
 };
 
 
+// Elements of the transpose are accessed contiguously in the order opposite to the layout of
+// Base, which allows to copy them by blocks.
+template <TwoDimBaseType Base>
+class STRICT_NODISCARD TransposeExpr : private CopyBase2D {
+public:
+   using value_type = Base::value_type;
+   using builtin_type = value_type::value_type;
+
+   STRICT_NODISCARD_CONSTEXPR explicit TransposeExpr(const Base& A) : A_{A} {
+   }
+
+   STRICT_NODISCARD_CONSTEXPR TransposeExpr(const TransposeExpr& E) = default;
+   STRICT_CONSTEXPR TransposeExpr& operator=(const TransposeExpr&) = delete;
+   STRICT_CONSTEXPR ~TransposeExpr() = default;
+
+   STRICT_NODISCARD_CONSTEXPR_INLINE value_type un(ImplicitInt i) const {
+      auto [r, c] = index_map_one_to_two_dim(*this, i);
+      return this->un(r, c);
+   }
+
+   STRICT_NODISCARD_CONSTEXPR_INLINE value_type un(ImplicitInt i, ImplicitInt j) const {
+      return A_.un(j, i);
+   }
+
+   STRICT_NODISCARD_CONSTEXPR_INLINE index_t size() const {
+      return A_.size();
+   }
+
+   STRICT_NODISCARD_CONSTEXPR_INLINE index_t rows() const {
+      return A_.cols();
+   }
+
+   STRICT_NODISCARD_CONSTEXPR_INLINE index_t cols() const {
+      return A_.rows();
+   }
+
+   static consteval LayoutFlag layout() {
+      return layout_of<Base>() == RowMajor ? ColMajor : RowMajor;
+   }
+
+private:
+   // Slice arrays are stored by copy, arrays by reference.
+   typename CopyOrReferenceExpr<AddConst<Base>>::type A_;
+};
+
+
 template <OneDimRealBaseType Base1, OneDimRealBaseType Base2>
 class STRICT_NODISCARD TensorExpr : private CopyBase2D {
 public:
@@ -5,6 +5,7 @@
 
 
 #include "../ArrayCommon/array_traits.hpp"
+#include "../ArrayCommon/parallel.hpp"
 #include "../StrictCommon/strict_common.hpp"
 #include "../derived1D.hpp"
 #include "../derived2D.hpp"
@@ -42,12 +43,13 @@ template <RealBaseType Base>
 STRICT_CONSTEXPR auto abs(const Base& A);
 
 
+// Flags of exp, log, sqrt, sin, cos, and pow default to spp::execution.math(), see math_flag.hpp.
 template <FloatingBaseType Base>
-STRICT_CONSTEXPR_2026 auto exp(const Base& A);
+STRICT_CONSTEXPR_2026 auto exp(const Base& A, MathFlag mf = detail::default_math());
 
 
 template <FloatingBaseType Base>
-STRICT_CONSTEXPR_2026 auto log(const Base& A);
+STRICT_CONSTEXPR_2026 auto log(const Base& A, MathFlag mf = detail::default_math());
 
 
 template <FloatingBaseType Base>
@@ -59,7 +61,7 @@ STRICT_CONSTEXPR_2026 auto log10(const Base& A);
 
 
 template <FloatingBaseType Base>
-STRICT_CONSTEXPR_2026 auto sqrt(const Base& A);
+STRICT_CONSTEXPR_2026 auto sqrt(const Base& A, MathFlag mf = detail::default_math());
 
 
 template <FloatingBaseType Base>
@@ -67,11 +69,11 @@ STRICT_CONSTEXPR_2026 auto cbrt(const Base& A);
 
 
 template <FloatingBaseType Base>
-STRICT_CONSTEXPR_2026 auto sin(const Base& A);
+STRICT_CONSTEXPR_2026 auto sin(const Base& A, MathFlag mf = detail::default_math());
 
 
 template <FloatingBaseType Base>
-STRICT_CONSTEXPR_2026 auto cos(const Base& A);
+STRICT_CONSTEXPR_2026 auto cos(const Base& A, MathFlag mf = detail::default_math());
 
 
 template <FloatingBaseType Base>
@@ -79,7 +81,8 @@ STRICT_CONSTEXPR_2026 auto tan(const Base& A);
 
 
 template <FloatingBaseType Base>
-STRICT_CONSTEXPR_2026 auto pow(const Base& A, ValueTypeOf<Base> pw);
+STRICT_CONSTEXPR_2026 auto pow(const Base& A, ValueTypeOf<Base> pw,
+                               MathFlag mf = detail::default_math());
 
 
 template <FloatingBaseType Base>
@@ -127,12 +130,12 @@ STRICT_CONSTEXPR auto abs(Base&& A) = delete;
 
 template <typename Base>
    requires detail::ArrayFloatingTypeRvalue<Base>
-STRICT_CONSTEXPR_2026 auto exp(Base&& A) = delete;
+STRICT_CONSTEXPR_2026 auto exp(Base&& A, MathFlag mf = detail::default_math()) = delete;
 
 
 template <typename Base>
    requires detail::ArrayFloatingTypeRvalue<Base>
-STRICT_CONSTEXPR_2026 auto log(Base&& A) = delete;
+STRICT_CONSTEXPR_2026 auto log(Base&& A, MathFlag mf = detail::default_math()) = delete;
 
 
 template <typename Base>
@@ -147,7 +150,7 @@ STRICT_CONSTEXPR_2026 auto log10(Base&& A) = delete;
 
 template <typename Base>
    requires detail::ArrayFloatingTypeRvalue<Base>
-STRICT_CONSTEXPR_2026 auto sqrt(Base&& A) = delete;
+STRICT_CONSTEXPR_2026 auto sqrt(Base&& A, MathFlag mf = detail::default_math()) = delete;
 
 
 template <typename Base>
@@ -157,12 +160,12 @@ STRICT_CONSTEXPR_2026 auto cbrt(Base&& A) = delete;
 
 template <typename Base>
    requires detail::ArrayFloatingTypeRvalue<Base>
-STRICT_CONSTEXPR_2026 auto sin(Base&& A) = delete;
+STRICT_CONSTEXPR_2026 auto sin(Base&& A, MathFlag mf = detail::default_math()) = delete;
 
 
 template <typename Base>
    requires detail::ArrayFloatingTypeRvalue<Base>
-STRICT_CONSTEXPR_2026 auto cos(Base&& A) = delete;
+STRICT_CONSTEXPR_2026 auto cos(Base&& A, MathFlag mf = detail::default_math()) = delete;
 
 
 template <typename Base>
@@ -172,7 +175,8 @@ STRICT_CONSTEXPR_2026 auto tan(Base&& A) = delete;
 
 template <typename Base>
    requires detail::ArrayFloatingTypeRvalue<Base>
-STRICT_CONSTEXPR_2026 auto pow(Base&& A, ValueTypeOf<Base> pw) = delete;
+STRICT_CONSTEXPR_2026 auto pow(Base&& A, ValueTypeOf<Base> pw,
+                               MathFlag mf = detail::default_math()) = delete;
 
 
 template <typename Base>
@@ -260,14 +264,14 @@ STRICT_CONSTEXPR auto abs(const Base& A) {
 
 
 template <FloatingBaseType Base>
-STRICT_CONSTEXPR_2026 auto exp(const Base& A) {
-   return generate(A, expr::UnaryExp{});
+STRICT_CONSTEXPR_2026 auto exp(const Base& A, MathFlag mf) {
+   return generate(A, expr::UnaryExp{mf});
 }
 
 
 template <FloatingBaseType Base>
-STRICT_CONSTEXPR_2026 auto log(const Base& A) {
-   return generate(A, expr::UnaryLog{});
+STRICT_CONSTEXPR_2026 auto log(const Base& A, MathFlag mf) {
+   return generate(A, expr::UnaryLog{mf});
 }
 
 
@@ -284,8 +288,8 @@ STRICT_CONSTEXPR_2026 auto log10(const Base& A) {
 
 
 template <FloatingBaseType Base>
-STRICT_CONSTEXPR_2026 auto sqrt(const Base& A) {
-   return generate(A, expr::UnarySqrt{});
+STRICT_CONSTEXPR_2026 auto sqrt(const Base& A, MathFlag mf) {
+   return generate(A, expr::UnarySqrt{mf});
 }
 
 
@@ -296,14 +300,14 @@ STRICT_CONSTEXPR_2026 auto cbrt(const Base& A) {
 
 
 template <FloatingBaseType Base>
-STRICT_CONSTEXPR_2026 auto sin(const Base& A) {
-   return generate(A, expr::UnarySin{});
+STRICT_CONSTEXPR_2026 auto sin(const Base& A, MathFlag mf) {
+   return generate(A, expr::UnarySin{mf});
 }
 
 
 template <FloatingBaseType Base>
-STRICT_CONSTEXPR_2026 auto cos(const Base& A) {
-   return generate(A, expr::UnaryCos{});
+STRICT_CONSTEXPR_2026 auto cos(const Base& A, MathFlag mf) {
+   return generate(A, expr::UnaryCos{mf});
 }
 
 
@@ -314,8 +318,8 @@ STRICT_CONSTEXPR_2026 auto tan(const Base& A) {
 
 
 template <FloatingBaseType Base>
-STRICT_CONSTEXPR_2026 auto pow(const Base& A, ValueTypeOf<Base> pw) {
-   return generate(A, expr::UnaryPow{pw});
+STRICT_CONSTEXPR_2026 auto pow(const Base& A, ValueTypeOf<Base> pw, MathFlag mf) {
+   return generate(A, expr::UnaryPow{pw, mf});
 }
 
 
@@ -135,6 +135,7 @@ STRICT_GENERATE_SMALL_INT_TYPES(ImplicitInt, false, false)
 STRICT_GENERATE_SMALL_INT_TYPES(ImplicitNonNegInt, false, true)
 
 STRICT_GENERATE_SMALL_UNSIGNED_TYPES(Seed, true, unsigned)
+STRICT_GENERATE_SMALL_UNSIGNED_TYPES(Stream, true, unsigned)
 
 STRICT_GENERATE_SMALL_BOOL_TYPES(ImplicitBool, false)
 
@@ -176,6 +177,10 @@ class STRICT_NODISCARD Odd {};
 
 class STRICT_NODISCARD Reverse {};
 
+class STRICT_NODISCARD Uninitialized {};
+
+class STRICT_NODISCARD FirstTouch {};
+
 } // namespace detail
 
 
@@ -206,6 +211,14 @@ constexpr inline Last last{0};
 using place::last;
 
 
+// Tags for constructors of arrays. Elements of uninitialized arrays must be assigned before they
+// are read. Elements of first_touch arrays are set to zero by the threads of the execution
+// policy, in the same chunks as parallel evaluation, so that memory pages are placed on the NUMA
+// nodes of the threads that later use them.
+constexpr inline detail::Uninitialized uninitialized;
+constexpr inline detail::FirstTouch first_touch;
+
+
 // Note that the plus operator is allowed from both sides but not minus.
 STRICT_NODISCARD_CONSTEXPR_INLINE Last operator+(Last lst, ImplicitInt i) {
    return Last{ImplicitInt{lst.get() - i.get()}};
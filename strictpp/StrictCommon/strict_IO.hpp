@@ -13,12 +13,15 @@
 #include "strict_traits.hpp"
 #include "strict_val.hpp"
 
+#include <charconv>
+#include <cmath>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <limits>
 #include <sstream>
 #include <string>
+#include <string_view>
 
 
 namespace spp {
@@ -81,6 +84,7 @@ class StrictFormat {
 public:
    StrictFormat& reset() {
       scientific_ = true_sb;
+      shortest_ = false_sb;
       precision_[0] = float_precision;
       precision_[1] = double_precision;
       precision_[2] = long_double_precision;
@@ -97,6 +101,18 @@ public:
       return *this;
    }
 
+   StrictBool is_shortest() const {
+      return shortest_;
+   }
+
+   // Shortest representation that is read back as the same value(see std::to_chars), in which
+   // case scientific and precision are ignored. For float128, 36 significant digits are printed
+   // and trailing zeros are removed.
+   StrictFormat& shortest(ImplicitBool b) {
+      shortest_ = b.get();
+      return *this;
+   }
+
    template <Floating PT>
    StrictInt precision() const {
       if constexpr(SameAs<PT, float>) {
@@ -156,6 +172,7 @@ private:
    static constexpr int quad_precision = 33;
 
    StrictBool scientific_{true};
+   StrictBool shortest_{false};
    int precision_[4]{float_precision, double_precision, long_double_precision, quad_precision};
 
    // Originally a templated lambda inside << operator, but changed to a private member
@@ -207,7 +224,15 @@ std::ostream& operator<<(std::ostream& os, Strict<T> x) {
 template <StandardFloating T>
 std::ostream& operator<<(std::ostream& os, Strict<T> x) {
    os << std::showpos;
-   if(format.scientific_) {
+   if(format.shortest_) {
+      char buf[64];
+      char* p = buf;
+      if(!std::signbit(T{x})) {
+         *p++ = '+';
+      }
+      p = std::to_chars(p, buf + sizeof(buf), T{x}).ptr;
+      os << std::string_view(buf, static_cast<std::size_t>(p - buf));
+   } else if(format.scientific_) {
       os << std::scientific << std::showpoint << format.set_float_precision<T>() << T{x};
    } else {
       os << std::fixed << std::showpoint << format.set_float_precision<T>() << T{x};
@@ -241,18 +266,31 @@ std::istream& operator>>(std::istream& is, Strict<T>& x) {
 }
 
 
+namespace detail {
+
+
+// Formats x as operator<< does and returns the number of characters that would have been
+// written if n was large enough, see quadmath_snprintf.
+template <Quadruple T>
+int quad_to_chars(char* buf, std::size_t n, T x) {
+   if(format.is_shortest()) {
+      return quadmath_snprintf(buf, n, "%+.36Qg", x);
+   }
+   const int precision = format.precision<T>().val();
+   if(format.is_scientific()) {
+      return quadmath_snprintf(buf, n, "%+-#*.*QE", precision + 7, precision, x);
+   }
+   return quadmath_snprintf(buf, n, "%+-#*.*QF", precision + 3, precision, x);
+}
+
+
+} // namespace detail
+
+
 template <Quadruple T>
 std::ostream& operator<<(std::ostream& os, T x) {
    static thread_local char buf[128];
-   if(format.scientific_) {
-      std::string frmt = "%+-#*." + std::to_string(format.precision_[3]) + std::string("QE");
-      int width = format.precision_[3] + 7;
-      quadmath_snprintf(buf, sizeof(buf), frmt.c_str(), width, x);
-   } else {
-      std::string frmt = "%+-#*." + std::to_string(format.precision_[3]) + std::string("QF");
-      int width = format.precision_[3] + 3;
-      quadmath_snprintf(buf, sizeof(buf), frmt.c_str(), width, x);
-   }
+   detail::quad_to_chars(buf, sizeof(buf), x);
    os << buf;
    return os;
 }
@@ -0,0 +1,103 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include "../StrictCommon/error.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if __has_include(<sys/mman.h>) && __has_include(<fcntl.h>) && __has_include(<unistd.h>)
+#define STRICT_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+#ifdef STRICT_HAS_MMAP
+namespace spp {
+
+
+namespace detail {
+
+
+// Read-only memory mapping of a whole file.
+class FileMapping {
+public:
+   explicit FileMapping(const std::string& file_path) {
+      int fd = ::open(file_path.c_str(), O_RDONLY);
+      ASSERT_STRICT_ALWAYS_MSG(fd != -1, "Invalid file path.\n");
+      struct stat st {};
+      if(::fstat(fd, &st) == 0 && st.st_size > 0) {
+         length_ = std::size_t(st.st_size);
+         addr_ = ::mmap(nullptr, length_, PROT_READ, MAP_SHARED, fd, 0);
+      }
+      ::close(fd);
+      if(addr_ == MAP_FAILED) {
+         addr_ = nullptr;
+      }
+      ASSERT_STRICT_ALWAYS_MSG(addr_ != nullptr, "Could not map file.\n");
+   }
+
+   FileMapping(const FileMapping&) = delete;
+   FileMapping& operator=(const FileMapping&) = delete;
+
+   FileMapping(FileMapping&& M) noexcept
+      : addr_{std::exchange(M.addr_, nullptr)},
+        length_{std::exchange(M.length_, 0)} {
+   }
+
+   FileMapping& operator=(FileMapping&& M) noexcept {
+      if(this != &M) {
+         this->reset();
+         addr_ = std::exchange(M.addr_, nullptr);
+         length_ = std::exchange(M.length_, 0);
+      }
+      return *this;
+   }
+
+   ~FileMapping() {
+      this->reset();
+   }
+
+   const unsigned char* data() const {
+      ASSERT_STRICT_ALWAYS_MSG(addr_ != nullptr, "File is not mapped.\n");
+      return static_cast<const unsigned char*>(addr_);
+   }
+
+   std::size_t size() const {
+      return length_;
+   }
+
+   // Copy of n bytes starting at the offset.
+   std::vector<unsigned char> read_at(std::uint64_t offset, std::uint64_t n) const {
+      ASSERT_STRICT_ALWAYS_MSG(offset <= length_ && n <= length_ - offset, "File is truncated.\n");
+      return {this->data() + offset, this->data() + offset + n};
+   }
+
+private:
+   void* addr_ = nullptr;
+   std::size_t length_ = 0;
+
+   void reset() {
+      if(addr_ != nullptr) {
+         ::munmap(addr_, length_);
+      }
+      addr_ = nullptr;
+      length_ = 0;
+   }
+};
+
+
+} // namespace detail
+
+
+} // namespace spp
+#endif
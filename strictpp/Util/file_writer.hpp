@@ -0,0 +1,72 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include "../StrictCommon/error.hpp"
+#include "file_mapping.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+
+namespace spp {
+
+
+namespace detail {
+
+
+// Output file whose data is passed to write(2) without intermediate buffering, hence it should
+// be written in large blocks. std::ofstream is used if POSIX files are not available.
+class FileWriter {
+public:
+#ifdef STRICT_HAS_MMAP
+   explicit FileWriter(const std::string& file_path)
+      : fd_{::open(file_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666)} {
+      ASSERT_STRICT_ALWAYS_MSG(fd_ != -1, "Invalid file path.\n");
+   }
+
+   FileWriter(const FileWriter&) = delete;
+   FileWriter& operator=(const FileWriter&) = delete;
+
+   ~FileWriter() {
+      ::close(fd_);
+   }
+
+   void write(const char* data, std::size_t n) {
+      while(n > 0) {
+         const auto k = ::write(fd_, data, n);
+         if(k == -1 && errno == EINTR) {
+            continue;
+         }
+         ASSERT_STRICT_ALWAYS_MSG(k > 0, "Could not write file.\n");
+         data += k;
+         n -= static_cast<std::size_t>(k);
+      }
+   }
+
+private:
+   int fd_;
+#else
+   explicit FileWriter(const std::string& file_path) : ofs_{file_path, std::ios::binary} {
+      ASSERT_STRICT_ALWAYS_MSG(ofs_, "Invalid file path.\n");
+   }
+
+   void write(const char* data, std::size_t n) {
+      ofs_.write(data, static_cast<std::streamsize>(n));
+      ASSERT_STRICT_ALWAYS_MSG(ofs_, "Could not write file.\n");
+   }
+
+private:
+   std::ofstream ofs_;
+#endif
+};
+
+
+} // namespace detail
+
+
+} // namespace spp
@@ -0,0 +1,120 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include "../ArrayCommon/packet.hpp"
+#include "../StrictCommon/config.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+
+namespace spp::detail {
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Philox4x32-10 of Salmon, Moraes, Dror, and Shaw, "Parallel random numbers: as easy as 1, 2, 3"
+// (2011). A counter of four 32-bit words is encrypted by ten rounds with a key of two words, so
+// that the output is a random function of the counter and numbers can be generated in any order.
+// Words are stored in 64-bit lanes of U, which is either std::uint64_t or a packet of
+// std::uint64_t, so that products of words are computed exactly and packets generate the
+// numbers of several counters at once. Lanes of counters must be less than 2^32.
+inline constexpr std::uint64_t philox_m0 = 0xD2511F53;
+inline constexpr std::uint64_t philox_m1 = 0xCD9E8D57;
+inline constexpr std::uint64_t philox_w0 = 0x9E3779B9;
+inline constexpr std::uint64_t philox_w1 = 0xBB67AE85;
+inline constexpr std::uint64_t philox_mask = 0xFFFFFFFF;
+
+
+template <typename U>
+using PhiloxWords = std::array<U, 4>;
+
+
+using PhiloxKey = std::array<std::uint64_t, 2>;
+
+
+template <typename U>
+STRICT_NODISCARD_INLINE U philox_lanes(std::uint64_t x) {
+   if constexpr(std::is_integral_v<U>) {
+      return x;
+   } else {
+      return U::broadcast(x);
+   }
+}
+
+
+template <typename U>
+STRICT_NODISCARD_INLINE U philox_high(const U& x) {
+   if constexpr(std::is_integral_v<U>) {
+      return x >> 32;
+   } else {
+      return packet_shift_right(x, 32);
+   }
+}
+
+
+// Product of the multiplier m and the low word of x.
+STRICT_NODISCARD_INLINE std::uint64_t philox_mul(std::uint64_t x, std::uint64_t m) {
+   return m * (x & philox_mask);
+}
+
+
+// Lanes are multiplied by pmuludq, which multiplies the low 32 bits of 64-bit lanes, since
+// compilers otherwise use full 64-bit multiplications(e.g. vpmullq), or emulate them, even if
+// the operands are masked.
+template <long int N>
+STRICT_NODISCARD_INLINE Packet<std::uint64_t, N> philox_mul(const Packet<std::uint64_t, N>& x,
+                                                            std::uint64_t m) {
+#if defined(__SSE2__)
+#if defined(__AVX2__)
+   using V = __m256i;
+   const V b = _mm256_set1_epi64x(static_cast<long long int>(m));
+   auto mul = [&b](V a) { return _mm256_mul_epu32(a, b); };
+#else
+   using V = __m128i;
+   const V b = _mm_set1_epi64x(static_cast<long long int>(m));
+   auto mul = [&b](V a) { return _mm_mul_epu32(a, b); };
+#endif
+   if constexpr(sizeof(x.v) % sizeof(V) == 0) {
+      Packet<std::uint64_t, N> p;
+      for(std::size_t offset = 0; offset < sizeof(x.v); offset += sizeof(V)) {
+         V a;
+         std::memcpy(&a, reinterpret_cast<const char*>(&x.v) + offset, sizeof(V));
+         a = mul(a);
+         std::memcpy(reinterpret_cast<char*>(&p.v) + offset, &a, sizeof(V));
+      }
+      return p;
+   }
+#endif
+   using PU = Packet<std::uint64_t, N>;
+   return PU::broadcast(m) * (x & PU::broadcast(philox_mask));
+}
+
+
+template <typename U>
+STRICT_NODISCARD_INLINE PhiloxWords<U> philox4x32(const PhiloxWords<U>& counter, PhiloxKey k) {
+   PhiloxWords<U> c = counter;
+   const auto mask = philox_lanes<U>(philox_mask);
+   for(int r = 0; r < 10; ++r) {
+      const U p0 = philox_mul(c[0], philox_m0);
+      const U p1 = philox_mul(c[2], philox_m1);
+      c = {philox_high(p1) ^ c[1] ^ philox_lanes<U>(k[0]),
+           p1 & mask,
+           philox_high(p0) ^ c[3] ^ philox_lanes<U>(k[1]),
+           p0 & mask};
+      k = {(k[0] + philox_w0) & philox_mask, (k[1] + philox_w1) & philox_mask};
+   }
+   return c;
+}
+
+
+} // namespace spp::detail
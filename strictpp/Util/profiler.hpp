@@ -0,0 +1,293 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(STRICT_PROFILE_CYCLES) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#elif defined(STRICT_PROFILE_CYCLES) && defined(__linux__)
+#include <time.h>
+#endif
+
+
+// STRICT_PROFILE_SCOPE("name") times the rest of the enclosing scope if STRICT_PROFILE is
+// defined and expands to nothing otherwise. Regions with the same name are accumulated
+// together. The macro can be used in constexpr functions, in which case nothing is recorded
+// during constant evaluation. If STRICT_PROFILE_CYCLES is defined, time is measured by the
+// time stamp counter on x86 and by CLOCK_MONOTONIC_RAW on other Linux systems.
+#ifdef STRICT_PROFILE
+#define STRICT_PROFILE_CONCAT_IMPL(a, b) a##b
+#define STRICT_PROFILE_CONCAT(a, b) STRICT_PROFILE_CONCAT_IMPL(a, b)
+#define STRICT_PROFILE_SCOPE(name)                                                    \
+   spp::detail::ProfileScope STRICT_PROFILE_CONCAT(strict_profile_scope_, __LINE__) { \
+      [] {                                                                            \
+         static const long int id = spp::profiler.region(name);                       \
+         return id;                                                                   \
+      }                                                                               \
+   }
+#else
+#define STRICT_PROFILE_SCOPE(name)
+#endif
+
+
+namespace spp {
+
+
+namespace detail {
+
+
+inline constexpr long int max_profile_regions = 256;
+
+
+// Counters are only written by the thread that owns them, hence updates are plain relaxed
+// stores rather than read-modify-write operations. Reports read them concurrently.
+struct ProfileCounters {
+   std::atomic<std::uint64_t> count{0};
+   std::atomic<std::uint64_t> total{0};
+   std::atomic<std::uint64_t> min{std::numeric_limits<std::uint64_t>::max()};
+   std::atomic<std::uint64_t> max{0};
+
+   void add(std::uint64_t calls, std::uint64_t t, std::uint64_t t_min, std::uint64_t t_max) {
+      constexpr auto relaxed = std::memory_order_relaxed;
+      count.store(count.load(relaxed) + calls, relaxed);
+      total.store(total.load(relaxed) + t, relaxed);
+      min.store(std::min(min.load(relaxed), t_min), relaxed);
+      max.store(std::max(max.load(relaxed), t_max), relaxed);
+   }
+
+   void add(const ProfileCounters& c) {
+      constexpr auto relaxed = std::memory_order_relaxed;
+      this->add(c.count.load(relaxed), c.total.load(relaxed), c.min.load(relaxed),
+                c.max.load(relaxed));
+   }
+
+   void clear() {
+      constexpr auto relaxed = std::memory_order_relaxed;
+      count.store(0, relaxed);
+      total.store(0, relaxed);
+      min.store(std::numeric_limits<std::uint64_t>::max(), relaxed);
+      max.store(0, relaxed);
+   }
+};
+
+
+using ProfileTable = std::array<ProfileCounters, max_profile_regions>;
+
+
+// Each thread accumulates into its own table, which is merged into the table of
+// finished threads when the thread exits.
+class Profiler {
+public:
+   // Returns the id of the region, or -1 if there are too many regions.
+   long int region(const char* name) {
+      auto& s = state();
+      std::lock_guard lock{s.m};
+      if(!s.at_exit_registered) {
+         std::atexit([] {
+            if(state().at_exit) {
+               Profiler{}.report(std::cerr);
+            }
+         });
+         s.at_exit_registered = true;
+      }
+
+      auto it = std::find(s.names.begin(), s.names.end(), name);
+      if(it != s.names.end()) {
+         return static_cast<long int>(it - s.names.begin());
+      }
+      if(static_cast<long int>(s.names.size()) == max_profile_regions) {
+         return -1;
+      }
+      s.names.emplace_back(name);
+      return static_cast<long int>(s.names.size()) - 1;
+   }
+
+   void record(long int id, std::uint64_t t) {
+      auto& table = thread_table();
+      table[static_cast<std::size_t>(id)].add(1, t, t, t);
+   }
+
+   // Must not be called while other threads are inside of profiled regions.
+   Profiler& reset() {
+      auto& s = state();
+      std::lock_guard lock{s.m};
+      for(auto& c : s.finished) {
+         c.clear();
+      }
+      for(auto* table : s.live) {
+         for(auto& c : *table) {
+            c.clear();
+         }
+      }
+      return *this;
+   }
+
+   // Regions are listed in the order of decreasing total time. Times include the ones of
+   // nested regions.
+   void report(std::ostream& os = std::cerr) const {
+      auto& s = state();
+      std::lock_guard lock{s.m};
+      ProfileTable all;
+      for(std::size_t i = 0; i < s.names.size(); ++i) {
+         all[i].add(s.finished[i]);
+         for(const auto* table : s.live) {
+            all[i].add((*table)[i]);
+         }
+      }
+
+      std::vector<std::size_t> order;
+      for(std::size_t i = 0; i < s.names.size(); ++i) {
+         if(all[i].count.load() > 0) {
+            order.push_back(i);
+         }
+      }
+      std::sort(order.begin(), order.end(), [&all](std::size_t i, std::size_t j) {
+         return all[i].total.load() > all[j].total.load();
+      });
+
+      const std::string u = unit();
+      std::ostringstream stream;
+      stream << std::left << std::setw(32) << "region" << std::right << std::setw(12) << "calls"
+             << std::setw(18) << "total(" + u + ")" << std::setw(14) << "mean"
+             << std::setw(14) << "min" << std::setw(14) << "max" << '\n';
+      for(auto i : order) {
+         const auto count = all[i].count.load();
+         const auto total = all[i].total.load();
+         stream << std::left << std::setw(32) << s.names[i] << std::right << std::setw(12)
+                << count << std::setw(18) << total << std::setw(14) << total / count
+                << std::setw(14) << all[i].min.load() << std::setw(14) << all[i].max.load()
+                << '\n';
+      }
+      os << stream.str() << std::flush;
+   }
+
+   // The report is written to std::cerr at exit, unless disabled.
+   Profiler& report_at_exit(bool b) {
+      auto& s = state();
+      std::lock_guard lock{s.m};
+      s.at_exit = b;
+      return *this;
+   }
+
+   static std::uint64_t now() {
+#if defined(STRICT_PROFILE_CYCLES) && (defined(__x86_64__) || defined(__i386__))
+      return __rdtsc();
+#elif defined(STRICT_PROFILE_CYCLES) && defined(__linux__)
+      timespec ts;
+      clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+      return static_cast<std::uint64_t>(ts.tv_sec) * 1'000'000'000ULL
+           + static_cast<std::uint64_t>(ts.tv_nsec);
+#else
+      return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                           std::chrono::steady_clock::now().time_since_epoch())
+                                           .count());
+#endif
+   }
+
+   static const char* unit() {
+#if defined(STRICT_PROFILE_CYCLES) && (defined(__x86_64__) || defined(__i386__))
+      return "cycles";
+#else
+      return "ns";
+#endif
+   }
+
+private:
+   // Never destroyed, so that threads exiting after static destructors
+   // and the report at exit can still use it.
+   struct State {
+      std::mutex m;
+      std::vector<std::string> names;
+      std::vector<ProfileTable*> live;
+      ProfileTable finished;
+      bool at_exit = true;
+      bool at_exit_registered = false;
+   };
+
+   static State& state() {
+      static State* s = new State;
+      return *s;
+   }
+
+   struct ThreadTable {
+      ProfileTable* table = nullptr;
+
+      ~ThreadTable() {
+         if(table == nullptr) {
+            return;
+         }
+         auto& s = state();
+         std::lock_guard lock{s.m};
+         for(std::size_t i = 0; i < table->size(); ++i) {
+            s.finished[i].add((*table)[i]);
+         }
+         std::erase(s.live, table);
+         delete table;
+      }
+   };
+
+   static ProfileTable& thread_table() {
+      thread_local ThreadTable t;
+      if(t.table == nullptr) {
+         t.table = new ProfileTable;
+         auto& s = state();
+         std::lock_guard lock{s.m};
+         s.live.push_back(t.table);
+      }
+      return *t.table;
+   }
+};
+
+
+} // namespace detail
+inline detail::Profiler profiler;
+
+
+namespace detail {
+
+
+class ProfileScope {
+public:
+   template <typename F>
+   constexpr explicit ProfileScope(F region_id) {
+      if(!std::is_constant_evaluated()) {
+         id_ = region_id();
+         start_ = Profiler::now();
+      }
+   }
+
+   ProfileScope(const ProfileScope&) = delete;
+   ProfileScope& operator=(const ProfileScope&) = delete;
+
+   constexpr ~ProfileScope() {
+      if(!std::is_constant_evaluated() && id_ > -1) {
+         profiler.record(id_, Profiler::now() - start_);
+      }
+   }
+
+private:
+   long int id_ = -1;
+   std::uint64_t start_ = 0;
+};
+
+
+} // namespace detail
+
+
+} // namespace spp
@@ -4,12 +4,24 @@
 #pragma once
 
 
+#include "../ArrayCommon/algorithm.hpp"
 #include "../ArrayCommon/array_traits.hpp"
+#include "../ArrayCommon/packet.hpp"
+#include "../ArrayCommon/packet_math.hpp"
 #include "../Expr/expr.hpp"
 #include "../StrictCommon/strict_common.hpp"
+#include "philox.hpp"
 #include "random_traits.hpp"
 
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <random>
+#include <type_traits>
+#include <utility>
 
 
 namespace spp {
@@ -139,112 +151,297 @@ template <Real T>
 auto random_not0(Rows m, Cols n);
 
 
-namespace detail {
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Overloads with a seed generate the same numbers for the same seed and stream, regardless of
+// the number of threads. Streams of the same seed are independent.
+template <typename Base>
+   requires detail::NonConstBaseType<RemoveRef<Base>> && Real<BuiltinTypeOf<Base>>
+void random(Base&& A, ValueTypeOf<Base> low, ValueTypeOf<Base> high, Seed seed,
+            Stream stream = Stream{});
 
 
-template <typename T>
-struct Generator;
+template <typename Base>
+   requires detail::NonConstBaseType<RemoveRef<Base>> && Real<BuiltinTypeOf<Base>>
+void random(Base&& A, Low<BuiltinTypeOf<Base>> low, High<BuiltinTypeOf<Base>> high, Seed seed,
+            Stream stream = Stream{});
 
 
-template <Integer T>
-struct Generator<T> {
-   Generator(Strict<T> l, Strict<T> h) : gen{std::random_device{}()}, dst{l.val(), h.val()} {
-   }
+template <typename Base>
+   requires detail::NonConstBaseType<RemoveRef<Base>>
+void random(Base&& A, Seed seed, Stream stream = Stream{});
 
-   auto random() const {
-      return Strict{dst(gen)};
-   }
 
-private:
-   mutable std::mt19937 gen;
-   mutable std::uniform_int_distribution<T> dst;
-};
+template <typename Base>
+   requires detail::NonConstBaseType<RemoveRef<Base>> && Real<BuiltinTypeOf<Base>>
+void random_not0(Base&& A, ValueTypeOf<Base> low, ValueTypeOf<Base> high, Seed seed,
+                 Stream stream = Stream{});
 
 
-template <Boolean T>
-struct Generator<T> {
-   Generator(Strict<T> l, Strict<T> h) : gen{std::random_device{}()}, dst{l.val(), h.val()} {
-   }
+template <typename Base>
+   requires detail::NonConstBaseType<RemoveRef<Base>> && Real<BuiltinTypeOf<Base>>
+void random_not0(Base&& A, Low<BuiltinTypeOf<Base>> low, High<BuiltinTypeOf<Base>> high,
+                 Seed seed, Stream stream = Stream{});
 
-   auto random() const {
-      return dst(gen) % 2 == 0 ? false_sb : true_sb;
-   }
 
-private:
-   mutable std::mt19937 gen;
-   mutable std::uniform_int_distribution<int> dst;
-};
+template <typename Base>
+   requires detail::NonConstBaseType<RemoveRef<Base>> && Real<BuiltinTypeOf<Base>>
+void random_not0(Base&& A, Seed seed, Stream stream = Stream{});
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <Real T>
+auto random(ImplicitInt n, Strict<T> low, Strict<T> high, Seed seed, Stream stream = Stream{});
+
+
+template <Real T>
+auto random(Size n, Low<T> low, High<T> high, Seed seed, Stream stream = Stream{});
+
+
+template <Builtin T>
+auto random(ImplicitInt n, Seed seed, Stream stream = Stream{});
+
+
+template <Builtin T>
+auto random(Size n, Seed seed, Stream stream = Stream{});
+
+
+template <Real T>
+auto random(ImplicitInt m, ImplicitInt n, Strict<T> low, Strict<T> high, Seed seed,
+            Stream stream = Stream{});
+
+
+template <Real T>
+auto random(Rows m, Cols n, Low<T> low, High<T> high, Seed seed, Stream stream = Stream{});
+
+
+template <Builtin T>
+auto random(ImplicitInt m, ImplicitInt n, Seed seed, Stream stream = Stream{});
 
 
-template <StandardFloating T>
-struct Generator<T> {
-   Generator(Strict<T> l, Strict<T> h) : gen{std::random_device{}()}, dst{l.val(), h.val()} {
+template <Builtin T>
+auto random(Rows m, Cols n, Seed seed, Stream stream = Stream{});
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <Real T>
+auto random_not0(ImplicitInt n, Strict<T> low, Strict<T> high, Seed seed,
+                 Stream stream = Stream{});
+
+
+template <Real T>
+auto random_not0(Size n, Low<T> low, High<T> high, Seed seed, Stream stream = Stream{});
+
+
+template <Real T>
+auto random_not0(ImplicitInt n, Seed seed, Stream stream = Stream{});
+
+
+template <Real T>
+auto random_not0(Size n, Seed seed, Stream stream = Stream{});
+
+
+template <Real T>
+auto random_not0(ImplicitInt m, ImplicitInt n, Strict<T> low, Strict<T> high, Seed seed,
+                 Stream stream = Stream{});
+
+
+template <Real T>
+auto random_not0(Rows m, Cols n, Low<T> low, High<T> high, Seed seed, Stream stream = Stream{});
+
+
+template <Real T>
+auto random_not0(ImplicitInt m, ImplicitInt n, Seed seed, Stream stream = Stream{});
+
+
+template <Real T>
+auto random_not0(Rows m, Cols n, Seed seed, Stream stream = Stream{});
+
+
+namespace detail {
+
+
+// Multiples of 2^-52(2^-23 for float) in [0, 1), obtained by setting the mantissa of numbers in
+// [1, 2). Other types use the leading bits of w0 and w1.
+template <Floating T>
+STRICT_NODISCARD_INLINE T unit_random(std::uint64_t w0, std::uint64_t w1) {
+   if constexpr(SameAs<T, double>) {
+      return std::bit_cast<double>((((w0 << 32) | w1) >> 12) | 0x3FF0000000000000) - 1.;
+   } else if constexpr(SameAs<T, float>) {
+      return std::bit_cast<float>(static_cast<std::uint32_t>((w0 >> 9) | 0x3F800000)) - 1.f;
+   } else {
+      constexpr int d = std::min(64, std::numeric_limits<T>::digits);
+      return std::ldexp(static_cast<T>(((w0 << 32) | w1) >> (64 - d)), -d);
    }
+}
+
 
-   auto random() const {
-      return Strict{dst(gen)};
+template <FastMathType T, long int N>
+STRICT_NODISCARD_INLINE Packet<T, N> unit_random(const Packet<std::uint64_t, N>& w0,
+                                                 const Packet<std::uint64_t, N>& w1) {
+   using PU = Packet<std::uint64_t, N>;
+   if constexpr(SameAs<T, double>) {
+      auto bits = packet_shift_right(packet_shift_left(w0, 32) | w1, 12);
+      return packet_bit_cast<double>(bits | PU::broadcast(0x3FF0000000000000))
+           - Packet<double, N>::broadcast(1.);
+   } else {
+      auto bits = packet_shift_right(w0, 9) | PU::broadcast(0x3F800000);
+      return packet_bit_cast<float>(packet_cast<std::uint32_t>(bits))
+           - Packet<float, N>::broadcast(1.f);
    }
+}
 
-private:
-   mutable std::mt19937 gen;
-   mutable std::uniform_real_distribution<T> dst;
-};
 
+// Quadruple precision numbers are generated as double precision numbers.
+template <Builtin T>
+using RandomWorkType = std::conditional_t<NotQuadruple<T>, T, double>;
+
+
+// Counter-based generator of numbers uniformly distributed in [low, high), integers in
+// [low, high]. Each counter of Philox gives four words, floats use one word and other types two,
+// so that a counter generates several elements. Packets of n = packet_size<T> elements use
+// n / per_counter consecutive counters, element k of a packet is generated from lane
+// k % lanes and words of slot k / lanes, and elements are generated from the same counters
+// one at a time. Element i therefore only depends on i, the seed, and the stream(the key), and
+// arrays of random numbers are evaluated by packets and threads regardless of how elements are
+// partitioned. Rejected numbers(zeros of random_not0 and integers that would bias the
+// distribution) are generated again with the next attempt, which is the third word of the
+// counter.
+template <Builtin T, bool not0 = false>
+class CounterGenerator : public PacketOperation {
+public:
+   CounterGenerator(Strict<T> low, Strict<T> high, Strict<unsigned> seed, Strict<unsigned> stream)
+      : low_{low},
+        high_{high},
+        key_{seed.val(), stream.val()} {
+   }
 
-// Generates quadruple precision numbers that are double precision numbers.
-#ifdef STRICT_QUAD_PRECISION
-template <Quadruple T>
-struct Generator<T> {
-   Generator(Strict<T> l, Strict<T> h)
-      : gen{std::random_device{}()},
-        dst{l.sd().val(), h.sd().val()} {
+   Strict<T> operator()(Strict<long int> i) const {
+      const auto n = static_cast<std::uint64_t>(i.val());
+      const auto k = n % packet_size<T>;
+      const auto c = (n - k) / per_counter + k % lanes;
+      const auto s = static_cast<std::size_t>(k / lanes * words);
+      for(std::uint64_t attempt = 0;; ++attempt) {
+         const auto w = philox4x32<std::uint64_t>(
+            {c & philox_mask, c >> 32, attempt & philox_mask, attempt >> 32}, key_);
+         if(auto [x, accepted] = this->value(w[s], w[s + words - 1]);
+            accepted && (!not0 || x != Zero<T>)) {
+            return x;
+         }
+      }
    }
 
-   auto random() const {
-      return Strict{dst(gen)}.sq();
+   // Lanes of i must be consecutive indexes, the first of which is a multiple of N, as given by
+   // packets of irange. Zeros of random_not0 are generated again one at a time.
+   template <long int N>
+   Packet<T, N> operator()(const Packet<long int, N>& i) const
+      requires FastMathType<T>
+   {
+      Packet<T, N> x;
+      if constexpr(N == packet_size<T>) {
+         using PU = Packet<std::uint64_t, long(lanes)>;
+         const auto c = PU::iota(static_cast<std::uint64_t>(i.v[0]) / per_counter);
+         const auto w = philox4x32<PU>(
+            {c & PU::broadcast(philox_mask), packet_shift_right(c, 32), PU{}, PU{}}, key_);
+         for(std::size_t s = 0; s < per_counter; ++s) {
+            const auto part = unit_random<T>(w[s * words], w[s * words + words - 1]);
+            for(long int k = 0; k < long(lanes); ++k) {
+               x.v[long(s * lanes) + k] = part.v[k];
+            }
+         }
+         x = Packet<T, N>::broadcast(low_.val())
+           + x * Packet<T, N>::broadcast((high_ - low_).val());
+      } else {
+         for(long int k = 0; k < N; ++k) {
+            x.v[k] = (*this)(Strict{i.v[k]}).val();
+         }
+         return x;
+      }
+
+      if constexpr(not0) {
+         const auto zero = Packet<T, N>::broadcast(T(0));
+         if(!packet_all(packet_less(zero, x) | packet_less(x, zero))) {
+            for(long int k = 0; k < N; ++k) {
+               if(x.v[k] == T(0)) {
+                  x.v[k] = (*this)(Strict{i.v[k]}).val();
+               }
+            }
+         }
+      }
+      return x;
    }
 
 private:
-   mutable std::mt19937 gen;
-   mutable std::uniform_real_distribution<double> dst;
+   static constexpr std::uint64_t words = SameAs<T, float> ? 1 : 2;
+   static constexpr std::uint64_t per_counter = 4 / words;
+   static constexpr std::uint64_t lanes = packet_size<T> / per_counter;
+
+   Strict<T> low_;
+   Strict<T> high_;
+   PhiloxKey key_;
+
+   std::pair<Strict<T>, bool> value(std::uint64_t w0, std::uint64_t w1) const {
+      if constexpr(Floating<T>) {
+         using W = RandomWorkType<T>;
+         const auto low = strict_cast<W>(low_);
+         const auto high = strict_cast<W>(high_);
+         const auto x = low + Strict{unit_random<W>(w0, w1)} * (high - low);
+         return {strict_cast<T>(x), true};
+      } else if constexpr(Integer<T>) {
+         // The range has 2^64 elements if r is zero.
+         const auto u = (w0 << 32) | w1;
+         const auto low = static_cast<std::uint64_t>(low_.val());
+         const auto r = static_cast<std::uint64_t>(high_.val()) - low + 1;
+         if(r == 0) {
+            return {Strict{static_cast<T>(low + u)}, true};
+         }
+         return {Strict{static_cast<T>(low + u % r)}, u >= (std::uint64_t{0} - r) % r};
+      } else {
+         return {(w0 & 1) != 0 ? true_sb : false_sb, true};
+      }
+   }
 };
-#endif
+
+
+inline Strict<unsigned> random_seed() {
+   return Strict{std::random_device{}()};
+}
 
 
 template <Builtin T>
 Strict<T> rands(Strict<T> low, Strict<T> high) {
    ASSERT_STRICT_DEBUG(low <= high);
-   Generator<T> g{low, high};
-   return g.random();
+   CounterGenerator<T> g{low, high, random_seed(), Zero<unsigned>};
+   return g(0_sl);
 }
 
 
 template <typename Base>
    requires NonConstBaseType<RemoveRef<Base>>
-void random(Base&& A, ValueTypeOf<Base> low, ValueTypeOf<Base> high) {
+void random(Base&& A, ValueTypeOf<Base> low, ValueTypeOf<Base> high, Strict<unsigned> seed,
+            Strict<unsigned> stream) {
    ASSERT_STRICT_DEBUG(low <= high);
-   Generator<BuiltinTypeOf<Base>> g{low, high};
-   for(auto& x : A) {
-      x = g.random();
+   CounterGenerator<BuiltinTypeOf<Base>> g{low, high, seed, stream};
+   if constexpr(OneDimBaseType<RemoveRef<Base>>) {
+      copy(generate(irange(A.size()), g), A);
+   } else {
+      copy(generate(irange2D(A.rows(), A.cols()), g), A);
    }
 }
 
 
 template <Builtin T>
-auto random(ImplicitInt n, Strict<T> low, Strict<T> high) {
+auto random(ImplicitInt n, Strict<T> low, Strict<T> high, Strict<unsigned> seed,
+            Strict<unsigned> stream) {
    ASSERT_STRICT_DEBUG(low <= high);
-   Generator<T> g{low, high};
-   auto G = [g]([[maybe_unused]] auto x) { return g.random(); };
-   return detail::generate_random(const1D<T>(n, Zero<T>), G, low, high);
+   return generate(irange(n), CounterGenerator<T>{low, high, seed, stream});
 }
 
 
 template <Builtin T>
-auto random(ImplicitInt m, ImplicitInt n, Strict<T> low, Strict<T> high) {
+auto random(ImplicitInt m, ImplicitInt n, Strict<T> low, Strict<T> high, Strict<unsigned> seed,
+            Strict<unsigned> stream) {
    ASSERT_STRICT_DEBUG(low <= high);
-   Generator<T> g{low, high};
-   auto G = [g]([[maybe_unused]] auto x) { return g.random(); };
-   return detail::generate_random(const2D<T>(m, n, Zero<T>), G, low, high);
+   return generate(irange2D(m, n), CounterGenerator<T>{low, high, seed, stream});
 }
 
 
@@ -253,65 +450,41 @@ template <Real T>
 Strict<T> rands_not0(Strict<T> low, Strict<T> high) {
    ASSERT_STRICT_DEBUG(low <= high);
    ASSERT_STRICT_DEBUG(!(low == Zero<T> && high == Zero<T>));
-
-   Generator<T> g{low, high};
-   while(true) {
-      if(auto r = g.random(); r != Zero<T>) {
-         return r;
-      }
-   }
+   CounterGenerator<T, true> g{low, high, random_seed(), Zero<unsigned>};
+   return g(0_sl);
 }
 
 
 template <typename Base>
    requires NonConstBaseType<RemoveRef<Base>> && Real<BuiltinTypeOf<Base>>
-void random_not0(Base&& A, ValueTypeOf<Base> low, ValueTypeOf<Base> high) {
+void random_not0(Base&& A, ValueTypeOf<Base> low, ValueTypeOf<Base> high, Strict<unsigned> seed,
+                 Strict<unsigned> stream) {
    ASSERT_STRICT_DEBUG(low <= high);
    ASSERT_STRICT_DEBUG(!(low == Zero<RealTypeOf<Base>> && high == Zero<RealTypeOf<Base>>));
-
-   Generator<RealTypeOf<Base>> g{low, high};
-   for(auto& x : A) {
-      while(true) {
-         if(auto r = g.random(); r != Zero<RealTypeOf<Base>>) {
-            x = r;
-            break;
-         }
-      }
+   CounterGenerator<RealTypeOf<Base>, true> g{low, high, seed, stream};
+   if constexpr(OneDimBaseType<RemoveRef<Base>>) {
+      copy(generate(irange(A.size()), g), A);
+   } else {
+      copy(generate(irange2D(A.rows(), A.cols()), g), A);
    }
 }
 
 
 template <Real T>
-auto random_not0(ImplicitInt n, Strict<T> low, Strict<T> high) {
+auto random_not0(ImplicitInt n, Strict<T> low, Strict<T> high, Strict<unsigned> seed,
+                 Strict<unsigned> stream) {
    ASSERT_STRICT_DEBUG(low <= high);
    ASSERT_STRICT_DEBUG(!(low == Zero<T> && high == Zero<T>));
-
-   Generator<T> g{low, high};
-   auto G = [g]([[maybe_unused]] auto x) {
-      while(true) {
-         if(auto r = g.random(); r != Zero<T>) {
-            return r;
-         }
-      }
-   };
-   return detail::generate_random(const1D<T>(n, Zero<T>), G, low, high);
+   return generate(irange(n), CounterGenerator<T, true>{low, high, seed, stream});
 }
 
 
 template <Real T>
-auto random_not0(ImplicitInt m, ImplicitInt n, Strict<T> low, Strict<T> high) {
+auto random_not0(ImplicitInt m, ImplicitInt n, Strict<T> low, Strict<T> high,
+                 Strict<unsigned> seed, Strict<unsigned> stream) {
    ASSERT_STRICT_DEBUG(low <= high);
    ASSERT_STRICT_DEBUG(!(low == Zero<T> && high == Zero<T>));
-
-   Generator<T> g{low, high};
-   auto G = [g]([[maybe_unused]] auto x) {
-      while(true) {
-         if(auto r = g.random(); r != Zero<T>) {
-            return r;
-         }
-      }
-   };
-   return detail::generate_random(const2D<T>(m, n, Zero<T>), G, low, high);
+   return generate(irange2D(m, n), CounterGenerator<T, true>{low, high, seed, stream});
 }
 
 
@@ -362,7 +535,9 @@ template <typename Base, typename... BasesAndStrict>
 void random(Base&& A, BasesAndStrict&&... AArgs_and_xargs) {
    detail::random(A,
                   detail::second_last_value_of(AArgs_and_xargs...),
-                  detail::last_value_of(AArgs_and_xargs...));
+                  detail::last_value_of(AArgs_and_xargs...),
+                  detail::random_seed(),
+                  Zero<unsigned>);
    if constexpr(sizeof...(BasesAndStrict) >= 3) {
       random(AArgs_and_xargs...);
    }
@@ -374,7 +549,9 @@ template <typename Base, typename... BasesAndLowHigh>
 void random(Base&& A, BasesAndLowHigh&&... AArgs_and_xargs) {
    detail::random(A,
                   detail::second_last_value_of(AArgs_and_xargs...).get(),
-                  detail::last_value_of(AArgs_and_xargs...).get());
+                  detail::last_value_of(AArgs_and_xargs...).get(),
+                  detail::random_seed(),
+                  Zero<unsigned>);
    if constexpr(sizeof...(BasesAndLowHigh) >= 3) {
       random(AArgs_and_xargs...);
    }
@@ -385,7 +562,11 @@ template <typename... Base>
    requires detail::RandomBases<Base...>
 void random(Base&&... A) {
    static_assert(sizeof...(Base) > 0);
-   (..., detail::random(A, Zero<BuiltinTypeOf<Base>>, One<BuiltinTypeOf<Base>>));
+   (..., detail::random(A,
+                      Zero<BuiltinTypeOf<Base>>,
+                      One<BuiltinTypeOf<Base>>,
+                      detail::random_seed(),
+                      Zero<unsigned>));
 }
 
 
@@ -395,7 +576,9 @@ template <typename Base, typename... BasesAndStrict>
 void random_not0(Base&& A, BasesAndStrict&&... AArgs_and_xargs) {
    detail::random_not0(A,
                        detail::second_last_value_of(AArgs_and_xargs...),
-                       detail::last_value_of(AArgs_and_xargs...));
+                       detail::last_value_of(AArgs_and_xargs...),
+                       detail::random_seed(),
+                       Zero<unsigned>);
    if constexpr(sizeof...(BasesAndStrict) >= 3) {
       random_not0(AArgs_and_xargs...);
    }
@@ -407,7 +590,9 @@ template <typename Base, typename... BasesAndLowHigh>
 void random_not0(Base&& A, BasesAndLowHigh&&... AArgs_and_xargs) {
    detail::random_not0(A,
                        detail::second_last_value_of(AArgs_and_xargs...).get(),
-                       detail::last_value_of(AArgs_and_xargs...).get());
+                       detail::last_value_of(AArgs_and_xargs...).get(),
+                       detail::random_seed(),
+                       Zero<unsigned>);
    if constexpr(sizeof...(BasesAndLowHigh) >= 3) {
       random_not0(AArgs_and_xargs...);
    }
@@ -418,14 +603,18 @@ template <typename... Base>
    requires detail::RandomRealBases<Base...>
 void random_not0(Base&&... A) {
    static_assert(sizeof...(Base) > 0);
-   (..., detail::random_not0(A, Zero<BuiltinTypeOf<Base>>, One<BuiltinTypeOf<Base>>));
+   (..., detail::random_not0(A,
+                           Zero<BuiltinTypeOf<Base>>,
+                           One<BuiltinTypeOf<Base>>,
+                           detail::random_seed(),
+                           Zero<unsigned>));
 }
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 template <Real T>
 auto random(ImplicitInt n, Strict<T> low, Strict<T> high) {
-   return detail::random<T>(n, low, high);
+   return detail::random<T>(n, low, high, detail::random_seed(), Zero<unsigned>);
 }
 
 
@@ -437,7 +626,7 @@ auto random(Size n, Low<T> low, High<T> high) {
 
 template <Builtin T>
 auto random(ImplicitInt n) {
-   return detail::random<T>(n, Zero<T>, One<T>);
+   return detail::random<T>(n, Zero<T>, One<T>, detail::random_seed(), Zero<unsigned>);
 }
 
 
@@ -449,7 +638,7 @@ auto random(Size n) {
 
 template <Real T>
 auto random(ImplicitInt m, ImplicitInt n, Strict<T> low, Strict<T> high) {
-   return detail::random<T>(m, n, low, high);
+   return detail::random<T>(m, n, low, high, detail::random_seed(), Zero<unsigned>);
 }
 
 
@@ -461,7 +650,7 @@ auto random(Rows m, Cols n, Low<T> low, High<T> high) {
 
 template <Builtin T>
 auto random(ImplicitInt m, ImplicitInt n) {
-   return detail::random<T>(m, n, Zero<T>, One<T>);
+   return detail::random<T>(m, n, Zero<T>, One<T>, detail::random_seed(), Zero<unsigned>);
 }
 
 
@@ -474,7 +663,7 @@ auto random(Rows m, Cols n) {
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 template <Real T>
 auto random_not0(ImplicitInt n, Strict<T> low, Strict<T> high) {
-   return detail::random_not0<T>(n, low, high);
+   return detail::random_not0<T>(n, low, high, detail::random_seed(), Zero<unsigned>);
 }
 
 
@@ -486,7 +675,7 @@ auto random_not0(Size n, Low<T> low, High<T> high) {
 
 template <Real T>
 auto random_not0(ImplicitInt n) {
-   return detail::random_not0<T>(n, Zero<T>, One<T>);
+   return detail::random_not0<T>(n, Zero<T>, One<T>, detail::random_seed(), Zero<unsigned>);
 }
 
 
@@ -498,7 +687,7 @@ auto random_not0(Size n) {
 
 template <Real T>
 auto random_not0(ImplicitInt m, ImplicitInt n, Strict<T> low, Strict<T> high) {
-   return detail::random_not0<T>(m, n, low, high);
+   return detail::random_not0<T>(m, n, low, high, detail::random_seed(), Zero<unsigned>);
 }
 
 
@@ -510,7 +699,7 @@ auto random_not0(Rows m, Cols n, Low<T> low, High<T> high) {
 
 template <Real T>
 auto random_not0(ImplicitInt m, ImplicitInt n) {
-   return detail::random_not0<T>(m, n, Zero<T>, One<T>);
+   return detail::random_not0<T>(m, n, Zero<T>, One<T>, detail::random_seed(), Zero<unsigned>);
 }
 
 
@@ -520,4 +709,152 @@ auto random_not0(Rows m, Cols n) {
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename Base>
+   requires detail::NonConstBaseType<RemoveRef<Base>> && Real<BuiltinTypeOf<Base>>
+void random(Base&& A, ValueTypeOf<Base> low, ValueTypeOf<Base> high, Seed seed, Stream stream) {
+   detail::random(A, low, high, seed.get(), stream.get());
+}
+
+
+template <typename Base>
+   requires detail::NonConstBaseType<RemoveRef<Base>> && Real<BuiltinTypeOf<Base>>
+void random(Base&& A, Low<BuiltinTypeOf<Base>> low, High<BuiltinTypeOf<Base>> high, Seed seed,
+            Stream stream) {
+   detail::random(A, low.get(), high.get(), seed.get(), stream.get());
+}
+
+
+template <typename Base>
+   requires detail::NonConstBaseType<RemoveRef<Base>>
+void random(Base&& A, Seed seed, Stream stream) {
+   detail::random(
+      A, Zero<BuiltinTypeOf<Base>>, One<BuiltinTypeOf<Base>>, seed.get(), stream.get());
+}
+
+
+template <typename Base>
+   requires detail::NonConstBaseType<RemoveRef<Base>> && Real<BuiltinTypeOf<Base>>
+void random_not0(Base&& A, ValueTypeOf<Base> low, ValueTypeOf<Base> high, Seed seed,
+                 Stream stream) {
+   detail::random_not0(A, low, high, seed.get(), stream.get());
+}
+
+
+template <typename Base>
+   requires detail::NonConstBaseType<RemoveRef<Base>> && Real<BuiltinTypeOf<Base>>
+void random_not0(Base&& A, Low<BuiltinTypeOf<Base>> low, High<BuiltinTypeOf<Base>> high,
+                 Seed seed, Stream stream) {
+   detail::random_not0(A, low.get(), high.get(), seed.get(), stream.get());
+}
+
+
+template <typename Base>
+   requires detail::NonConstBaseType<RemoveRef<Base>> && Real<BuiltinTypeOf<Base>>
+void random_not0(Base&& A, Seed seed, Stream stream) {
+   detail::random_not0(
+      A, Zero<BuiltinTypeOf<Base>>, One<BuiltinTypeOf<Base>>, seed.get(), stream.get());
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <Real T>
+auto random(ImplicitInt n, Strict<T> low, Strict<T> high, Seed seed, Stream stream) {
+   return detail::random<T>(n, low, high, seed.get(), stream.get());
+}
+
+
+template <Real T>
+auto random(Size n, Low<T> low, High<T> high, Seed seed, Stream stream) {
+   return random<T>(n.get(), low.get(), high.get(), seed, stream);
+}
+
+
+template <Builtin T>
+auto random(ImplicitInt n, Seed seed, Stream stream) {
+   return detail::random<T>(n, Zero<T>, One<T>, seed.get(), stream.get());
+}
+
+
+template <Builtin T>
+auto random(Size n, Seed seed, Stream stream) {
+   return random<T>(n.get(), seed, stream);
+}
+
+
+template <Real T>
+auto random(ImplicitInt m, ImplicitInt n, Strict<T> low, Strict<T> high, Seed seed,
+            Stream stream) {
+   return detail::random<T>(m, n, low, high, seed.get(), stream.get());
+}
+
+
+template <Real T>
+auto random(Rows m, Cols n, Low<T> low, High<T> high, Seed seed, Stream stream) {
+   return random<T>(m.get(), n.get(), low.get(), high.get(), seed, stream);
+}
+
+
+template <Builtin T>
+auto random(ImplicitInt m, ImplicitInt n, Seed seed, Stream stream) {
+   return detail::random<T>(m, n, Zero<T>, One<T>, seed.get(), stream.get());
+}
+
+
+template <Builtin T>
+auto random(Rows m, Cols n, Seed seed, Stream stream) {
+   return random<T>(m.get(), n.get(), seed, stream);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <Real T>
+auto random_not0(ImplicitInt n, Strict<T> low, Strict<T> high, Seed seed, Stream stream) {
+   return detail::random_not0<T>(n, low, high, seed.get(), stream.get());
+}
+
+
+template <Real T>
+auto random_not0(Size n, Low<T> low, High<T> high, Seed seed, Stream stream) {
+   return random_not0<T>(n.get(), low.get(), high.get(), seed, stream);
+}
+
+
+template <Real T>
+auto random_not0(ImplicitInt n, Seed seed, Stream stream) {
+   return detail::random_not0<T>(n, Zero<T>, One<T>, seed.get(), stream.get());
+}
+
+
+template <Real T>
+auto random_not0(Size n, Seed seed, Stream stream) {
+   return random_not0<T>(n.get(), seed, stream);
+}
+
+
+template <Real T>
+auto random_not0(ImplicitInt m, ImplicitInt n, Strict<T> low, Strict<T> high, Seed seed,
+                 Stream stream) {
+   return detail::random_not0<T>(m, n, low, high, seed.get(), stream.get());
+}
+
+
+template <Real T>
+auto random_not0(Rows m, Cols n, Low<T> low, High<T> high, Seed seed, Stream stream) {
+   return random_not0<T>(m.get(), n.get(), low.get(), high.get(), seed, stream);
+}
+
+
+template <Real T>
+auto random_not0(ImplicitInt m, ImplicitInt n, Seed seed, Stream stream) {
+   return detail::random_not0<T>(m, n, Zero<T>, One<T>, seed.get(), stream.get());
+}
+
+
+template <Real T>
+auto random_not0(Rows m, Cols n, Seed seed, Stream stream) {
+   return random_not0<T>(m.get(), n.get(), seed, stream);
+}
+
+
 } // namespace spp
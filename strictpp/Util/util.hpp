@@ -5,6 +5,9 @@
 
 
 #include "error_tools.hpp"
+#include "file_mapping.hpp"
+#include "file_writer.hpp"
+#include "profiler.hpp"
 #include "random.hpp"
 #include "random_traits.hpp"
 #include "semi_random.hpp"
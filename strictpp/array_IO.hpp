@@ -5,18 +5,24 @@
 
 
 #include "ArrayCommon/array_traits.hpp"
+#include "ArrayCommon/text_parser.hpp"
+#include "ArrayCommon/text_writer.hpp"
 #include "Expr/expr.hpp"
 #include "StrictCommon/strict_common.hpp"
+#include "Util/file_mapping.hpp"
+#include "Util/file_writer.hpp"
+#include "Util/profiler.hpp"
 #include "array_ops.hpp"
 #include "derived1D.hpp"
 #include "derived2D.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <fstream>
-#include <iomanip>
 #include <iostream>
-#include <sstream>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 
@@ -27,16 +33,26 @@ template <Builtin T, AlignmentFlag AF>
 std::istream& operator>>(std::istream& is, Array1D<T, AF>& A);
 
 
-template <Builtin T, AlignmentFlag AF>
-std::istream& operator>>(std::istream& is, Array2D<T, AF>& A);
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+std::istream& operator>>(std::istream& is, Array2D<T, AF, LF>& A);
 
 
 template <Builtin T, AlignmentFlag AF>
 void read_from_file(const std::string& file_path, Array1D<T, AF>& A);
 
 
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+void read_from_file(const std::string& file_path, Array2D<T, AF, LF>& A);
+
+
+// Values separated by the delimiter and optional whitespace, one row per line. Text formats
+// accepted by the readers are described in ArrayCommon/text_parser.hpp.
 template <Builtin T, AlignmentFlag AF>
-void read_from_file(const std::string& file_path, Array2D<T, AF>& A);
+void read_from_csv(const std::string& file_path, Array1D<T, AF>& A, char delimiter = ',');
+
+
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+void read_from_csv(const std::string& file_path, Array2D<T, AF, LF>& A, char delimiter = ',');
 
 
 std::ostream& operator<<(std::ostream& os, BaseType auto const& A);
@@ -86,11 +102,9 @@ public:
       return *this;
    }
 
-   friend std::ostream& ostream_base_print(std::ostream& os, OneDimBaseType auto const& A,
-                                           const std::string& name);
+   friend void write_text(OneDimBaseType auto const& A, const std::string& name, auto write);
 
-   friend std::ostream& ostream_base_print(std::ostream& os, TwoDimBaseType auto const& A,
-                                           const std::string& name);
+   friend void write_text(TwoDimBaseType auto const& A, const std::string& name, auto write);
 
 private:
    bool detailed_ = false;
@@ -105,95 +119,79 @@ namespace detail {
 
 
 template <Builtin T, AlignmentFlag AF>
-std::istream& istream_base_read(std::istream& is, Array1D<T, AF>& A) {
-   T x{};
-   index_t count{};
-
-   Array1D<T, AF> tmp(8);
-   while(is >> x) {
-      tmp.un(count++) = Strict{x};
-      if(tmp.size() == count) {
-         tmp.resize(2_sl * count);
-      }
+void read_text(const char* first, const char* last, char delimiter, Array1D<T, AF>& A) {
+   STRICT_PROFILE_SCOPE("io/read");
+   const auto chunks = parse_text<T>(first, last, delimiter, false);
+   long int n = 0;
+   for(const auto& c : chunks) {
+      n += long(c.values.size());
    }
 
-   ASSERT_STRICT_ALWAYS_MSG(is.eof(), "Invalid input.\n");
-   is.clear();
-
-   tmp.resize(count);
+   Array1D<T, AF> tmp(n, uninitialized);
+   copy_chunks(chunks, tmp.data());
    A.swap(tmp);
-   return is;
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-void get_first_row(const std::string& line, Array2D<T, AF>& A) {
-   A.resize(1, 4);
-
-   T x{};
-   std::istringstream iss{line};
-   index_t ncols{};
-   while(iss >> x) {
-      A(0, ncols++) = Strict{x};
-      if(A.cols() == ncols) {
-         A.resize(1, 2_sl * ncols);
-      }
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+void read_text(const char* first, const char* last, char delimiter, Array2D<T, AF, LF>& A) {
+   STRICT_PROFILE_SCOPE("io/read");
+   const auto chunks = parse_text<T>(first, last, delimiter, true);
+   long int rows = 0, cols = 0;
+   for(const auto& c : chunks) {
+      rows += c.rows;
+      cols = c.rows > 0 ? c.cols : cols;
    }
-   if(ncols != 0_sl) {
-      A.resize(1, ncols);
-   } else {
-      A.resize(0, 0);
+
+   Array2D<T, AF> tmp;
+   if(rows > 0) {
+      tmp.resize(rows, cols, uninitialized, false);
+      copy_chunks(chunks, tmp.data());
    }
 
-   ASSERT_STRICT_ALWAYS_MSG(iss.eof(), "Invalid input.\n");
-   iss.clear();
+   // Rows are read in row-major order.
+   if constexpr(LF == RowMajor) {
+      A.swap(tmp);
+   } else {
+      A.resize_and_assign(tmp);
+   }
 }
 
 
 template <Builtin T, AlignmentFlag AF>
-void get_row(const std::string& line, index_t row, Array2D<T, AF>& A) {
-   T x{};
-   std::istringstream iss{line};
-   index_t ncols{};
-   while(iss >> x) {
-      A(row, ncols++) = Strict{x};
-   }
-
-   ASSERT_STRICT_ALWAYS(ncols == A.cols());
-   ASSERT_STRICT_ALWAYS_MSG(iss.eof(), "Invalid input.\n");
-   iss.clear();
+std::istream& istream_base_read(std::istream& is, Array1D<T, AF>& A) {
+   const auto s = read_all(is);
+   read_text(s.data(), s.data() + s.size(), '\0', A);
+   is.clear();
+   return is;
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-std::istream& istream_base_read(std::istream& is, Array2D<T, AF>& A) {
-   std::string line{};
-   Array2D<T, AF> tmp;
-   // Important to test tmp.empty() first, otherwise get an off-by-1 error.
-   while(tmp.empty() && std::getline(is, line)) {
-      get_first_row<T>(line, tmp);
-   }
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+std::istream& istream_base_read(std::istream& is, Array2D<T, AF, LF>& A) {
+   const auto s = read_all(is);
+   read_text(s.data(), s.data() + s.size(), '\0', A);
+   return is;
+}
 
-   if(!tmp.empty()) {
-      const index_t ncols = tmp.cols();
-      index_t row_count = 1_sl;
 
-      tmp.resize(2, ncols);
-      while(std::getline(is, line)) {
-         if(line.empty()) {
-            continue;
-         }
-         get_row<T>(line, row_count, tmp);
-         ++row_count;
-         if(tmp.rows() == row_count) {
-            tmp.resize(2_sl * row_count, ncols);
-         }
-      }
-      tmp.resize(row_count, ncols);
+// Files are memory-mapped instead of being copied into a buffer.
+template <typename ArrayType>
+void read_text_file(const std::string& file_path, char delimiter, ArrayType& A) {
+   std::ifstream ifs{file_path, std::ios::binary | std::ios::ate};
+   ASSERT_STRICT_ALWAYS_MSG(ifs, "Invalid file path.\n");
+#ifdef STRICT_HAS_MMAP
+   if(ifs.tellg() > 0) {
+      ifs.close();
+      const FileMapping map{file_path};
+      const auto* first = reinterpret_cast<const char*>(map.data());
+      read_text(first, first + map.size(), delimiter, A);
+      return;
    }
-
-   A.swap(tmp);
-   return is;
+#endif
+   ifs.seekg(0);
+   const auto s = read_all(ifs);
+   read_text(s.data(), s.data() + s.size(), delimiter, A);
 }
 
 
@@ -201,7 +199,11 @@ auto count_digit(Real auto number) -> int {
    if(number == 0) {
       return 1;
    }
-   return static_cast<int>(std::log10(number)) + 1;
+   if constexpr(Floating<decltype(number)>) {
+      return static_cast<int>(log10s(Strict{number}).val()) + 1;
+   } else {
+      return static_cast<int>(std::log10(number)) + 1;
+   }
 }
 
 
@@ -218,49 +220,90 @@ const auto floating_spacing = []<Floating T>(Strict<T> x) -> int {
 };
 
 
-STRICT_INLINE std::string smart_spaces(index_t maxi, index_t i) {
-   int max_digits = count_digit(maxi.val());
-   int ind_digits = count_digit(i.val());
-   return std::string(static_cast<std::string::size_type>(1 + max_digits - ind_digits), 32);
+// Elements of one-dimensional arrays and rows of two-dimensional arrays are formatted in blocks
+// of about text_block elements.
+inline constexpr long int text_block = 16'384;
+
+
+// Formats items [0, n) of A in blocks of the given size by format_items(buf, first, last) and
+// passes the text to write(data, size) in order. Blocks are formatted in parallel if parallel
+// evaluation is enabled, unless A generates random values. The text that follows the last
+// flush is left in buf.
+template <BaseType Base, typename F, typename W>
+void write_blocks(const Base& A, TextBuffer& buf, index_t n, index_t block, F format_items,
+                  W write) {
+   if constexpr(std::is_copy_constructible_v<Base>) {
+      if(use_parallel(A.size())) {
+         write(buf.data(), buf.size());
+         buf.clear();
+         const index_t group = execution.threads() * block;
+         std::vector<TextBuffer> buffers(to_size_t(execution.threads()));
+         for(index_t first = 0_sl; first < n; first += group) {
+            const index_t last = mins(first + group, n);
+            const index_t nblocks = (last - first + block - 1_sl) / block;
+            parallel_for(nblocks, 1_sl, [&](index_t b_first, index_t b_last) {
+               for(index_t b = b_first; b < b_last; ++b) {
+                  auto& out = buffers[to_size_t(b)];
+                  out.clear();
+                  const index_t i = first + b * block;
+                  format_items(out, i, mins(i + block, last));
+               }
+            });
+            for(index_t b = 0_sl; b < nblocks; ++b) {
+               write(buffers[to_size_t(b)].data(), buffers[to_size_t(b)].size());
+            }
+         }
+         return;
+      }
+   }
+
+   for(index_t first = 0_sl; first < n; first += block) {
+      format_items(buf, first, mins(first + block, n));
+      if(buf.size() >= text_flush_size) {
+         write(buf.data(), buf.size());
+         buf.clear();
+      }
+   }
 }
 
 
-std::ostream& ostream_base_print(std::ostream& os, OneDimBaseType auto const& A,
-                                 const std::string& name) {
+void write_text(OneDimBaseType auto const& A, const std::string& name, auto write) {
+   STRICT_PROFILE_SCOPE("io/write");
+   TextBuffer buf;
    if(!name.empty()) {
-      os << name << ':' << '\n';
+      buf.append(name);
+      buf.append(":\n");
    }
 
    if(array_format.detailed_ && A.empty()) {
-      os << "[]\n";
+      buf.append("[]\n");
    }
 
-   if(array_format.style_ == ArrayFormat::Style::Column) {
-      if(!array_format.detailed_) {
-         for(auto i : irange(A)) {
-            os << A.un(i) << '\n';
-         }
-      } else {
-         for(auto i : irange(A)) {
-            os << "[" << i.sul() << "] =" << smart_spaces(A.size(), i) << A.un(i) << '\n';
+   const bool detailed = array_format.detailed_;
+   const bool column = array_format.style_ == ArrayFormat::Style::Column;
+   const int max_digits = count_digit(A.size().val());
+   auto format_items = [&](TextBuffer& out, index_t first, index_t last) {
+      for(index_t i = first; i < last; ++i) {
+         if(detailed) {
+            out.append('[');
+            const int digits = append_index(out, i);
+            out.append("] =");
+            out.append(' ', column ? static_cast<std::size_t>(1 + max_digits - digits) : 1);
          }
-      }
-   } else {
-      if(!array_format.detailed_) {
-         for(auto i : irange(A)) {
-            auto spaces = i == A.size_m1() ? "" : "  ";
-            os << A.un(i) << spaces;
-         }
-      } else {
-         for(auto i : irange(A)) {
-            auto spaces = i == A.size_m1() ? "" : "  ";
-            os << "[" << i.sul() << "] =" << " " << A.un(i) << spaces;
+         append_value(out, A.un(i).val());
+         if(column) {
+            out.append('\n');
+         } else if(i != A.size_m1()) {
+            out.append("  ");
          }
       }
-      os << '\n';
-   }
+   };
 
-   return os << std::flush;
+   write_blocks(A, buf, A.size(), index_t{text_block}, format_items, write);
+   if(!column) {
+      buf.append('\n');
+   }
+   write(buf.data(), buf.size());
 }
 
 
@@ -280,61 +323,80 @@ auto max_if_needed(TwoDimBaseType auto const& A) {
 }
 
 
-std::ostream& set_width_if_needed(std::ostream& os, TwoDimBaseType auto const& A, auto max_abs) {
+// Width of the columns of two-dimensional arrays, zero if values are not aligned.
+int field_width(TwoDimBaseType auto const& A, auto max_abs) {
    using builtin_type = BuiltinTypeOf<decltype(A)>;
    if constexpr(Boolean<builtin_type>) {
-      return os << std::setw(boolean_spacing());
+      return boolean_spacing();
 
    } else if constexpr(Integer<builtin_type>) {
-      return os << std::setw(integer_spacing(max_abs));
+      return integer_spacing(max_abs);
 
    } else {
-      if(format.is_scientific()) {
-         return os;
+      if(format.is_scientific() || format.is_shortest()) {
+         return 0;
       } else {
-         return os << std::setw(floating_spacing(max_abs));
+         return floating_spacing(max_abs);
       }
    }
 }
 
 
-std::ostream& ostream_base_print(std::ostream& os, TwoDimBaseType auto const& A,
-                                 const std::string& name) {
+void write_text(TwoDimBaseType auto const& A, const std::string& name, auto write) {
+   STRICT_PROFILE_SCOPE("io/write");
+   TextBuffer buf;
    if(!name.empty()) {
-      os << name << ":" << '\n';
+      buf.append(name);
+      buf.append(":\n");
    }
 
    if(array_format.detailed_ && A.empty()) {
-      os << "[]\n";
+      buf.append("[]\n");
    }
 
-   auto max_abs = max_if_needed(A);
-
-   for(auto i : irange(A.rows())) {
-      for(auto j : irange(A.cols())) {
-         auto post_space = j == A.cols_m1() ? "" : "  ";
-         if(array_format.detailed_) {
-            os << '[' << i.sul() << ", " << j.sul() << "] =" << smart_spaces(A.rows(), i);
+   const bool detailed = array_format.detailed_;
+   const int width = field_width(A, max_if_needed(A));
+   const int max_digits = count_digit(A.rows().val());
+   auto format_items = [&](TextBuffer& out, index_t first, index_t last) {
+      for(index_t i = first; i < last; ++i) {
+         for(auto j : irange(A.cols())) {
+            if(detailed) {
+               out.append('[');
+               const int digits = append_index(out, i);
+               out.append(", ");
+               append_index(out, j);
+               out.append("] =");
+               out.append(' ', static_cast<std::size_t>(1 + max_digits - digits));
+            }
+            append_value(out, A.un(i, j).val(), width);
+            if(j != A.cols_m1()) {
+               out.append("  ");
+            }
          }
-         set_width_if_needed(os, A, max_abs) << A.un(i, j) << post_space;
+         out.append('\n');
       }
-      os << '\n';
-   }
+   };
+
+   const index_t block{std::max(text_block / std::max(A.cols().val(), 1L), 1L)};
+   write_blocks(A, buf, A.rows(), block, format_items, write);
+   write(buf.data(), buf.size());
+}
+
 
+std::ostream& ostream_base_print(std::ostream& os, BaseType auto const& A,
+                                 const std::string& name) {
+   write_text(A, name, [&os](const char* data, std::size_t n) {
+      os.write(data, static_cast<std::streamsize>(n));
+   });
    return os << std::flush;
 }
 
 
 template <BaseType Base1, BaseType... BArgs>
 void print_helper(const Base1& A1, const BArgs&... AArgs) {
-   std::ostringstream stream;
-   if constexpr(sizeof...(AArgs) == 0) {
-      ostream_base_print(stream, A1, "");
-      std::cout << stream.str();
-      return;
-   } else {
-      ostream_base_print(stream, A1, "") << '\n' << std::flush;
-      std::cout << stream.str();
+   ostream_base_print(std::cout, A1, "");
+   if constexpr(sizeof...(AArgs) > 0) {
+      std::cout << '\n' << std::flush;
       print_helper(AArgs...);
    }
 }
@@ -350,27 +412,35 @@ std::istream& operator>>(std::istream& is, Array1D<T, AF>& A) {
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-std::istream& operator>>(std::istream& is, Array2D<T, AF>& A) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+std::istream& operator>>(std::istream& is, Array2D<T, AF, LF>& A) {
    return detail::istream_base_read(is, A);
 }
 
 
 template <Builtin T, AlignmentFlag AF>
 void read_from_file(const std::string& file_path, Array1D<T, AF>& A) {
-   std::ifstream ifs{file_path};
-   ASSERT_STRICT_ALWAYS_MSG(ifs, "Invalid file path.\n");
-   detail::istream_base_read(ifs, A);
-   ifs.close();
+   detail::read_text_file(file_path, '\0', A);
+}
+
+
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+void read_from_file(const std::string& file_path, Array2D<T, AF, LF>& A) {
+   detail::read_text_file(file_path, '\0', A);
 }
 
 
 template <Builtin T, AlignmentFlag AF>
-void read_from_file(const std::string& file_path, Array2D<T, AF>& A) {
-   std::ifstream ifs{file_path};
-   ASSERT_STRICT_ALWAYS_MSG(ifs, "Invalid file path.\n");
-   detail::istream_base_read(ifs, A);
-   ifs.close();
+void read_from_csv(const std::string& file_path, Array1D<T, AF>& A, char delimiter) {
+   detail::validate_delimiter(delimiter);
+   detail::read_text_file(file_path, delimiter, A);
+}
+
+
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+void read_from_csv(const std::string& file_path, Array2D<T, AF, LF>& A, char delimiter) {
+   detail::validate_delimiter(delimiter);
+   detail::read_text_file(file_path, delimiter, A);
 }
 
 
@@ -380,9 +450,7 @@ std::ostream& operator<<(std::ostream& os, BaseType auto const& A) {
 
 
 void print(BaseType auto const& A, const std::string& name) {
-   std::ostringstream stream;
-   detail::ostream_base_print(stream, A, name);
-   std::cout << stream.str();
+   detail::ostream_base_print(std::cout, A, name);
 }
 
 
@@ -405,10 +473,8 @@ void printn(BaseType auto const&... A) {
 
 
 void print_to_file(const std::string& file_path, BaseType auto const& A, const std::string& name) {
-   std::ofstream ofs{file_path};
-   ASSERT_STRICT_ALWAYS_MSG(ofs, "Invalid file path.\n");
-   detail::ostream_base_print(ofs, A, name);
-   ofs.close();
+   detail::FileWriter file{file_path};
+   detail::write_text(A, name, [&file](const char* data, std::size_t n) { file.write(data, n); });
 }
 
 
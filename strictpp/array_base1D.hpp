@@ -8,7 +8,10 @@
 #include "StrictCommon/strict_common.hpp"
 #include "iterator.hpp"
 
+#include <algorithm>
+#include <memory_resource>
 #include <new>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -32,11 +35,16 @@ public:
 
    // Constructors.
    STRICT_NODISCARD_CONSTEXPR ArrayBase1D();
-   STRICT_NODISCARD explicit ArrayBase1D(ImplicitInt n)
-      requires(AF == Aligned);
-   STRICT_NODISCARD_CONSTEXPR explicit ArrayBase1D(ImplicitInt n)
-      requires(AF == Unaligned);
+   STRICT_NODISCARD_CONSTEXPR explicit ArrayBase1D(ImplicitInt n);
    STRICT_NODISCARD_CONSTEXPR explicit ArrayBase1D(Size n);
+   // Allocates from mr instead of the default resource of the calling thread.
+   STRICT_NODISCARD_CONSTEXPR explicit ArrayBase1D(ImplicitInt n, std::pmr::memory_resource* mr);
+   STRICT_NODISCARD_CONSTEXPR explicit ArrayBase1D(ImplicitInt n, Uninitialized);
+   STRICT_NODISCARD_CONSTEXPR explicit ArrayBase1D(Size n, Uninitialized);
+   STRICT_NODISCARD_CONSTEXPR explicit ArrayBase1D(ImplicitInt n, Uninitialized,
+                                                   std::pmr::memory_resource* mr);
+   STRICT_NODISCARD explicit ArrayBase1D(ImplicitInt n, FirstTouch);
+   STRICT_NODISCARD explicit ArrayBase1D(Size n, FirstTouch);
    STRICT_NODISCARD_CONSTEXPR explicit ArrayBase1D(ImplicitInt n, value_type x);
    STRICT_NODISCARD_CONSTEXPR explicit ArrayBase1D(Size n, Value<T> x);
    STRICT_NODISCARD_CONSTEXPR ArrayBase1D(use::List1D<value_type> list);
@@ -63,7 +71,16 @@ public:
    STRICT_CONSTEXPR void swap(ArrayBase1D& A) noexcept;
    STRICT_CONSTEXPR void swap(ArrayBase1D&& A) noexcept;
 
+   // Storage is only reallocated if n exceeds the capacity.
    STRICT_CONSTEXPR auto& resize(ImplicitInt n, ImplicitBool preserve = true);
+   // New elements are left uninitialized.
+   STRICT_CONSTEXPR auto& resize(ImplicitInt n, Uninitialized, ImplicitBool preserve = true);
+
+   // Capacity is only reduced by shrink_to_fit. Insertions at the back grow it geometrically,
+   // so that appending elements one at a time takes amortized constant time.
+   STRICT_CONSTEXPR auto& reserve(ImplicitInt n);
+   STRICT_CONSTEXPR auto& shrink_to_fit();
+   STRICT_CONSTEXPR_INLINE index_t capacity() const;
 
    STRICT_CONSTEXPR auto& resize_and_assign(OneDimBaseType auto const& A);
 
@@ -94,6 +111,10 @@ public:
    STRICT_CONSTEXPR auto& insert_front(OneDimBaseType auto const& A);
    STRICT_CONSTEXPR auto& insert_back(OneDimBaseType auto const& A);
 
+   STRICT_CONSTEXPR auto& push_back(value_type x);
+   STRICT_CONSTEXPR auto& push_back(Value<builtin_type> x);
+   STRICT_CONSTEXPR auto& append(OneDimBaseType auto const& A);
+
    ////////////////////////////////////////////////////////////////////////////////////////////////////
    STRICT_CONSTEXPR_INLINE index_t size() const;
 
@@ -121,50 +142,92 @@ public:
 
    STRICT_NODISCARD_CONSTEXPR_INLINE static int alignment();
 
+   // Returns nullptr if the array is allocated by operator new.
+   STRICT_NODISCARD_CONSTEXPR std::pmr::memory_resource* resource() const;
+
 private:
    value_type* data_;
    index_t n_;
+   index_t cap_;
+   std::pmr::memory_resource* mr_;
+
+   STRICT_CONSTEXPR static value_type* allocate(index_t n, std::pmr::memory_resource* mr,
+                                                bool init);
+   STRICT_CONSTEXPR static void deallocate(value_type* p, index_t n,
+                                           std::pmr::memory_resource* mr);
+
+   STRICT_CONSTEXPR void reallocate(index_t cap);
+   STRICT_CONSTEXPR void grow(index_t n);
 };
 
 
 template <Builtin T, AlignmentFlag AF>
 STRICT_NODISCARD_CONSTEXPR ArrayBase1D<T, AF>::ArrayBase1D() : data_{nullptr},
-                                                               n_{} {
+                                                               n_{},
+                                                               cap_{},
+                                                               mr_{nullptr} {
 }
 
 
 template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD ArrayBase1D<T, AF>::ArrayBase1D(ImplicitInt n)
-   requires(AF == Aligned)
-   : data_{nullptr},
-     n_{n.get()} {
-   ASSERT_STRICT_DEBUG(n_ > -1_sl);
-   if(n_ != 0_sl) {
-      data_ = new (std::align_val_t{detail::alignment_of<T, AF>()}) value_type[to_size_t(n_)];
-   }
+STRICT_NODISCARD_CONSTEXPR ArrayBase1D<T, AF>::ArrayBase1D(ImplicitInt n)
+   : ArrayBase1D(n, current_resource()) {
 }
 
 
 template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR ArrayBase1D<T, AF>::ArrayBase1D(ImplicitInt n)
-   requires(AF == Unaligned)
-   : data_{nullptr},
-     n_{n.get()} {
-   ASSERT_STRICT_DEBUG(n_ > -1_sl);
-   if(n_ != 0_sl) {
-      data_ = new value_type[to_size_t(n_)];
-   }
+STRICT_NODISCARD_CONSTEXPR ArrayBase1D<T, AF>::ArrayBase1D(Size n) : ArrayBase1D(n.get()) {
 }
 
 
 template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR ArrayBase1D<T, AF>::ArrayBase1D(Size n) : ArrayBase1D(n.get()) {
+STRICT_NODISCARD_CONSTEXPR ArrayBase1D<T, AF>::ArrayBase1D(ImplicitInt n,
+                                                           std::pmr::memory_resource* mr)
+   : data_{allocate(n.get(), mr, true)},
+     n_{n.get()},
+     cap_{n.get()},
+     mr_{mr} {
+}
+
+
+template <Builtin T, AlignmentFlag AF>
+STRICT_NODISCARD_CONSTEXPR ArrayBase1D<T, AF>::ArrayBase1D(ImplicitInt n, Uninitialized)
+   : ArrayBase1D(n, uninitialized, current_resource()) {
+}
+
+
+template <Builtin T, AlignmentFlag AF>
+STRICT_NODISCARD_CONSTEXPR ArrayBase1D<T, AF>::ArrayBase1D(Size n, Uninitialized)
+   : ArrayBase1D(n.get(), uninitialized) {
+}
+
+
+template <Builtin T, AlignmentFlag AF>
+STRICT_NODISCARD_CONSTEXPR ArrayBase1D<T, AF>::ArrayBase1D(ImplicitInt n, Uninitialized,
+                                                           std::pmr::memory_resource* mr)
+   : data_{allocate(n.get(), mr, false)},
+     n_{n.get()},
+     cap_{n.get()},
+     mr_{mr} {
+}
+
+
+template <Builtin T, AlignmentFlag AF>
+STRICT_NODISCARD ArrayBase1D<T, AF>::ArrayBase1D(ImplicitInt n, FirstTouch)
+   : ArrayBase1D(n, uninitialized) {
+   first_touch_fill(data_, n_);
+}
+
+
+template <Builtin T, AlignmentFlag AF>
+STRICT_NODISCARD ArrayBase1D<T, AF>::ArrayBase1D(Size n, FirstTouch)
+   : ArrayBase1D(n.get(), first_touch) {
 }
 
 
 template <Builtin T, AlignmentFlag AF>
 STRICT_NODISCARD_CONSTEXPR ArrayBase1D<T, AF>::ArrayBase1D(ImplicitInt n, value_type x)
-   : ArrayBase1D(n) {
+   : ArrayBase1D(n, uninitialized) {
    fill(x, *this);
 }
 
@@ -177,7 +240,7 @@ STRICT_NODISCARD_CONSTEXPR ArrayBase1D<T, AF>::ArrayBase1D(Size n, Value<T> x)
 
 template <Builtin T, AlignmentFlag AF>
 STRICT_NODISCARD_CONSTEXPR ArrayBase1D<T, AF>::ArrayBase1D(use::List1D<value_type> list)
-   : ArrayBase1D(to_index_t(list.size())) {
+   : ArrayBase1D(to_index_t(list.size()), uninitialized) {
    copy(list, *this);
 }
 
@@ -186,7 +249,7 @@ STRICT_NODISCARD_CONSTEXPR ArrayBase1D<T, AF>::ArrayBase1D(use::List1D<value_typ
 template <Builtin T, AlignmentFlag AF>
 template <LinearIteratorType L>
 STRICT_NODISCARD_CONSTEXPR ArrayBase1D<T, AF>::ArrayBase1D(L b, L e)
-   : ArrayBase1D(abss(Strict{e - b})) {
+   : ArrayBase1D(abss(Strict{e - b}), uninitialized) {
    ASSERT_STRICT_DEBUG(e >= b);
    copy(b, e, *this);
 }
@@ -194,7 +257,8 @@ STRICT_NODISCARD_CONSTEXPR ArrayBase1D<T, AF>::ArrayBase1D(L b, L e)
 
 template <Builtin T, AlignmentFlag AF>
 STRICT_NODISCARD_CONSTEXPR ArrayBase1D<T, AF>::ArrayBase1D(const ArrayBase1D& A)
-   : ArrayBase1D(A.size()) {
+   : ArrayBase1D(A.size(), uninitialized) {
+   count_copy();
    copy(A, *this);
 }
 
@@ -202,13 +266,16 @@ STRICT_NODISCARD_CONSTEXPR ArrayBase1D<T, AF>::ArrayBase1D(const ArrayBase1D& A)
 template <Builtin T, AlignmentFlag AF>
 STRICT_NODISCARD_CONSTEXPR ArrayBase1D<T, AF>::ArrayBase1D(ArrayBase1D&& A) noexcept
    : data_{std::exchange(A.data_, nullptr)},
-     n_{std::exchange(A.n_, 0_sl)} {
+     n_{std::exchange(A.n_, 0_sl)},
+     cap_{std::exchange(A.cap_, 0_sl)},
+     mr_{A.mr_} {
+   count_move();
 }
 
 
 template <Builtin T, AlignmentFlag AF>
 STRICT_NODISCARD_CONSTEXPR ArrayBase1D<T, AF>::ArrayBase1D(OneDimBaseType auto const& A)
-   : ArrayBase1D(A.size()) {
+   : ArrayBase1D(A.size(), uninitialized) {
    copy(A, *this);
 }
 
@@ -232,6 +299,7 @@ template <Builtin T, AlignmentFlag AF>
 STRICT_CONSTEXPR ArrayBase1D<T, AF>& ArrayBase1D<T, AF>::operator=(const ArrayBase1D& A) {
    if(this != &A) {
       ASSERT_STRICT_DEBUG(same_size(*this, A));
+      count_copy();
       copy(A, *this);
    }
    return *this;
@@ -242,6 +310,7 @@ template <Builtin T, AlignmentFlag AF>
 STRICT_CONSTEXPR ArrayBase1D<T, AF>& ArrayBase1D<T, AF>::operator=(ArrayBase1D&& A) noexcept {
    if(this != &A) {
       NORMAL_ASSERT_STRICT_DEBUG(same_size(*this, A));
+      count_move();
       this->swap(A);
       A.swap(ArrayBase1D{});
    }
@@ -252,6 +321,10 @@ STRICT_CONSTEXPR ArrayBase1D<T, AF>& ArrayBase1D<T, AF>::operator=(ArrayBase1D&&
 template <Builtin T, AlignmentFlag AF>
 STRICT_CONSTEXPR ArrayBase1D<T, AF>& ArrayBase1D<T, AF>::operator=(OneDimBaseType auto const& A) {
    ASSERT_STRICT_DEBUG(same_size(*this, A));
+   // Assignments of arrays of the same type are resolved to this overload by derived classes.
+   if constexpr(std::is_base_of_v<ArrayBase1D, RemoveCVRef<decltype(A)>>) {
+      count_copy();
+   }
    copy(A, *this);
    return *this;
 }
@@ -261,7 +334,7 @@ template <Builtin T, AlignmentFlag AF>
 ArrayBase1D<T, AF>::~ArrayBase1D()
    requires(AF == Aligned)
 {
-   operator delete[](data_, std::align_val_t{detail::alignment_of<T, AF>()});
+   deallocate(data_, cap_, mr_);
 }
 
 
@@ -269,7 +342,7 @@ template <Builtin T, AlignmentFlag AF>
 STRICT_CONSTEXPR ArrayBase1D<T, AF>::~ArrayBase1D()
    requires(AF == Unaligned)
 {
-   delete[] data_;
+   deallocate(data_, cap_, mr_);
 }
 
 
@@ -277,6 +350,8 @@ template <Builtin T, AlignmentFlag AF>
 STRICT_CONSTEXPR void ArrayBase1D<T, AF>::swap(ArrayBase1D& A) noexcept {
    std::swap(data_, A.data_);
    std::swap(n_, A.n_);
+   std::swap(cap_, A.cap_);
+   std::swap(mr_, A.mr_);
 }
 
 
@@ -290,20 +365,63 @@ template <Builtin T, AlignmentFlag AF>
 STRICT_CONSTEXPR auto& ArrayBase1D<T, AF>::resize(ImplicitInt n, ImplicitBool preserve) {
    ASSERT_STRICT_DEBUG(n.get() > -1_sl);
 
+   if(auto n_old = n_; n.get() != n_old) {
+      this->resize(n, uninitialized, preserve);
+      auto first = preserve.get() ? mins(n_old, n_) : 0_sl;
+      std::fill(data_ + first.val(), data_ + n_.val(), value_type{});
+   }
+   return static_cast<StrictArray1D<ArrayBase1D>&>(*this);
+}
+
+
+template <Builtin T, AlignmentFlag AF>
+STRICT_CONSTEXPR auto& ArrayBase1D<T, AF>::resize(ImplicitInt n, Uninitialized,
+                                                  ImplicitBool preserve) {
+   ASSERT_STRICT_DEBUG(n.get() > -1_sl);
+
    if(auto n_new = n.get(); n_new != n_) {
-      ArrayBase1D tmp(n_new);
-      if(preserve.get()) {
-         copyn(*this, tmp, mins(n_, n_new));
+      if(n_new > cap_) {
+         // Elements that are not preserved are not copied.
+         if(!preserve.get()) {
+            n_ = 0_sl;
+         }
+         this->reallocate(n_new);
       }
-      this->swap(tmp);
+      n_ = n_new;
+   }
+   return static_cast<StrictArray1D<ArrayBase1D>&>(*this);
+}
+
+
+template <Builtin T, AlignmentFlag AF>
+STRICT_CONSTEXPR auto& ArrayBase1D<T, AF>::reserve(ImplicitInt n) {
+   ASSERT_STRICT_DEBUG(n.get() > -1_sl);
+   if(n.get() > cap_) {
+      this->reallocate(n.get());
+   }
+   return static_cast<StrictArray1D<ArrayBase1D>&>(*this);
+}
+
+
+template <Builtin T, AlignmentFlag AF>
+STRICT_CONSTEXPR auto& ArrayBase1D<T, AF>::shrink_to_fit() {
+   if(cap_ != n_) {
+      this->reallocate(n_);
    }
    return static_cast<StrictArray1D<ArrayBase1D>&>(*this);
 }
 
 
+template <Builtin T, AlignmentFlag AF>
+STRICT_CONSTEXPR_INLINE index_t ArrayBase1D<T, AF>::capacity() const {
+   return cap_;
+}
+
+
 template <Builtin T, AlignmentFlag AF>
 STRICT_CONSTEXPR auto& ArrayBase1D<T, AF>::resize_and_assign(OneDimBaseType auto const& A) {
-   ArrayBase1D tmp(A);
+   ArrayBase1D tmp(A.size(), uninitialized, mr_);
+   copy(A, tmp);
    this->swap(tmp);
    return static_cast<StrictArray1D<ArrayBase1D>&>(*this);
 }
@@ -311,6 +429,11 @@ STRICT_CONSTEXPR auto& ArrayBase1D<T, AF>::resize_and_assign(OneDimBaseType auto
 
 template <Builtin T, AlignmentFlag AF>
 STRICT_CONSTEXPR auto& ArrayBase1D<T, AF>::resize_and_assign(StrictArray1D<ArrayBase1D>&& A) {
+   // Storage of A is only reused if it is allocated from the same resource.
+   if(this->resource() != A.resource()) {
+      return this->resize_and_assign(static_cast<const StrictArray1D<ArrayBase1D>&>(A));
+   }
+   count_move();
    this->swap(A);
    A.swap(ArrayBase1D{});
    return static_cast<StrictArray1D<ArrayBase1D>&>(*this);
@@ -324,10 +447,8 @@ STRICT_CONSTEXPR auto& ArrayBase1D<T, AF>::remove(ImplicitInt pos, ImplicitInt c
    ASSERT_STRICT_DEBUG(valid_index(*this, pos.get()));
    ASSERT_STRICT_DEBUG(valid_index(*this, pos.get() + count.get() - 1_sl));
 
-   ArrayBase1D tmp(this->size() - count.get());
-   copyn(*this, tmp, pos.get());
-   copyn(*this, tmp, pos.get() + count.get(), pos.get(), this->size() - pos.get() - count.get());
-   this->swap(tmp);
+   std::copy(data_ + (pos.get() + count.get()).val(), data_ + n_.val(), data_ + pos.get().val());
+   n_ -= count.get();
    return static_cast<StrictArray1D<ArrayBase1D>&>(*this);
 }
 
@@ -373,12 +494,12 @@ STRICT_CONSTEXPR auto& ArrayBase1D<T, AF>::remove(const std::vector<ImplicitInt>
    if(!indexes.empty()) {
       auto ci = complement_index_vector(
          valid_index<RemoveCVRef<decltype(*this)>>, this->size(), *this, indexes);
-      ArrayBase1D tmp(to_index_t(ci.size()));
-
-      for(index_t i = 0_sl; i < tmp.size(); ++i) {
-         tmp.un(i) = (*this).un(ci[to_size_t(i)]);
+      // Indexes are increasing, so elements are moved towards the front without overwriting
+      // the ones that are not moved yet.
+      n_ = to_index_t(ci.size());
+      for(index_t i = 0_sl; i < n_; ++i) {
+         (*this).un(i) = (*this).un(ci[to_size_t(i)]);
       }
-      this->swap(tmp);
    }
 
    return static_cast<StrictArray1D<ArrayBase1D>&>(*this);
@@ -389,12 +510,10 @@ STRICT_CONSTEXPR auto& ArrayBase1D<T, AF>::remove(const std::vector<ImplicitInt>
 template <Builtin T, AlignmentFlag AF>
 STRICT_CONSTEXPR auto& ArrayBase1D<T, AF>::insert(ImplicitInt pos, value_type x) {
    ASSERT_STRICT_DEBUG(pos.get() >= 0_sl && pos.get() <= this->size());
-   ArrayBase1D tmp(this->size() + 1_sl);
-   copyn(*this, tmp, pos.get());
-   tmp.un(pos.get()) = x;
-   copyn(*this, tmp, pos.get(), pos.get() + 1_sl, this->size() - pos.get());
-
-   this->swap(tmp);
+   this->grow(n_ + 1_sl);
+   std::copy_backward(data_ + pos.get().val(), data_ + n_.val(), data_ + n_.val() + 1);
+   data_[pos.get().val()] = x;
+   ++n_;
    return static_cast<StrictArray1D<ArrayBase1D>&>(*this);
 }
 
@@ -432,7 +551,18 @@ STRICT_CONSTEXPR auto& ArrayBase1D<T, AF>::insert_back(Value<builtin_type> x) {
 template <Builtin T, AlignmentFlag AF>
 STRICT_CONSTEXPR auto& ArrayBase1D<T, AF>::insert(ImplicitInt pos, OneDimBaseType auto const& A) {
    ASSERT_STRICT_DEBUG(pos.get() >= 0_sl && pos.get() <= this->size());
-   ArrayBase1D tmp(this->size() + A.size());
+   // A may refer to elements of this array, which are not modified when appending.
+   if(pos.get() == n_) {
+      const auto count = A.size();
+      this->grow(n_ + count);
+      for(index_t i = 0_sl; i < count; ++i) {
+         data_[(n_ + i).val()] = A.un(i);
+      }
+      n_ += count;
+      return static_cast<StrictArray1D<ArrayBase1D>&>(*this);
+   }
+
+   ArrayBase1D tmp(this->size() + A.size(), uninitialized, mr_);
    copyn(*this, tmp, pos.get());
    copyn(A, tmp, 0_sl, pos.get(), A.size());
    copyn(*this, tmp, pos.get(), pos.get() + A.size(), this->size() - pos.get());
@@ -460,6 +590,24 @@ STRICT_CONSTEXPR auto& ArrayBase1D<T, AF>::insert_back(OneDimBaseType auto const
 }
 
 
+template <Builtin T, AlignmentFlag AF>
+STRICT_CONSTEXPR auto& ArrayBase1D<T, AF>::push_back(value_type x) {
+   return this->insert_back(x);
+}
+
+
+template <Builtin T, AlignmentFlag AF>
+STRICT_CONSTEXPR auto& ArrayBase1D<T, AF>::push_back(Value<builtin_type> x) {
+   return this->insert_back(x.get());
+}
+
+
+template <Builtin T, AlignmentFlag AF>
+STRICT_CONSTEXPR auto& ArrayBase1D<T, AF>::append(OneDimBaseType auto const& A) {
+   return this->insert_back(A);
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 template <Builtin T, AlignmentFlag AF>
 STRICT_CONSTEXPR_INLINE index_t ArrayBase1D<T, AF>::size() const {
@@ -514,6 +662,60 @@ STRICT_NODISCARD_CONSTEXPR_INLINE int ArrayBase1D<T, AF>::alignment() {
 }
 
 
+template <Builtin T, AlignmentFlag AF>
+STRICT_NODISCARD_CONSTEXPR std::pmr::memory_resource* ArrayBase1D<T, AF>::resource() const {
+   return mr_;
+}
+
+
+// Memory resources are not used during constant evaluation, where elements are always
+// initialized.
+template <Builtin T, AlignmentFlag AF>
+STRICT_CONSTEXPR auto ArrayBase1D<T, AF>::allocate(index_t n, std::pmr::memory_resource* mr,
+                                                   bool init) -> value_type* {
+   ASSERT_STRICT_DEBUG(n > -1_sl);
+   if(n == 0_sl) {
+      return nullptr;
+   }
+   if(std::is_constant_evaluated()) {
+      return new value_type[to_size_t(n)];
+   }
+   return allocate_elements<value_type, AF>(mr, to_size_t(n), init);
+}
+
+
+template <Builtin T, AlignmentFlag AF>
+STRICT_CONSTEXPR void ArrayBase1D<T, AF>::deallocate(value_type* p, index_t n,
+                                                     std::pmr::memory_resource* mr) {
+   if(std::is_constant_evaluated()) {
+      delete[] p;
+   } else if(p) {
+      deallocate_elements<value_type, AF>(mr, p, to_size_t(n));
+   }
+}
+
+
+// Moves the elements to new storage of cap >= n_ elements.
+template <Builtin T, AlignmentFlag AF>
+STRICT_CONSTEXPR void ArrayBase1D<T, AF>::reallocate(index_t cap) {
+   ASSERT_STRICT_DEBUG(cap >= n_);
+   value_type* p = allocate(cap, mr_, false);
+   std::copy_n(data_, n_.val(), p);
+   deallocate(data_, cap_, mr_);
+   data_ = p;
+   cap_ = cap;
+}
+
+
+// Ensures that the capacity is at least n by at least doubling it.
+template <Builtin T, AlignmentFlag AF>
+STRICT_CONSTEXPR void ArrayBase1D<T, AF>::grow(index_t n) {
+   if(n > cap_) {
+      this->reallocate(maxs(2_sl * cap_, n));
+   }
+}
+
+
 } // namespace detail
 
 
@@ -9,6 +9,7 @@
 #include "array_base1D.hpp"
 #include "fixed_array_base1D.hpp"
 
+#include <memory_resource>
 #include <utility>
 #include <vector>
 
@@ -24,7 +25,7 @@ namespace detail {
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-template <Builtin T, AlignmentFlag AF>
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
 class STRICT_NODISCARD ArrayBase2D : private ReferenceBase2D, private TwoDimArrayBase {
 public:
    using value_type = Strict<T>;
@@ -34,6 +35,15 @@ public:
    STRICT_NODISCARD_CONSTEXPR ArrayBase2D() = default;
    STRICT_NODISCARD_CONSTEXPR explicit ArrayBase2D(ImplicitInt m, ImplicitInt n);
    STRICT_NODISCARD_CONSTEXPR explicit ArrayBase2D(Rows m, Cols n);
+   // Allocates from mr instead of the default resource of the calling thread.
+   STRICT_NODISCARD_CONSTEXPR explicit ArrayBase2D(ImplicitInt m, ImplicitInt n,
+                                                   std::pmr::memory_resource* mr);
+   STRICT_NODISCARD_CONSTEXPR explicit ArrayBase2D(ImplicitInt m, ImplicitInt n, Uninitialized);
+   STRICT_NODISCARD_CONSTEXPR explicit ArrayBase2D(Rows m, Cols n, Uninitialized);
+   STRICT_NODISCARD_CONSTEXPR explicit ArrayBase2D(ImplicitInt m, ImplicitInt n, Uninitialized,
+                                                   std::pmr::memory_resource* mr);
+   STRICT_NODISCARD explicit ArrayBase2D(ImplicitInt m, ImplicitInt n, FirstTouch);
+   STRICT_NODISCARD explicit ArrayBase2D(Rows m, Cols n, FirstTouch);
    STRICT_NODISCARD_CONSTEXPR explicit ArrayBase2D(ImplicitInt m, ImplicitInt n, value_type x);
    STRICT_NODISCARD_CONSTEXPR explicit ArrayBase2D(Rows m, Cols n, Value<T> x);
    STRICT_NODISCARD_CONSTEXPR ArrayBase2D(use::List2D<value_type> list);
@@ -57,6 +67,16 @@ public:
    STRICT_CONSTEXPR void swap(ArrayBase2D&& A) noexcept;
 
    STRICT_CONSTEXPR auto& resize(ImplicitInt m, ImplicitInt n, ImplicitBool preserve = true);
+   // New elements are left uninitialized.
+   STRICT_CONSTEXPR auto& resize(ImplicitInt m, ImplicitInt n, Uninitialized,
+                                 ImplicitBool preserve = true);
+
+   // Capacity is the number of elements that fit into the allocated storage. It allows adding
+   // and removing rows of row-major arrays, or columns of column-major arrays, at the back
+   // without reallocation. Changing the other dimension moves all elements.
+   STRICT_CONSTEXPR auto& reserve(ImplicitInt m, ImplicitInt n);
+   STRICT_CONSTEXPR auto& shrink_to_fit();
+   STRICT_CONSTEXPR_INLINE index_t capacity() const;
 
    STRICT_CONSTEXPR auto& resize_and_assign(TwoDimBaseType auto const& A);
 
@@ -142,15 +162,29 @@ public:
    = delete;
 
    STRICT_NODISCARD_CONSTEXPR_INLINE static int alignment();
+   STRICT_NODISCARD_CONSTEXPR_INLINE static LayoutFlag layout();
+
+   // Elements in the order in which they are stored.
+   STRICT_NODISCARD_CONSTEXPR ArrayBase1D<T, AF>& storage() &;
+   STRICT_NODISCARD_CONSTEXPR const ArrayBase1D<T, AF>& storage() const&;
+   STRICT_NODISCARD_CONSTEXPR ArrayBase1D<T, AF>& storage() && = delete;
+   STRICT_NODISCARD_CONSTEXPR const ArrayBase1D<T, AF>& storage() const&& = delete;
+
+   // Returns nullptr if the array is allocated by operator new.
+   STRICT_NODISCARD_CONSTEXPR std::pmr::memory_resource* resource() const;
 
 private:
    FixedArrayBase1D<long int, 2, Unaligned> dims_;
    ArrayBase1D<T, AF> data1D_;
+
+   STRICT_CONSTEXPR void resize_storage(ImplicitInt m, ImplicitInt n, bool preserve, bool init);
+   STRICT_CONSTEXPR void grow_storage(index_t n);
+   STRICT_CONSTEXPR_INLINE index_t storage_index(index_t i, index_t j) const;
 };
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF>::ArrayBase2D(ImplicitInt m, ImplicitInt n)
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF, LF>::ArrayBase2D(ImplicitInt m, ImplicitInt n)
    : dims_{m.get(), n.get()},
      data1D_(m.get() * n.get()) {
    ASSERT_STRICT_DEBUG(m.get() >= 0_sl);
@@ -159,66 +193,121 @@ STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF>::ArrayBase2D(ImplicitInt m, Implic
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF>::ArrayBase2D(Rows m, Cols n)
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF, LF>::ArrayBase2D(ImplicitInt m, ImplicitInt n,
+                                                               std::pmr::memory_resource* mr)
+   : dims_{m.get(), n.get()},
+     data1D_(m.get() * n.get(), mr) {
+   ASSERT_STRICT_DEBUG(m.get() >= 0_sl);
+   ASSERT_STRICT_DEBUG(n.get() >= 0_sl);
+   ASSERT_STRICT_DEBUG(semi_valid_row_col_sizes(m.get(), n.get()));
+}
+
+
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF, LF>::ArrayBase2D(ImplicitInt m, ImplicitInt n,
+                                                               Uninitialized)
+   : ArrayBase2D(m, n, uninitialized, current_resource()) {
+}
+
+
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF, LF>::ArrayBase2D(Rows m, Cols n, Uninitialized)
+   : ArrayBase2D(m.get(), n.get(), uninitialized) {
+}
+
+
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF, LF>::ArrayBase2D(ImplicitInt m, ImplicitInt n,
+                                                               Uninitialized,
+                                                               std::pmr::memory_resource* mr)
+   : dims_{m.get(), n.get()},
+     data1D_(m.get() * n.get(), uninitialized, mr) {
+   ASSERT_STRICT_DEBUG(m.get() >= 0_sl);
+   ASSERT_STRICT_DEBUG(n.get() >= 0_sl);
+   ASSERT_STRICT_DEBUG(semi_valid_row_col_sizes(m.get(), n.get()));
+}
+
+
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_NODISCARD ArrayBase2D<T, AF, LF>::ArrayBase2D(ImplicitInt m, ImplicitInt n, FirstTouch)
+   : dims_{m.get(), n.get()},
+     data1D_(m.get() * n.get(), first_touch) {
+   ASSERT_STRICT_DEBUG(m.get() >= 0_sl);
+   ASSERT_STRICT_DEBUG(n.get() >= 0_sl);
+   ASSERT_STRICT_DEBUG(semi_valid_row_col_sizes(m.get(), n.get()));
+}
+
+
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_NODISCARD ArrayBase2D<T, AF, LF>::ArrayBase2D(Rows m, Cols n, FirstTouch)
+   : ArrayBase2D(m.get(), n.get(), first_touch) {
+}
+
+
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF, LF>::ArrayBase2D(Rows m, Cols n)
    : ArrayBase2D(m.get(), n.get()) {
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF>::ArrayBase2D(ImplicitInt m, ImplicitInt n,
-                                                           value_type x)
-   : ArrayBase2D(m, n) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF, LF>::ArrayBase2D(ImplicitInt m, ImplicitInt n,
+                                                               value_type x)
+   : ArrayBase2D(m, n, uninitialized) {
    data1D_ = x;
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF>::ArrayBase2D(Rows m, Cols n, Value<T> x)
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF, LF>::ArrayBase2D(Rows m, Cols n, Value<T> x)
    : ArrayBase2D(m.get(), n.get(), x.get()) {
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF>::ArrayBase2D(use::List2D<value_type> list)
-   : ArrayBase2D(list2D_row_col_sizes(list).first, list2D_row_col_sizes(list).second) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF, LF>::ArrayBase2D(use::List2D<value_type> list)
+   : ArrayBase2D(list2D_row_col_sizes(list).first, list2D_row_col_sizes(list).second,
+                 uninitialized) {
    ASSERT_STRICT_DEBUG(valid_list2D(list));
    copy(list, *this);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF>::ArrayBase2D(TwoDimBaseType auto const& A)
-   : ArrayBase2D(A.rows(), A.cols()) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_NODISCARD_CONSTEXPR ArrayBase2D<T, AF, LF>::ArrayBase2D(TwoDimBaseType auto const& A)
+   : ArrayBase2D(A.rows(), A.cols(), uninitialized) {
    copy(A, *this);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR ArrayBase2D<T, AF>& ArrayBase2D<T, AF>::operator=(value_type x) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR ArrayBase2D<T, AF, LF>& ArrayBase2D<T, AF, LF>::operator=(value_type x) {
    data1D_ = x;
    return *this;
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR ArrayBase2D<T, AF>& ArrayBase2D<T, AF>::operator=(use::List2D<value_type> list) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR ArrayBase2D<T, AF, LF>&
+ArrayBase2D<T, AF, LF>::operator=(use::List2D<value_type> list) {
    ArrayBase2D tmp(list);
    ASSERT_STRICT_DEBUG(same_size(*this, tmp));
-   return *this = std::move(tmp);
+   return *this = tmp;
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR ArrayBase2D<T, AF>& ArrayBase2D<T, AF>::operator=(const ArrayBase2D& A) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR ArrayBase2D<T, AF, LF>& ArrayBase2D<T, AF, LF>::operator=(const ArrayBase2D& A) {
    ASSERT_STRICT_DEBUG(same_size(*this, A));
    data1D_ = A.data1D_;
    return *this;
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR ArrayBase2D<T, AF>& ArrayBase2D<T, AF>::operator=(ArrayBase2D&& A) noexcept {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR ArrayBase2D<T, AF, LF>&
+ArrayBase2D<T, AF, LF>::operator=(ArrayBase2D&& A) noexcept {
    NORMAL_ASSERT_STRICT_DEBUG(same_size(*this, A));
    A.dims_ = 0_sl;
    data1D_ = std::move(A.data1D_);
@@ -226,30 +315,47 @@ STRICT_CONSTEXPR ArrayBase2D<T, AF>& ArrayBase2D<T, AF>::operator=(ArrayBase2D&&
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR ArrayBase2D<T, AF>& ArrayBase2D<T, AF>::operator=(TwoDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR ArrayBase2D<T, AF, LF>&
+ArrayBase2D<T, AF, LF>::operator=(TwoDimBaseType auto const& A) {
    ASSERT_STRICT_DEBUG(same_size(*this, A));
    copy(A, *this);
    return *this;
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR void ArrayBase2D<T, AF>::swap(ArrayBase2D& A) noexcept {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR void ArrayBase2D<T, AF, LF>::swap(ArrayBase2D& A) noexcept {
    dims_ = std::exchange(A.dims_, dims_);
    data1D_.swap(A.data1D_);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR void ArrayBase2D<T, AF>::swap(ArrayBase2D&& A) noexcept {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR void ArrayBase2D<T, AF, LF>::swap(ArrayBase2D&& A) noexcept {
    this->swap(A);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::resize(ImplicitInt m, ImplicitInt n,
-                                                  ImplicitBool preserve) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::resize(ImplicitInt m, ImplicitInt n,
+                                                      ImplicitBool preserve) {
+   this->resize_storage(m, n, preserve.get().val(), true);
+   return static_cast<StrictArray2D<ArrayBase2D>&>(*this);
+}
+
+
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::resize(ImplicitInt m, ImplicitInt n, Uninitialized,
+                                                      ImplicitBool preserve) {
+   this->resize_storage(m, n, preserve.get().val(), false);
+   return static_cast<StrictArray2D<ArrayBase2D>&>(*this);
+}
+
+
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR void ArrayBase2D<T, AF, LF>::resize_storage(ImplicitInt m, ImplicitInt n,
+                                                              bool preserve, bool init) {
    ASSERT_STRICT_DEBUG(m.get() >= 0_sl);
    ASSERT_STRICT_DEBUG(n.get() >= 0_sl);
    ASSERT_STRICT_DEBUG(semi_valid_row_col_sizes(m.get(), n.get()));
@@ -257,42 +363,73 @@ STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::resize(ImplicitInt m, ImplicitInt n,
    const auto d0_new = m.get();
    const auto d1_new = n.get();
 
-   if(preserve.get()) {
-      if(not(d0_new == dims_.un(0) && d1_new == dims_.un(1))) {
-         ArrayBase2D tmp(d0_new, d1_new);
-         for(index_t i = 0_sl; i < mins(dims_.un(0), d0_new); ++i) {
-            for(index_t j = 0_sl; j < mins(dims_.un(1), d1_new); ++j) {
-               tmp.un(i, j) = this->un(i, j);
-            }
-         }
-         this->swap(tmp);
+   if(d0_new == dims_.un(0) && d1_new == dims_.un(1)) {
+      return;
+   }
+
+   // Rows of row-major arrays and columns of column-major arrays are contiguous, so the
+   // storage is resized in place unless preserved elements change their positions.
+   const bool same_leading = LF == RowMajor ? d1_new == dims_.un(1) : d0_new == dims_.un(0);
+   if(!preserve || same_leading || this->size() == 0_sl) {
+      if(init) {
+         data1D_.resize(d0_new * d1_new, preserve);
+      } else {
+         data1D_.resize(d0_new * d1_new, uninitialized, preserve);
       }
+      dims_.un(0) = d0_new;
+      dims_.un(1) = d1_new;
    } else {
-      if(not(d0_new == dims_.un(0) && d1_new == dims_.un(1))) {
-         if(d0_new * d1_new != dims_.un(0) * dims_.un(1)) {
-            ArrayBase2D tmp(d0_new, d1_new);
-            this->swap(tmp);
-         } else {
-            dims_.un(0) = d0_new;
-            dims_.un(1) = d1_new;
+      ArrayBase2D tmp(d0_new, d1_new, uninitialized, this->resource());
+      if(init) {
+         tmp = value_type{};
+      }
+      for(index_t i = 0_sl; i < mins(dims_.un(0), d0_new); ++i) {
+         for(index_t j = 0_sl; j < mins(dims_.un(1), d1_new); ++j) {
+            tmp.un(i, j) = this->un(i, j);
          }
       }
+      this->swap(tmp);
    }
+}
+
+
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::reserve(ImplicitInt m, ImplicitInt n) {
+   ASSERT_STRICT_DEBUG(m.get() >= 0_sl);
+   ASSERT_STRICT_DEBUG(n.get() >= 0_sl);
+   data1D_.reserve(m.get() * n.get());
+   return static_cast<StrictArray2D<ArrayBase2D>&>(*this);
+}
 
+
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::shrink_to_fit() {
+   data1D_.shrink_to_fit();
    return static_cast<StrictArray2D<ArrayBase2D>&>(*this);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::resize_and_assign(TwoDimBaseType auto const& A) {
-   ArrayBase2D tmp(A);
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR_INLINE index_t ArrayBase2D<T, AF, LF>::capacity() const {
+   return data1D_.capacity();
+}
+
+
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::resize_and_assign(TwoDimBaseType auto const& A) {
+   ArrayBase2D tmp(A.rows(), A.cols(), uninitialized, this->resource());
+   copy(A, tmp);
    this->swap(tmp);
    return static_cast<StrictArray2D<ArrayBase2D>&>(*this);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::resize_and_assign(StrictArray2D<ArrayBase2D>&& A) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::resize_and_assign(StrictArray2D<ArrayBase2D>&& A) {
+   // Storage of A is only reused if it is allocated from the same resource.
+   if(this->resource() != A.resource()) {
+      return this->resize_and_assign(static_cast<const StrictArray2D<ArrayBase2D>&>(A));
+   }
    this->swap(A);
    A.swap(ArrayBase2D{});
    return static_cast<StrictArray2D<ArrayBase2D>&>(*this);
@@ -300,14 +437,24 @@ STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::resize_and_assign(StrictArray2D<Array
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_rows(ImplicitInt row_pos, ImplicitInt count) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::remove_rows(ImplicitInt row_pos, ImplicitInt count) {
    ASSERT_STRICT_DEBUG(count.get() > 0_sl);
    ASSERT_STRICT_DEBUG(valid_row(*this, row_pos.get()));
    ASSERT_STRICT_DEBUG(valid_row(*this, row_pos.get() + count.get() - 1_sl));
 
+   if constexpr(LF == RowMajor) {
+      data1D_.remove(row_pos.get() * this->cols(), count.get() * this->cols());
+      dims_.un(0) -= count.get();
+      if(dims_.un(0) == 0_sl) {
+         dims_.un(1) = 0_sl;
+      }
+      return static_cast<StrictArray2D<ArrayBase2D>&>(*this);
+   }
+
    index_t new_rows = this->rows() - count.get();
-   ArrayBase2D tmp(new_rows, new_rows == 0_sl ? 0_sl : this->cols());
+   ArrayBase2D tmp(
+      new_rows, new_rows == 0_sl ? 0_sl : this->cols(), uninitialized, this->resource());
    copy_rows(*this, tmp, row_pos.get());
    copy_rows(*this,
              tmp,
@@ -319,20 +466,30 @@ STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_rows(ImplicitInt row_pos, Impl
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_rows(Pos row_pos, Count count) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::remove_rows(Pos row_pos, Count count) {
    return this->remove_rows(row_pos.get(), count.get());
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_cols(ImplicitInt col_pos, ImplicitInt count) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::remove_cols(ImplicitInt col_pos, ImplicitInt count) {
    ASSERT_STRICT_DEBUG(count.get() > 0_sl);
    ASSERT_STRICT_DEBUG(valid_col(*this, col_pos.get()));
    ASSERT_STRICT_DEBUG(valid_col(*this, col_pos.get() + count.get() - 1_sl));
 
+   if constexpr(LF == ColMajor) {
+      data1D_.remove(col_pos.get() * this->rows(), count.get() * this->rows());
+      dims_.un(1) -= count.get();
+      if(dims_.un(1) == 0_sl) {
+         dims_.un(0) = 0_sl;
+      }
+      return static_cast<StrictArray2D<ArrayBase2D>&>(*this);
+   }
+
    index_t new_cols = this->cols() - count.get();
-   ArrayBase2D tmp(new_cols == 0_sl ? 0_sl : this->rows(), new_cols);
+   ArrayBase2D tmp(
+      new_cols == 0_sl ? 0_sl : this->rows(), new_cols, uninitialized, this->resource());
    copy_cols(*this, tmp, col_pos.get());
    copy_cols(*this,
              tmp,
@@ -344,104 +501,106 @@ STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_cols(ImplicitInt col_pos, Impl
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_cols(Pos col_pos, Count count) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::remove_cols(Pos col_pos, Count count) {
    return this->remove_cols(col_pos.get(), count.get());
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_row(ImplicitInt row_pos) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::remove_row(ImplicitInt row_pos) {
    return this->remove_rows(row_pos, 1);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_row(Pos row_pos) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::remove_row(Pos row_pos) {
    return this->remove_row(row_pos.get());
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_row([[maybe_unused]] Last lst) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::remove_row([[maybe_unused]] Last lst) {
    return this->remove_row(this->rows() - 1_sl);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_col(ImplicitInt col_pos) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::remove_col(ImplicitInt col_pos) {
    return this->remove_cols(col_pos, 1);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_col(Pos col_pos) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::remove_col(Pos col_pos) {
    return this->remove_col(col_pos.get());
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_col([[maybe_unused]] Last lst) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::remove_col([[maybe_unused]] Last lst) {
    return this->remove_col(this->cols() - 1_sl);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_rows_front(ImplicitInt count) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::remove_rows_front(ImplicitInt count) {
    return this->remove_rows(0, count.get());
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_rows_front(Count count) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::remove_rows_front(Count count) {
    return this->remove_rows_front(count.get());
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_rows_back(ImplicitInt count) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::remove_rows_back(ImplicitInt count) {
    return this->remove_rows(this->rows() - count.get(), count.get());
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_rows_back(Count count) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::remove_rows_back(Count count) {
    return this->remove_rows_back(count.get());
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_cols_front(ImplicitInt count) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::remove_cols_front(ImplicitInt count) {
    return this->remove_cols(0, count.get());
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_cols_front(Count count) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::remove_cols_front(Count count) {
    return this->remove_cols_front(count.get());
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_cols_back(ImplicitInt count) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::remove_cols_back(ImplicitInt count) {
    return this->remove_cols(this->cols() - count.get(), count.get());
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_cols_back(Count count) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::remove_cols_back(Count count) {
    return this->remove_cols_back(count.get());
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_rows(const std::vector<ImplicitInt>& indexes) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto&
+ArrayBase2D<T, AF, LF>::remove_rows(const std::vector<ImplicitInt>& indexes) {
    if(!indexes.empty()) {
       auto ci = complement_index_vector(
          valid_row<RemoveCVRef<decltype(*this)>>, this->rows(), *this, indexes);
 
       index_t new_rows = to_index_t(ci.size());
-      ArrayBase2D tmp(new_rows, new_rows == 0_sl ? 0_sl : this->cols());
+      ArrayBase2D tmp(
+         new_rows, new_rows == 0_sl ? 0_sl : this->cols(), uninitialized, this->resource());
       for(index_t i = 0_sl; i < tmp.rows(); ++i) {
          for(index_t j = 0_sl; j < tmp.cols(); ++j) {
             tmp.un(i, j) = (*this).un(ci[to_size_t(i)], j);
@@ -454,14 +613,16 @@ STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_rows(const std::vector<Implici
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_cols(const std::vector<ImplicitInt>& indexes) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto&
+ArrayBase2D<T, AF, LF>::remove_cols(const std::vector<ImplicitInt>& indexes) {
    if(!indexes.empty()) {
       auto ci = complement_index_vector(
          valid_col<RemoveCVRef<decltype(*this)>>, this->cols(), *this, indexes);
 
       index_t new_cols = to_index_t(ci.size());
-      ArrayBase2D tmp(new_cols == 0_sl ? 0_sl : this->rows(), new_cols);
+      ArrayBase2D tmp(
+         new_cols == 0_sl ? 0_sl : this->rows(), new_cols, uninitialized, this->resource());
       for(index_t i = 0_sl; i < tmp.rows(); ++i) {
          for(index_t j = 0_sl; j < tmp.cols(); ++j) {
             tmp.un(i, j) = (*this).un(i, ci[to_size_t(j)]);
@@ -475,16 +636,30 @@ STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::remove_cols(const std::vector<Implici
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_rows(ImplicitInt row_pos,
-                                                       TwoDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::insert_rows(ImplicitInt row_pos,
+                                                           TwoDimBaseType auto const& A) {
    ASSERT_STRICT_DEBUG(row_pos.get() >= 0_sl && row_pos.get() <= this->rows());
    if(this->rows() == 0_sl && this->cols() == 0_sl) {
       return this->resize_and_assign(A);
    }
 
    ASSERT_STRICT_DEBUG(A.cols() == this->cols());
-   ArrayBase2D tmp(this->rows() + A.rows(), this->cols());
+   // A may refer to rows of this array, which are not modified when appending.
+   if(LF == RowMajor && row_pos.get() == this->rows()) {
+      const auto m = this->rows();
+      const auto count = A.rows();
+      this->grow_storage(this->size() + count * this->cols());
+      dims_.un(0) += count;
+      for(index_t i = 0_sl; i < count; ++i) {
+         for(index_t j = 0_sl; j < this->cols(); ++j) {
+            this->un(m + i, j) = A.un(i, j);
+         }
+      }
+      return static_cast<StrictArray2D<ArrayBase2D>&>(*this);
+   }
+
+   ArrayBase2D tmp(this->rows() + A.rows(), this->cols(), uninitialized, this->resource());
 
    copy_rows(*this, tmp, row_pos.get());
    copy_rows(A, tmp, 0_sl, row_pos.get(), A.rows());
@@ -494,34 +669,49 @@ STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_rows(ImplicitInt row_pos,
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_rows(Pos row_pos, TwoDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::insert_rows(Pos row_pos,
+                                                           TwoDimBaseType auto const& A) {
    return this->insert_rows(row_pos.get(), A);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_rows_front(TwoDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::insert_rows_front(TwoDimBaseType auto const& A) {
    return this->insert_rows(0, A);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_rows_back(TwoDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::insert_rows_back(TwoDimBaseType auto const& A) {
    return this->insert_rows(this->rows(), A);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_cols(ImplicitInt col_pos,
-                                                       TwoDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::insert_cols(ImplicitInt col_pos,
+                                                           TwoDimBaseType auto const& A) {
    ASSERT_STRICT_DEBUG(col_pos.get() >= 0_sl && col_pos.get() <= this->cols());
    if(this->rows() == 0_sl && this->cols() == 0_sl) {
       return this->resize_and_assign(A);
    }
 
    ASSERT_STRICT_DEBUG(A.rows() == this->rows());
-   ArrayBase2D tmp(this->rows(), this->cols() + A.cols());
+   // A may refer to columns of this array, which are not modified when appending.
+   if(LF == ColMajor && col_pos.get() == this->cols()) {
+      const auto n = this->cols();
+      const auto count = A.cols();
+      this->grow_storage(this->size() + count * this->rows());
+      dims_.un(1) += count;
+      for(index_t j = 0_sl; j < count; ++j) {
+         for(index_t i = 0_sl; i < this->rows(); ++i) {
+            this->un(i, n + j) = A.un(i, j);
+         }
+      }
+      return static_cast<StrictArray2D<ArrayBase2D>&>(*this);
+   }
+
+   ArrayBase2D tmp(this->rows(), this->cols() + A.cols(), uninitialized, this->resource());
 
    copy_cols(*this, tmp, col_pos.get());
    copy_cols(A, tmp, 0_sl, col_pos.get(), A.cols());
@@ -531,27 +721,28 @@ STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_cols(ImplicitInt col_pos,
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_cols(Pos col_pos, TwoDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::insert_cols(Pos col_pos,
+                                                           TwoDimBaseType auto const& A) {
    return this->insert_cols(col_pos.get(), A);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_cols_front(TwoDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::insert_cols_front(TwoDimBaseType auto const& A) {
    return this->insert_cols(0, A);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_cols_back(TwoDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::insert_cols_back(TwoDimBaseType auto const& A) {
    return this->insert_cols(this->cols(), A);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_row(ImplicitInt row_pos,
-                                                      OneDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::insert_row(ImplicitInt row_pos,
+                                                          OneDimBaseType auto const& A) {
    ASSERT_STRICT_DEBUG(row_pos.get() >= 0_sl && row_pos.get() <= this->rows());
    // Ensure A is not empty to satisfy semi_valid_row_col_sizes.
    if(this->rows() == 0_sl && this->cols() == 0_sl && A.size() != 0_sl) {
@@ -561,7 +752,17 @@ STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_row(ImplicitInt row_pos,
    }
 
    ASSERT_STRICT_DEBUG(A.size() == this->cols());
-   ArrayBase2D tmp(this->rows() + 1_sl, this->cols());
+   if(LF == RowMajor && row_pos.get() == this->rows()) {
+      const auto m = this->rows();
+      this->grow_storage(this->size() + this->cols());
+      dims_.un(0) += 1_sl;
+      for(index_t j = 0_sl; j < A.size(); ++j) {
+         this->un(m, j) = A.un(j);
+      }
+      return static_cast<StrictArray2D<ArrayBase2D>&>(*this);
+   }
+
+   ArrayBase2D tmp(this->rows() + 1_sl, this->cols(), uninitialized, this->resource());
 
    for(index_t i = 0_sl, count = 0_sl; i < tmp.rows(); ++i) {
       if(i != row_pos.get()) {
@@ -581,27 +782,28 @@ STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_row(ImplicitInt row_pos,
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_row(Pos row_pos, OneDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::insert_row(Pos row_pos,
+                                                          OneDimBaseType auto const& A) {
    return this->insert_row(row_pos.get(), A);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_row_front(OneDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::insert_row_front(OneDimBaseType auto const& A) {
    return this->insert_row(0, A);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_row_back(OneDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::insert_row_back(OneDimBaseType auto const& A) {
    return this->insert_row(this->rows(), A);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_col(ImplicitInt col_pos,
-                                                      OneDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::insert_col(ImplicitInt col_pos,
+                                                          OneDimBaseType auto const& A) {
    ASSERT_STRICT_DEBUG(col_pos.get() >= 0_sl && col_pos.get() <= this->cols());
    // Ensure A is not empty to satisfy semi_valid_row_col_sizes.
    if(this->rows() == 0_sl && this->cols() == 0_sl && A.size() != 0_sl) {
@@ -611,7 +813,17 @@ STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_col(ImplicitInt col_pos,
    }
 
    ASSERT_STRICT_DEBUG(A.size() == this->rows());
-   ArrayBase2D tmp(this->rows(), this->cols() + 1_sl);
+   if(LF == ColMajor && col_pos.get() == this->cols()) {
+      const auto n = this->cols();
+      this->grow_storage(this->size() + this->rows());
+      dims_.un(1) += 1_sl;
+      for(index_t i = 0_sl; i < A.size(); ++i) {
+         this->un(i, n) = A.un(i);
+      }
+      return static_cast<StrictArray2D<ArrayBase2D>&>(*this);
+   }
+
+   ArrayBase2D tmp(this->rows(), this->cols() + 1_sl, uninitialized, this->resource());
 
    for(index_t i = 0_sl; i < A.size(); ++i) {
       for(index_t j = 0_sl, count = 0_sl; j < tmp.cols(); ++j) {
@@ -628,104 +840,161 @@ STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_col(ImplicitInt col_pos,
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_col(Pos col_pos, OneDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::insert_col(Pos col_pos,
+                                                          OneDimBaseType auto const& A) {
    return this->insert_col(col_pos.get(), A);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_col_front(OneDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::insert_col_front(OneDimBaseType auto const& A) {
    return this->insert_col(0, A);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR auto& ArrayBase2D<T, AF>::insert_col_back(OneDimBaseType auto const& A) {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR auto& ArrayBase2D<T, AF, LF>::insert_col_back(OneDimBaseType auto const& A) {
    return this->insert_col(this->cols(), A);
 }
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR_INLINE index_t ArrayBase2D<T, AF>::rows() const {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR_INLINE index_t ArrayBase2D<T, AF, LF>::rows() const {
    return dims_.un(0);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR_INLINE index_t ArrayBase2D<T, AF>::cols() const {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR_INLINE index_t ArrayBase2D<T, AF, LF>::cols() const {
    return dims_.un(1);
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_CONSTEXPR_INLINE index_t ArrayBase2D<T, AF>::size() const {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR_INLINE index_t ArrayBase2D<T, AF, LF>::size() const {
    return data1D_.size();
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR_INLINE auto ArrayBase2D<T, AF>::un(ImplicitInt i) -> value_type& {
-   return data1D_.un(i);
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_NODISCARD_CONSTEXPR_INLINE auto ArrayBase2D<T, AF, LF>::un(ImplicitInt i) -> value_type& {
+   if constexpr(LF == RowMajor) {
+      return data1D_.un(i);
+   } else {
+      return data1D_.un(this->storage_index(i.get() / dims_.un(1), i.get() % dims_.un(1)));
+   }
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR_INLINE auto ArrayBase2D<T, AF>::un(ImplicitInt i) const
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_NODISCARD_CONSTEXPR_INLINE auto ArrayBase2D<T, AF, LF>::un(ImplicitInt i) const
    -> const value_type& {
-   return data1D_.un(i);
+   if constexpr(LF == RowMajor) {
+      return data1D_.un(i);
+   } else {
+      return data1D_.un(this->storage_index(i.get() / dims_.un(1), i.get() % dims_.un(1)));
+   }
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR_INLINE auto ArrayBase2D<T, AF>::un(ImplicitInt i, ImplicitInt j)
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_NODISCARD_CONSTEXPR_INLINE auto ArrayBase2D<T, AF, LF>::un(ImplicitInt i, ImplicitInt j)
    -> value_type& {
-   return data1D_.un(i.get() * dims_.un(1) + j.get());
+   return data1D_.un(this->storage_index(i.get(), j.get()));
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR_INLINE auto ArrayBase2D<T, AF>::un(ImplicitInt i, ImplicitInt j) const
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_NODISCARD_CONSTEXPR_INLINE auto
+ArrayBase2D<T, AF, LF>::un(ImplicitInt i, ImplicitInt j) const
    -> const value_type& {
-   return data1D_.un(i.get() * dims_.un(1) + j.get());
+   return data1D_.un(this->storage_index(i.get(), j.get()));
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR auto ArrayBase2D<T, AF>::data() & -> value_type* {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_NODISCARD_CONSTEXPR auto ArrayBase2D<T, AF, LF>::data() & -> value_type* {
    return data1D_.data();
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR auto ArrayBase2D<T, AF>::data() const& -> const value_type* {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_NODISCARD_CONSTEXPR auto ArrayBase2D<T, AF, LF>::data() const& -> const value_type* {
    return data1D_.data();
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD auto ArrayBase2D<T, AF>::blas_data() & -> builtin_type*
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_NODISCARD auto ArrayBase2D<T, AF, LF>::blas_data() & -> builtin_type*
    requires CompatibleBuiltin<T>
 {
    return data1D_.blas_data();
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD auto ArrayBase2D<T, AF>::blas_data() const& -> const builtin_type*
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_NODISCARD auto ArrayBase2D<T, AF, LF>::blas_data() const& -> const builtin_type*
    requires CompatibleBuiltin<T>
 {
    return data1D_.blas_data();
 }
 
 
-template <Builtin T, AlignmentFlag AF>
-STRICT_NODISCARD_CONSTEXPR_INLINE int ArrayBase2D<T, AF>::alignment() {
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_NODISCARD_CONSTEXPR_INLINE int ArrayBase2D<T, AF, LF>::alignment() {
    return ArrayBase1D<T, AF>::alignment();
 }
 
 
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_NODISCARD_CONSTEXPR std::pmr::memory_resource* ArrayBase2D<T, AF, LF>::resource() const {
+   return data1D_.resource();
+}
+
+
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_NODISCARD_CONSTEXPR_INLINE LayoutFlag ArrayBase2D<T, AF, LF>::layout() {
+   return LF;
+}
+
+
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_NODISCARD_CONSTEXPR auto ArrayBase2D<T, AF, LF>::storage() & -> ArrayBase1D<T, AF>& {
+   return data1D_;
+}
+
+
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_NODISCARD_CONSTEXPR auto ArrayBase2D<T, AF, LF>::storage() const&
+   -> const ArrayBase1D<T, AF>& {
+   return data1D_;
+}
+
+
+// Resizes the storage to n elements, which are uninitialized if added. Capacity is at least
+// doubled if it is exceeded, so that appending rows or columns one at a time takes amortized
+// constant time.
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR void ArrayBase2D<T, AF, LF>::grow_storage(index_t n) {
+   if(n > data1D_.capacity()) {
+      data1D_.reserve(maxs(2_sl * data1D_.capacity(), n));
+   }
+   data1D_.resize(n, uninitialized);
+}
+
+
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+STRICT_CONSTEXPR_INLINE index_t ArrayBase2D<T, AF, LF>::storage_index(index_t i, index_t j) const {
+   if constexpr(LF == RowMajor) {
+      return i * dims_.un(1) + j;
+   } else {
+      return j * dims_.un(0) + i;
+   }
+}
+
+
 } // namespace detail
 
 
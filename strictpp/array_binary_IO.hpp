@@ -0,0 +1,363 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include "ArrayCommon/array_traits.hpp"
+#include "ArrayCommon/layout.hpp"
+#include "StrictCommon/strict_common.hpp"
+#include "Util/profiler.hpp"
+#include "derived1D.hpp"
+#include "derived2D.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <string>
+
+
+// Binary format of arrays. The file consists of a 64-byte header followed by the elements in
+// storage order. Integers in the header are little-endian regardless of the platform.
+//
+// offset  size  field
+//      0     8  magic "SPPARRAY"
+//      8     4  version, currently 1
+//     12     1  kind of elements: 'b' bool, 'i' signed integer, 'u' unsigned integer,
+//               'f' float, double, or long double of the same size as double,
+//               'g' other long double, 'q' float128
+//     13     1  size of an element in bytes
+//     14     1  number of dimensions, 1 or 2
+//     15     1  layout, 0 for row-major and 1 for column-major
+//     16     1  byte order of elements, 1 for little-endian and 2 for big-endian
+//     24     8  number of rows(number of elements for one-dimensional arrays)
+//     32     8  number of columns(1 for one-dimensional arrays)
+//     40     8  checksum of the elements as stored in the file
+//
+// The remaining bytes are zero. The elements start at offset 64, so that they are aligned
+// when the file is memory-mapped. The checksum is the 64-bit FNV-1a hash computed over 8-byte
+// words of the elements(the final partial word is hashed byte by byte).
+namespace spp {
+
+
+// Expressions and slices are evaluated before they are written. Column-major arrays are written
+// in column-major order, all other two-dimensional objects in row-major order.
+template <BaseType Base>
+void save_binary(const std::string& file_path, const Base& A);
+
+
+// Elements stored in the opposite byte order are swapped. Elements stored in a different
+// layout than the one of A are reordered.
+template <Builtin T, AlignmentFlag AF>
+void load_binary(const std::string& file_path, Array1D<T, AF>& A);
+
+
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+void load_binary(const std::string& file_path, Array2D<T, AF, LF>& A);
+
+
+namespace detail {
+
+
+inline constexpr std::size_t binary_header_size = 64;
+inline constexpr std::uint32_t binary_version = 1;
+inline constexpr std::array<char, 8> binary_magic{'S', 'P', 'P', 'A', 'R', 'R', 'A', 'Y'};
+
+
+template <Builtin T>
+consteval char binary_kind() {
+   if constexpr(Boolean<T>) {
+      return 'b';
+   } else if constexpr(SignedInteger<T>) {
+      return 'i';
+   } else if constexpr(UnsignedInteger<T>) {
+      return 'u';
+   } else if constexpr(SameAs<T, float> || SameAs<T, double>) {
+      return 'f';
+   } else if constexpr(SameAs<T, long double>) {
+      // Long double of the same size as double is stored as double, as in <f8 of npy files.
+      return sizeof(long double) == sizeof(double) ? 'f' : 'g';
+   } else {
+      return 'q';
+   }
+}
+
+
+struct BinaryHeader {
+   char kind{};
+   std::uint8_t element_size{};
+   std::uint8_t dims{};
+   LayoutFlag layout{RowMajor};
+   bool little_endian{std::endian::native == std::endian::little};
+   long int rows{};
+   long int cols{};
+   std::uint64_t checksum{};
+
+   template <Builtin T>
+   bool has_type() const {
+      return kind == binary_kind<T>() && element_size == sizeof(T);
+   }
+
+   bool native_order() const {
+      return little_endian == (std::endian::native == std::endian::little);
+   }
+
+   // Sizes are not negative, and neither the number of elements nor the number of bytes
+   // overflows long int.
+   bool valid_sizes() const {
+      constexpr long int max = std::numeric_limits<long int>::max();
+      if(rows < 0 || cols < 0 || (cols != 0 && rows > max / cols)) {
+         return false;
+      }
+      return rows * cols <= max / std::max(long(element_size), 1L);
+   }
+
+   std::size_t bytes() const {
+      return static_cast<std::size_t>(rows) * static_cast<std::size_t>(cols) * element_size;
+   }
+};
+
+
+inline void store_le(unsigned char* p, std::uint64_t x, int n) {
+   for(int k = 0; k < n; ++k) {
+      p[k] = static_cast<unsigned char>(x >> (8 * k));
+   }
+}
+
+
+inline std::uint64_t load_le(const unsigned char* p, int n) {
+   std::uint64_t x = 0;
+   for(int k = 0; k < n; ++k) {
+      x |= std::uint64_t{p[k]} << (8 * k);
+   }
+   return x;
+}
+
+
+inline std::array<unsigned char, binary_header_size> encode_header(const BinaryHeader& h) {
+   std::array<unsigned char, binary_header_size> buf{};
+   std::memcpy(buf.data(), binary_magic.data(), binary_magic.size());
+   store_le(buf.data() + 8, binary_version, 4);
+   buf[12] = static_cast<unsigned char>(h.kind);
+   buf[13] = h.element_size;
+   buf[14] = h.dims;
+   buf[15] = h.layout == RowMajor ? 0 : 1;
+   buf[16] = h.little_endian ? 1 : 2;
+   store_le(buf.data() + 24, static_cast<std::uint64_t>(h.rows), 8);
+   store_le(buf.data() + 32, static_cast<std::uint64_t>(h.cols), 8);
+   store_le(buf.data() + 40, h.checksum, 8);
+   return buf;
+}
+
+
+inline BinaryHeader decode_header(const unsigned char* buf) {
+   ASSERT_STRICT_ALWAYS_MSG(std::equal(binary_magic.begin(), binary_magic.end(), buf),
+                            "Not a strictpp binary file.\n");
+   ASSERT_STRICT_ALWAYS_MSG(load_le(buf + 8, 4) == binary_version,
+                            "Unsupported version of strictpp binary file.\n");
+   ASSERT_STRICT_ALWAYS_MSG((buf[14] == 1 || buf[14] == 2) && buf[15] < 2
+                               && (buf[16] == 1 || buf[16] == 2),
+                            "Corrupted header of strictpp binary file.\n");
+
+   BinaryHeader h;
+   h.kind = static_cast<char>(buf[12]);
+   h.element_size = buf[13];
+   h.dims = buf[14];
+   h.layout = buf[15] == 0 ? RowMajor : ColMajor;
+   h.little_endian = buf[16] == 1;
+   h.rows = static_cast<long int>(load_le(buf + 24, 8));
+   h.cols = static_cast<long int>(load_le(buf + 32, 8));
+   h.checksum = load_le(buf + 40, 8);
+   ASSERT_STRICT_ALWAYS_MSG(h.valid_sizes(), "Corrupted header of strictpp binary file.\n");
+   return h;
+}
+
+
+// The checksum of consecutive blocks of data, all of which but the last have a multiple of 8
+// bytes, is computed by passing the checksum of the previous blocks as h.
+inline std::uint64_t binary_checksum(const void* data, std::size_t bytes,
+                                     std::uint64_t h = 14'695'981'039'346'656'037ULL) {
+   constexpr std::uint64_t prime = 1'099'511'628'211ULL;
+   const auto* p = static_cast<const unsigned char*>(data);
+   std::size_t i = 0;
+   for(; i + 8 <= bytes; i += 8) {
+      std::uint64_t w;
+      std::memcpy(&w, p + i, 8);
+      h = (h ^ w) * prime;
+   }
+   for(; i < bytes; ++i) {
+      h = (h ^ p[i]) * prime;
+   }
+   return h;
+}
+
+
+template <Builtin T>
+void swap_bytes(Strict<T>* data, long int n) {
+   if constexpr(sizeof(T) > 1) {
+      auto* p = reinterpret_cast<unsigned char*>(data);
+      for(long int i = 0; i < n; ++i) {
+         std::reverse(p + i * long(sizeof(T)), p + (i + 1) * long(sizeof(T)));
+      }
+   }
+}
+
+
+template <Builtin T>
+void write_binary(const std::string& file_path, BinaryHeader h, const Strict<T>* data) {
+   STRICT_PROFILE_SCOPE("io/write_binary");
+   h.checksum = binary_checksum(data, h.bytes());
+   const auto buf = encode_header(h);
+
+   std::ofstream ofs{file_path, std::ios::binary};
+   ASSERT_STRICT_ALWAYS_MSG(ofs, "Invalid file path.\n");
+   ofs.write(reinterpret_cast<const char*>(buf.data()), std::streamsize(buf.size()));
+   ofs.write(reinterpret_cast<const char*>(data), std::streamsize(h.bytes()));
+   ofs.close();
+   ASSERT_STRICT_ALWAYS_MSG(ofs, "Could not write binary file.\n");
+}
+
+
+inline BinaryHeader read_binary_header(std::ifstream& ifs) {
+   std::array<unsigned char, binary_header_size> buf{};
+   ifs.read(reinterpret_cast<char*>(buf.data()), std::streamsize(buf.size()));
+   ASSERT_STRICT_ALWAYS_MSG(ifs, "Not a strictpp binary file.\n");
+   return decode_header(buf.data());
+}
+
+
+// Elements must fit into the rest of the stream, which is checked before arrays are allocated for
+// them.
+inline void check_remaining(std::istream& is, const BinaryHeader& h) {
+   const auto pos = is.tellg();
+   is.seekg(0, std::ios::end);
+   const auto end = is.tellg();
+   is.seekg(pos);
+   ASSERT_STRICT_ALWAYS_MSG(is && pos >= 0 && end >= pos
+                               && h.bytes() <= static_cast<std::uint64_t>(end - pos),
+                            "File is truncated.\n");
+}
+
+
+template <Builtin T>
+void read_elements(std::istream& is, const BinaryHeader& h, Strict<T>* data) {
+   is.read(reinterpret_cast<char*>(data), std::streamsize(h.bytes()));
+   ASSERT_STRICT_ALWAYS_MSG(is, "File is truncated.\n");
+}
+
+
+template <Builtin T>
+void read_binary_data(std::ifstream& ifs, const BinaryHeader& h, Strict<T>* data) {
+   read_elements(ifs, h, data);
+   ASSERT_STRICT_ALWAYS_MSG(binary_checksum(data, h.bytes()) == h.checksum,
+                            "Checksum mismatch, binary file is corrupted.\n");
+   if(!h.native_order()) {
+      swap_bytes(data, h.rows * h.cols);
+   }
+}
+
+
+template <Builtin T>
+BinaryHeader open_binary(std::ifstream& ifs, const std::string& file_path, std::uint8_t dims) {
+   ifs.open(file_path, std::ios::binary);
+   ASSERT_STRICT_ALWAYS_MSG(ifs, "Invalid file path.\n");
+   auto h = read_binary_header(ifs);
+   ASSERT_STRICT_ALWAYS_MSG(h.has_type<T>(), "Type of elements of binary file does not match.\n");
+   ASSERT_STRICT_ALWAYS_MSG(h.dims == dims, "Dimension of binary file does not match.\n");
+   check_remaining(ifs, h);
+   return h;
+}
+
+
+// Calls write(h, data) with the sizes and the layout of A in h and the elements of A in storage
+// order. Expressions and slices are evaluated first. Column-major arrays are stored in
+// column-major order, all other two-dimensional objects in row-major order.
+template <BaseType Base, typename F>
+void save_elements(const Base& A, F write) {
+   using T = BuiltinTypeOf<Base>;
+   BinaryHeader h;
+   h.kind = binary_kind<T>();
+   h.element_size = sizeof(T);
+   if constexpr(OneDimBaseType<Base>) {
+      h.dims = 1;
+      h.rows = A.size().val();
+      h.cols = 1;
+   } else {
+      h.dims = 2;
+      h.rows = A.rows().val();
+      h.cols = A.cols().val();
+   }
+
+   if constexpr(ArrayType<Base>) {
+      h.layout = layout_of<Base>();
+      write(h, A.data());
+   } else if constexpr(OneDimBaseType<Base>) {
+      Array1D<T> tmp = A;
+      write(h, tmp.data());
+   } else {
+      Array2D<T> tmp = A;
+      write(h, tmp.data());
+   }
+}
+
+
+// Resizes A to the sizes in h and calls read(data) to read the elements stored in the layout
+// of h. Elements stored in a different layout than the one of A are reordered.
+template <Builtin T, AlignmentFlag AF, typename F>
+void load_elements(const BinaryHeader& h, Array1D<T, AF>& A, F read) {
+   A.resize(h.rows, uninitialized, false);
+   read(A.data());
+}
+
+
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF, typename F>
+void load_elements(const BinaryHeader& h, Array2D<T, AF, LF>& A, F read) {
+   if(h.layout == LF) {
+      A.resize(h.rows, h.cols, uninitialized, false);
+      read(A.data());
+   } else {
+      Array2D<T, AF, LF == RowMajor ? ColMajor : RowMajor> tmp(h.rows, h.cols, uninitialized);
+      read(tmp.data());
+      A.resize_and_assign(tmp);
+   }
+}
+
+
+} // namespace detail
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <BaseType Base>
+void save_binary(const std::string& file_path, const Base& A) {
+   using T = BuiltinTypeOf<Base>;
+   detail::save_elements(A, [&file_path](const detail::BinaryHeader& h, const Strict<T>* data) {
+      detail::write_binary<T>(file_path, h, data);
+   });
+}
+
+
+template <Builtin T, AlignmentFlag AF>
+void load_binary(const std::string& file_path, Array1D<T, AF>& A) {
+   STRICT_PROFILE_SCOPE("io/read_binary");
+   std::ifstream ifs;
+   const auto h = detail::open_binary<T>(ifs, file_path, 1);
+   detail::load_elements(h, A, [&](Strict<T>* data) { detail::read_binary_data(ifs, h, data); });
+}
+
+
+template <Builtin T, AlignmentFlag AF, LayoutFlag LF>
+void load_binary(const std::string& file_path, Array2D<T, AF, LF>& A) {
+   STRICT_PROFILE_SCOPE("io/read_binary");
+   std::ifstream ifs;
+   const auto h = detail::open_binary<T>(ifs, file_path, 2);
+   detail::load_elements(h, A, [&](Strict<T>* data) { detail::read_binary_data(ifs, h, data); });
+}
+
+
+} // namespace spp
@@ -0,0 +1,631 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include "ArrayCommon/array_traits.hpp"
+#include "ArrayCommon/layout.hpp"
+#include "StrictCommon/strict_common.hpp"
+#include "Util/profiler.hpp"
+#include "array_binary_IO.hpp"
+#include "derived1D.hpp"
+#include "derived2D.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+// NumPy .npy files and uncompressed .npz archives, see the description of the format in
+// numpy.lib.format. All builtin types except float128, which has no NumPy counterpart, are
+// supported: bool is stored as |b1, integers as <i4, <i8, <u4, <u8, and floating-point types
+// as <f4, <f8, and <f16(long double), with > instead of < on big-endian platforms. Files are
+// read only if the type of elements matches exactly, e.g. an <f4 file cannot be read into an
+// array of doubles. Files of either byte order and either C(row-major) or Fortran(column-major)
+// order are read. One-dimensional arrays have shape (n,) and two-dimensional arrays have
+// shape (m, n), NumPy arrays of other dimensions are not supported.
+//
+// Arrays are written with version 1.0 of the format and the header is padded so that the
+// elements start at a multiple of 64 bytes, which allows them to be memory-mapped(see
+// MappedArray). Archives are read by load_npz and written by NpzWriter. Only stored(i.e.
+// uncompressed) members are supported, such as the ones written by numpy.savez. Archives in
+// zip64 format are read, but archives written by NpzWriter must be smaller than 4 GB.
+namespace spp {
+
+
+template <BaseType Base>
+   requires NotQuadruple<BuiltinTypeOf<Base>>
+void save_npy(const std::string& file_path, const Base& A);
+
+
+template <NotQuadruple T, AlignmentFlag AF>
+void load_npy(const std::string& file_path, Array1D<T, AF>& A);
+
+
+template <NotQuadruple T, AlignmentFlag AF, LayoutFlag LF>
+void load_npy(const std::string& file_path, Array2D<T, AF, LF>& A);
+
+
+// Name is the key of the array in the archive, i.e. the name of the member without the .npy
+// extension. The CRC-32 of the member is verified.
+template <NotQuadruple T, AlignmentFlag AF>
+void load_npz(const std::string& file_path, const std::string& name, Array1D<T, AF>& A);
+
+
+template <NotQuadruple T, AlignmentFlag AF, LayoutFlag LF>
+void load_npz(const std::string& file_path, const std::string& name, Array2D<T, AF, LF>& A);
+
+
+// Keys of the arrays in the archive, in the order in which they are stored.
+inline std::vector<std::string> npz_names(const std::string& file_path);
+
+
+namespace detail {
+
+
+// Tables of the slicing-by-8 algorithm of CRC-32 used by zip archives.
+inline constexpr auto crc32_tables = [] {
+   std::array<std::array<std::uint32_t, 256>, 8> t{};
+   for(std::uint32_t i = 0; i < 256; ++i) {
+      std::uint32_t c = i;
+      for(int k = 0; k < 8; ++k) {
+         c = (c & 1) != 0 ? 0xEDB8'8320U ^ (c >> 1) : c >> 1;
+      }
+      t[0][i] = c;
+   }
+   for(std::size_t i = 0; i < 256; ++i) {
+      for(std::size_t k = 1; k < 8; ++k) {
+         t[k][i] = (t[k - 1][i] >> 8) ^ t[0][t[k - 1][i] & 0xFF];
+      }
+   }
+   return t;
+}();
+
+
+// CRC-32 of the bytes appended to the bytes whose CRC-32 is crc(0 for no bytes).
+inline std::uint32_t crc32(std::uint32_t crc, const void* data, std::size_t bytes) {
+   const auto& t = crc32_tables;
+   const auto* p = static_cast<const unsigned char*>(data);
+   crc = ~crc;
+   std::size_t i = 0;
+   for(; i + 8 <= bytes; i += 8) {
+      const auto lo = crc ^ std::uint32_t(load_le(p + i, 4));
+      const auto hi = std::uint32_t(load_le(p + i + 4, 4));
+      crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24]
+          ^ t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+   }
+   for(; i < bytes; ++i) {
+      crc = t[0][(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+   }
+   return ~crc;
+}
+
+
+inline constexpr std::array<char, 6> npy_magic{'\x93', 'N', 'U', 'M', 'P', 'Y'};
+
+
+template <NotQuadruple T>
+std::string npy_descr() {
+   std::string descr;
+   if constexpr(sizeof(T) == 1) {
+      descr += '|';
+   } else {
+      descr += std::endian::native == std::endian::little ? '<' : '>';
+   }
+
+   if constexpr(Boolean<T>) {
+      descr += 'b';
+   } else if constexpr(SignedInteger<T>) {
+      descr += 'i';
+   } else if constexpr(UnsignedInteger<T>) {
+      descr += 'u';
+   } else {
+      descr += 'f';
+   }
+   return descr + std::to_string(sizeof(T));
+}
+
+
+// Magic string, version, length of the header, and the header itself, which is padded by
+// spaces and terminated by a newline.
+template <NotQuadruple T>
+std::string encode_npy_header(const BinaryHeader& h) {
+   std::string dict = "{'descr': '" + npy_descr<T>() + "', 'fortran_order': ";
+   dict += h.dims == 2 && h.layout == ColMajor ? "True" : "False";
+   dict += ", 'shape': (" + std::to_string(h.rows);
+   dict += h.dims == 1 ? ",), }" : ", " + std::to_string(h.cols) + "), }";
+
+   constexpr std::size_t prefix_size = 10;
+   const std::size_t size = (prefix_size + dict.size() + 1 + 63) / 64 * 64;
+   dict.append(size - prefix_size - dict.size() - 1, ' ');
+   dict += '\n';
+
+   std::string s(npy_magic.begin(), npy_magic.end());
+   s += '\x01';
+   s += '\x00';
+   s += static_cast<char>(dict.size() & 0xFF);
+   s += static_cast<char>(dict.size() >> 8);
+   return s + dict;
+}
+
+
+// Size of the preamble(everything before the elements) given its first 12 bytes.
+inline std::size_t npy_preamble_size(const unsigned char* p) {
+   ASSERT_STRICT_ALWAYS_MSG(std::memcmp(p, npy_magic.data(), npy_magic.size()) == 0,
+                            "Not an npy file.\n");
+   ASSERT_STRICT_ALWAYS_MSG(p[6] >= 1 && p[6] <= 3, "Unsupported version of npy file.\n");
+   return p[6] == 1 ? 10 + load_le(p + 8, 2) : 12 + load_le(p + 8, 4);
+}
+
+
+// Value of the key in the header, followed by the rest of the header.
+inline std::string_view npy_value(std::string_view dict, std::string_view key) {
+   for(char quote : {'\'', '"'}) {
+      const auto k = quote + std::string{key} + quote;
+      if(auto pos = dict.find(k); pos != std::string_view::npos) {
+         dict.remove_prefix(pos + k.size());
+         dict.remove_prefix(std::min(dict.find_first_not_of(" :"), dict.size()));
+         return dict;
+      }
+   }
+   ASSERT_STRICT_ALWAYS_MSG(false, "Corrupted header of npy file.\n");
+   return {};
+}
+
+
+inline long int npy_integer(std::string_view& s) {
+   s.remove_prefix(std::min(s.find_first_not_of(' '), s.size()));
+   long int x{};
+   auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), x);
+   ASSERT_STRICT_ALWAYS_MSG(ec == std::errc{} && x >= 0, "Corrupted header of npy file.\n");
+   s.remove_prefix(std::size_t(ptr - s.data()));
+   // Python 2 suffix of long integers.
+   if(!s.empty() && s.front() == 'L') {
+      s.remove_prefix(1);
+   }
+   return x;
+}
+
+
+// The kind of elements is translated to the one of binary files, see array_binary_IO.hpp.
+inline BinaryHeader decode_npy_header(std::string_view s) {
+   const std::string_view dict = s.substr(s[6] == 1 ? 10 : 12);
+   BinaryHeader h;
+
+   auto descr = npy_value(dict, "descr");
+   ASSERT_STRICT_ALWAYS_MSG(descr.size() > 4 && (descr[0] == '\'' || descr[0] == '"'),
+                            "Only npy files of builtin types are supported.\n");
+   const char order = descr[1];
+   ASSERT_STRICT_ALWAYS_MSG(order == '<' || order == '>' || order == '|' || order == '=',
+                            "Corrupted header of npy file.\n");
+   h.little_endian = order == '<' || (order != '>' && std::endian::native == std::endian::little);
+   h.kind = descr[2];
+   descr.remove_prefix(3);
+   const long int element_size = npy_integer(descr);
+   h.element_size = element_size < 256 ? std::uint8_t(element_size) : 0;
+   if(h.kind == 'f' && element_size == long(sizeof(long double))
+      && sizeof(long double) != sizeof(double)) {
+      h.kind = 'g';
+   }
+
+   const auto fortran_order = npy_value(dict, "fortran_order");
+   ASSERT_STRICT_ALWAYS_MSG(fortran_order.starts_with("True") || fortran_order.starts_with("False"),
+                            "Corrupted header of npy file.\n");
+
+   auto shape = npy_value(dict, "shape");
+   ASSERT_STRICT_ALWAYS_MSG(!shape.empty() && shape.front() == '(',
+                            "Corrupted header of npy file.\n");
+   shape.remove_prefix(1);
+   std::vector<long int> sizes;
+   while(true) {
+      shape.remove_prefix(std::min(shape.find_first_not_of(" ,"), shape.size()));
+      ASSERT_STRICT_ALWAYS_MSG(!shape.empty(), "Corrupted header of npy file.\n");
+      if(shape.front() == ')') {
+         break;
+      }
+      sizes.push_back(npy_integer(shape));
+   }
+   ASSERT_STRICT_ALWAYS_MSG(sizes.size() == 1 || sizes.size() == 2,
+                            "Only one- and two-dimensional npy arrays are supported.\n");
+
+   h.dims = std::uint8_t(sizes.size());
+   h.rows = sizes[0];
+   h.cols = h.dims == 2 ? sizes[1] : 1;
+   h.layout = h.dims == 2 && fortran_order.starts_with("True") ? ColMajor : RowMajor;
+   ASSERT_STRICT_ALWAYS_MSG(h.valid_sizes(), "Corrupted header of npy file.\n");
+   return h;
+}
+
+
+inline std::string read_npy_preamble(std::istream& is) {
+   std::string s(12, '\0');
+   is.read(s.data(), 12);
+   ASSERT_STRICT_ALWAYS_MSG(is, "Not an npy file.\n");
+   const auto size = npy_preamble_size(reinterpret_cast<const unsigned char*>(s.data()));
+   ASSERT_STRICT_ALWAYS_MSG(size >= 12, "Corrupted header of npy file.\n");
+   s.resize(size);
+   is.read(s.data() + 12, std::streamsize(size - 12));
+   ASSERT_STRICT_ALWAYS_MSG(is, "File is truncated.\n");
+   return s;
+}
+
+
+template <NotQuadruple T>
+void write_npy(std::ostream& os, const std::string& preamble, const BinaryHeader& h,
+               const Strict<T>* data) {
+   os.write(preamble.data(), std::streamsize(preamble.size()));
+   os.write(reinterpret_cast<const char*>(data), std::streamsize(h.bytes()));
+}
+
+
+// Reads .npy data at the current position of the stream. If crc is not null, it is set to the
+// CRC-32 of the bytes that were read.
+template <typename ArrayType>
+void read_npy(std::istream& is, ArrayType& A, std::uint32_t* crc = nullptr) {
+   using T = BuiltinTypeOf<ArrayType>;
+   const auto preamble = read_npy_preamble(is);
+   auto h = decode_npy_header(preamble);
+   ASSERT_STRICT_ALWAYS_MSG(h.has_type<T>(), "Type of elements of npy file does not match.\n");
+   ASSERT_STRICT_ALWAYS_MSG(h.dims == (OneDimBaseType<ArrayType> ? 1 : 2),
+                            "Dimension of npy file does not match.\n");
+   check_remaining(is, h);
+
+   load_elements(h, A, [&](Strict<T>* data) {
+      read_elements(is, h, data);
+      if(crc != nullptr) {
+         *crc = crc32(crc32(0, preamble.data(), preamble.size()), data, h.bytes());
+      }
+      if(!h.native_order()) {
+         swap_bytes(data, h.rows * h.cols);
+      }
+   });
+}
+
+
+inline constexpr std::uint32_t zip_local_signature = 0x0403'4B50;
+inline constexpr std::uint32_t zip_central_signature = 0x0201'4B50;
+inline constexpr std::uint32_t zip_end_signature = 0x0605'4B50;
+inline constexpr std::uint32_t zip64_end_signature = 0x0606'4B50;
+inline constexpr std::uint32_t zip64_locator_signature = 0x0706'4B50;
+inline constexpr std::uint64_t zip_max_size = 0xFFFF'FFFF;
+
+
+struct ZipEntry {
+   std::string name;
+   std::uint16_t method{};
+   std::uint32_t crc{};
+   std::uint64_t compressed_size{};
+   std::uint64_t size{};
+   std::uint64_t local_offset{};
+};
+
+
+inline void append_le(std::string& s, std::uint64_t x, int n) {
+   for(int k = 0; k < n; ++k) {
+      s += static_cast<char>(x >> (8 * k));
+   }
+}
+
+
+// Reads the central directory of a zip archive of the given size. read_at(offset, n) returns
+// n bytes of the archive starting at the offset.
+template <typename F>
+std::vector<ZipEntry> read_zip_directory(std::uint64_t file_size, F read_at) {
+   // The end of central directory record is 22 bytes followed by a comment of up to 65535 bytes.
+   ASSERT_STRICT_ALWAYS_MSG(file_size >= 22, "Not an npz file.\n");
+   const std::uint64_t tail_size = std::min<std::uint64_t>(file_size, 22 + 65'535);
+   const auto tail = read_at(file_size - tail_size, tail_size);
+   long int pos = long(tail_size) - 22;
+   while(pos >= 0 && load_le(tail.data() + pos, 4) != zip_end_signature) {
+      --pos;
+   }
+   ASSERT_STRICT_ALWAYS_MSG(pos >= 0, "Not an npz file.\n");
+
+   const unsigned char* end = tail.data() + pos;
+   std::uint64_t count = load_le(end + 10, 2);
+   std::uint64_t directory_size = load_le(end + 12, 4);
+   std::uint64_t directory_offset = load_le(end + 16, 4);
+   if(count == 0xFFFF || directory_size == zip_max_size || directory_offset == zip_max_size) {
+      ASSERT_STRICT_ALWAYS_MSG(pos >= 20 && load_le(end - 20, 4) == zip64_locator_signature,
+                               "Corrupted npz file.\n");
+      const auto record = read_at(load_le(end - 20 + 8, 8), 56);
+      ASSERT_STRICT_ALWAYS_MSG(load_le(record.data(), 4) == zip64_end_signature,
+                               "Corrupted npz file.\n");
+      count = load_le(record.data() + 32, 8);
+      directory_size = load_le(record.data() + 40, 8);
+      directory_offset = load_le(record.data() + 48, 8);
+   }
+   ASSERT_STRICT_ALWAYS_MSG(directory_offset <= file_size
+                               && directory_size <= file_size - directory_offset,
+                            "Corrupted npz file.\n");
+
+   const auto directory = read_at(directory_offset, directory_size);
+   std::vector<ZipEntry> entries;
+   std::size_t p = 0;
+   for(std::uint64_t i = 0; i < count; ++i) {
+      ASSERT_STRICT_ALWAYS_MSG(p + 46 <= directory.size()
+                                  && load_le(directory.data() + p, 4) == zip_central_signature,
+                               "Corrupted npz file.\n");
+      const unsigned char* c = directory.data() + p;
+      const std::size_t name_size = load_le(c + 28, 2);
+      const std::size_t extra_size = load_le(c + 30, 2);
+      const std::size_t record_size = 46 + name_size + extra_size + load_le(c + 32, 2);
+      ASSERT_STRICT_ALWAYS_MSG(p + record_size <= directory.size(), "Corrupted npz file.\n");
+
+      ZipEntry e;
+      e.name.assign(reinterpret_cast<const char*>(c + 46), name_size);
+      e.method = std::uint16_t(load_le(c + 10, 2));
+      e.crc = std::uint32_t(load_le(c + 16, 4));
+      e.compressed_size = load_le(c + 20, 4);
+      e.size = load_le(c + 24, 4);
+      e.local_offset = load_le(c + 42, 4);
+
+      // Sizes and offsets that do not fit in 32 bits are stored in the zip64 extra field.
+      const unsigned char* x = c + 46 + name_size;
+      const unsigned char* extra_end = x + extra_size;
+      while(x + 4 <= extra_end) {
+         const std::size_t field_size = load_le(x + 2, 2);
+         const unsigned char* field_end = std::min(x + 4 + field_size, extra_end);
+         if(load_le(x, 2) == 0x0001) {
+            const unsigned char* f = x + 4;
+            for(auto* v : {&e.size, &e.compressed_size, &e.local_offset}) {
+               if(*v == zip_max_size && f + 8 <= field_end) {
+                  *v = load_le(f, 8);
+                  f += 8;
+               }
+            }
+         }
+         x = field_end;
+      }
+
+      entries.push_back(std::move(e));
+      p += record_size;
+   }
+   return entries;
+}
+
+
+template <typename F>
+std::uint64_t zip_data_offset(const ZipEntry& e, F read_at) {
+   const auto local = read_at(e.local_offset, 30);
+   ASSERT_STRICT_ALWAYS_MSG(load_le(local.data(), 4) == zip_local_signature,
+                            "Corrupted npz file.\n");
+   return e.local_offset + 30 + load_le(local.data() + 26, 2) + load_le(local.data() + 28, 2);
+}
+
+
+inline const ZipEntry& find_npz_member(const std::vector<ZipEntry>& entries,
+                                       const std::string& name) {
+   auto it = std::find_if(entries.begin(), entries.end(), [&name](const ZipEntry& e) {
+      return e.name == name + ".npy" || e.name == name;
+   });
+   ASSERT_STRICT_ALWAYS_MSG(it != entries.end(), "No array of the given name in npz file.\n");
+   ASSERT_STRICT_ALWAYS_MSG(it->method == 0, "Compressed npz files are not supported.\n");
+   return *it;
+}
+
+
+inline auto stream_reader(std::ifstream& ifs) {
+   return [&ifs](std::uint64_t offset, std::uint64_t n) {
+      std::vector<unsigned char> buf(n);
+      ifs.seekg(std::streamoff(offset));
+      ifs.read(reinterpret_cast<char*>(buf.data()), std::streamsize(n));
+      ASSERT_STRICT_ALWAYS_MSG(ifs, "Corrupted npz file.\n");
+      return buf;
+   };
+}
+
+
+inline std::vector<ZipEntry> open_npz(std::ifstream& ifs, const std::string& file_path) {
+   ifs.open(file_path, std::ios::binary | std::ios::ate);
+   ASSERT_STRICT_ALWAYS_MSG(ifs, "Invalid file path.\n");
+   const auto file_size = std::uint64_t(ifs.tellg());
+   return read_zip_directory(file_size, stream_reader(ifs));
+}
+
+
+template <typename ArrayType>
+void read_npz(const std::string& file_path, const std::string& name, ArrayType& A) {
+   std::ifstream ifs;
+   const auto entries = open_npz(ifs, file_path);
+   const auto& e = find_npz_member(entries, name);
+   ifs.seekg(std::streamoff(zip_data_offset(e, stream_reader(ifs))));
+   std::uint32_t crc{};
+   read_npy(ifs, A, &crc);
+   ASSERT_STRICT_ALWAYS_MSG(crc == e.crc, "Checksum mismatch, npz file is corrupted.\n");
+}
+
+
+} // namespace detail
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Expressions and slices are evaluated before they are written. Column-major arrays are written
+// in Fortran order, all other two-dimensional objects in C order.
+template <BaseType Base>
+   requires NotQuadruple<BuiltinTypeOf<Base>>
+void save_npy(const std::string& file_path, const Base& A) {
+   STRICT_PROFILE_SCOPE("io/write_npy");
+   using T = BuiltinTypeOf<Base>;
+   detail::save_elements(A, [&file_path](const detail::BinaryHeader& h, const Strict<T>* data) {
+      std::ofstream ofs{file_path, std::ios::binary};
+      ASSERT_STRICT_ALWAYS_MSG(ofs, "Invalid file path.\n");
+      detail::write_npy<T>(ofs, detail::encode_npy_header<T>(h), h, data);
+      ofs.close();
+      ASSERT_STRICT_ALWAYS_MSG(ofs, "Could not write npy file.\n");
+   });
+}
+
+
+template <NotQuadruple T, AlignmentFlag AF>
+void load_npy(const std::string& file_path, Array1D<T, AF>& A) {
+   STRICT_PROFILE_SCOPE("io/read_npy");
+   std::ifstream ifs{file_path, std::ios::binary};
+   ASSERT_STRICT_ALWAYS_MSG(ifs, "Invalid file path.\n");
+   detail::read_npy(ifs, A);
+}
+
+
+template <NotQuadruple T, AlignmentFlag AF, LayoutFlag LF>
+void load_npy(const std::string& file_path, Array2D<T, AF, LF>& A) {
+   STRICT_PROFILE_SCOPE("io/read_npy");
+   std::ifstream ifs{file_path, std::ios::binary};
+   ASSERT_STRICT_ALWAYS_MSG(ifs, "Invalid file path.\n");
+   detail::read_npy(ifs, A);
+}
+
+
+template <NotQuadruple T, AlignmentFlag AF>
+void load_npz(const std::string& file_path, const std::string& name, Array1D<T, AF>& A) {
+   STRICT_PROFILE_SCOPE("io/read_npz");
+   detail::read_npz(file_path, name, A);
+}
+
+
+template <NotQuadruple T, AlignmentFlag AF, LayoutFlag LF>
+void load_npz(const std::string& file_path, const std::string& name, Array2D<T, AF, LF>& A) {
+   STRICT_PROFILE_SCOPE("io/read_npz");
+   detail::read_npz(file_path, name, A);
+}
+
+
+inline std::vector<std::string> npz_names(const std::string& file_path) {
+   std::ifstream ifs;
+   std::vector<std::string> names;
+   for(const auto& e : detail::open_npz(ifs, file_path)) {
+      names.push_back(e.name.ends_with(".npy") ? e.name.substr(0, e.name.size() - 4) : e.name);
+   }
+   return names;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Writes arrays into an uncompressed .npz archive, which can be read by numpy.load, e.g.
+//
+// NpzWriter npz{"data.npz"};
+// npz.add("x", x);
+// npz.add("A", A);
+// npz.close();
+//
+// The archive is complete only after close() is called, which is also done by the destructor,
+// but errors are then ignored. Elements of each array start at a multiple of 64 bytes, so that
+// they can be memory-mapped.
+class STRICT_NODISCARD NpzWriter {
+public:
+   explicit NpzWriter(const std::string& file_path) : ofs_{file_path, std::ios::binary} {
+      ASSERT_STRICT_ALWAYS_MSG(ofs_, "Invalid file path.\n");
+   }
+
+   NpzWriter(const NpzWriter&) = delete;
+   NpzWriter& operator=(const NpzWriter&) = delete;
+
+   ~NpzWriter() {
+      try {
+         this->close();
+      } catch(...) {
+      }
+   }
+
+   template <BaseType Base>
+      requires NotQuadruple<BuiltinTypeOf<Base>>
+   void add(const std::string& name, const Base& A) {
+      STRICT_PROFILE_SCOPE("io/write_npz");
+      using T = BuiltinTypeOf<Base>;
+      ASSERT_STRICT_ALWAYS_MSG(ofs_.is_open(), "npz file is closed.\n");
+      ASSERT_STRICT_ALWAYS_MSG(entries_.size() < 0xFFFF, "Too many arrays in npz file.\n");
+
+      detail::save_elements(A, [&](const detail::BinaryHeader& h, const Strict<T>* data) {
+         const auto preamble = detail::encode_npy_header<T>(h);
+         detail::ZipEntry e;
+         e.name = name + ".npy";
+         e.crc = detail::crc32(detail::crc32(0, preamble.data(), preamble.size()), data,
+                               h.bytes());
+         e.size = e.compressed_size = preamble.size() + h.bytes();
+         e.local_offset = std::uint64_t(ofs_.tellp());
+         // The extra field pads the local header, so that the elements are aligned when the
+         // archive is memory-mapped(the same field is used by zipalign of Android).
+         const std::uint64_t header_end = e.local_offset + 30 + e.name.size() + 6;
+         const std::uint64_t padding = (64 - header_end % 64) % 64;
+         ASSERT_STRICT_ALWAYS_MSG(header_end + padding + e.size < detail::zip_max_size,
+                                  "npz files of 4 GB or larger are not supported.\n");
+
+         std::string local;
+         detail::append_le(local, detail::zip_local_signature, 4);
+         append_common(local, e, 6 + padding);
+         local += e.name;
+         detail::append_le(local, 0xD935, 2);
+         detail::append_le(local, 2 + padding, 2);
+         detail::append_le(local, 64, 2);
+         local.append(padding, '\0');
+         ofs_.write(local.data(), std::streamsize(local.size()));
+         detail::write_npy<T>(ofs_, preamble, h, data);
+         ASSERT_STRICT_ALWAYS_MSG(ofs_, "Could not write npz file.\n");
+         entries_.push_back(std::move(e));
+      });
+   }
+
+   void close() {
+      if(!ofs_.is_open()) {
+         return;
+      }
+
+      std::string directory;
+      for(const auto& e : entries_) {
+         detail::append_le(directory, detail::zip_central_signature, 4);
+         detail::append_le(directory, 20, 2);
+         append_common(directory, e, 0);
+         // Comment length, disk number, internal and external attributes.
+         detail::append_le(directory, 0, 10);
+         detail::append_le(directory, e.local_offset, 4);
+         directory += e.name;
+      }
+      const auto directory_offset = std::uint64_t(ofs_.tellp());
+
+      std::string end;
+      detail::append_le(end, detail::zip_end_signature, 4);
+      detail::append_le(end, 0, 4);
+      detail::append_le(end, entries_.size(), 2);
+      detail::append_le(end, entries_.size(), 2);
+      detail::append_le(end, directory.size(), 4);
+      detail::append_le(end, directory_offset, 4);
+      detail::append_le(end, 0, 2);
+
+      ofs_.write(directory.data(), std::streamsize(directory.size()));
+      ofs_.write(end.data(), std::streamsize(end.size()));
+      ofs_.close();
+      ASSERT_STRICT_ALWAYS_MSG(ofs_, "Could not write npz file.\n");
+   }
+
+private:
+   std::ofstream ofs_;
+   std::vector<detail::ZipEntry> entries_;
+
+   // Fields shared by local and central headers, from the version needed to extract to the
+   // length of the extra field. Members are stored without compression and dated 1980-01-01.
+   static void append_common(std::string& s, const detail::ZipEntry& e, std::uint64_t extra_size) {
+      detail::append_le(s, 20, 2);
+      detail::append_le(s, 0, 2);
+      detail::append_le(s, 0, 2);
+      detail::append_le(s, 0, 2);
+      detail::append_le(s, 0x21, 2);
+      detail::append_le(s, e.crc, 4);
+      detail::append_le(s, e.compressed_size, 4);
+      detail::append_le(s, e.size, 4);
+      detail::append_le(s, e.name.size(), 2);
+      detail::append_le(s, extra_size, 2);
+   }
+};
+
+
+} // namespace spp
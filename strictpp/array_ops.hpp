@@ -6,15 +6,24 @@
 
 #include "ArrayCommon/array_auxiliary.hpp"
 #include "ArrayCommon/array_traits.hpp"
+#include "ArrayCommon/binned_sum.hpp"
+#include "ArrayCommon/packet.hpp"
+#include "ArrayCommon/packet_math.hpp"
+#include "ArrayCommon/parallel.hpp"
 #include "Expr/expr.hpp"
 #include "StrictCommon/strict_common.hpp"
+#include "Util/profiler.hpp"
 
 #include <algorithm>
+#include <array>
 #include <concepts>
+#include <cstddef>
+#include <cstring>
 #include <iterator>
 #include <memory>
 #include <random>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -43,13 +52,31 @@ template <typename Base, typename F> concept SortableArgs =
    SameAs<StrictBool, std::invoke_result_t<F, ValueTypeOf<Base>, ValueTypeOf<Base>>>;
 
 
+// Expressions that generate random values are always reduced serially.
+template <BaseType Base>
+STRICT_CONSTEXPR bool use_parallel_reduction(const Base& A) {
+   if constexpr(std::is_copy_constructible_v<Base>) {
+      return !std::is_constant_evaluated() && use_parallel_reduction(A.size());
+   } else {
+      return false;
+   }
+}
+
+
 } // namespace detail
 
 
+// Functions below that add terms use the default flag of spp::execution, see sum_flag.hpp.
 template <RealBaseType Base>
 STRICT_CONSTEXPR ValueTypeOf<Base> sum(const Base& A, ValueTypeOf<Base> empty_default = {});
 
 
+// Same as above, terms are added as selected by sf.
+template <RealBaseType Base>
+STRICT_CONSTEXPR ValueTypeOf<Base> sum(const Base& A, SumFlag sf,
+                                       ValueTypeOf<Base> empty_default = {});
+
+
 template <RealBaseType Base>
 STRICT_CONSTEXPR ValueTypeOf<Base> prod(const Base& A, ValueTypeOf<Base> empty_default = {});
 
@@ -58,6 +85,11 @@ template <FloatingBaseType Base>
 STRICT_CONSTEXPR ValueTypeOf<Base> mean(const Base& A, ValueTypeOf<Base> empty_default = {});
 
 
+template <FloatingBaseType Base>
+STRICT_CONSTEXPR ValueTypeOf<Base> mean(const Base& A, SumFlag sf,
+                                        ValueTypeOf<Base> empty_default = {});
+
+
 template <RealBaseType Base>
 STRICT_CONSTEXPR ValueTypeOf<Base> min(const Base& A, ValueTypeOf<Base> empty_default = {});
 
@@ -106,6 +138,12 @@ STRICT_CONSTEXPR ValueTypeOf<Base1> dot_prod(const Base1& A1, const Base2& A2,
                                              ValueTypeOf<Base1> empty_default = {});
 
 
+template <RealBaseType Base1, RealBaseType Base2>
+   requires(same_dimension_b<Base1, Base2>())
+STRICT_CONSTEXPR ValueTypeOf<Base1> dot_prod(const Base1& A1, const Base2& A2, SumFlag sf,
+                                             ValueTypeOf<Base1> empty_default = {});
+
+
 template <FloatingBaseType Base>
 STRICT_CONSTEXPR ValueTypeOf<Base> norm_inf(const Base& A, ValueTypeOf<Base> empty_default = {});
 
@@ -114,30 +152,60 @@ template <FloatingBaseType Base>
 STRICT_CONSTEXPR ValueTypeOf<Base> norm1(const Base& A, ValueTypeOf<Base> empty_default = {});
 
 
+template <FloatingBaseType Base>
+STRICT_CONSTEXPR ValueTypeOf<Base> norm1(const Base& A, SumFlag sf,
+                                         ValueTypeOf<Base> empty_default = {});
+
+
 template <FloatingBaseType Base>
 STRICT_CONSTEXPR ValueTypeOf<Base> norm1_scaled(const Base& A,
                                                 ValueTypeOf<Base> empty_default = {});
 
 
+template <FloatingBaseType Base>
+STRICT_CONSTEXPR ValueTypeOf<Base> norm1_scaled(const Base& A, SumFlag sf,
+                                                ValueTypeOf<Base> empty_default = {});
+
+
 template <FloatingBaseType Base>
 STRICT_CONSTEXPR_2026 ValueTypeOf<Base> norm2(const Base& A, ValueTypeOf<Base> empty_default = {});
 
 
+template <FloatingBaseType Base>
+STRICT_CONSTEXPR_2026 ValueTypeOf<Base> norm2(const Base& A, SumFlag sf,
+                                              ValueTypeOf<Base> empty_default = {});
+
+
 template <FloatingBaseType Base>
 STRICT_CONSTEXPR_2026 ValueTypeOf<Base> norm2_scaled(const Base& A,
                                                      ValueTypeOf<Base> empty_default = {});
 
 
+template <FloatingBaseType Base>
+STRICT_CONSTEXPR_2026 ValueTypeOf<Base> norm2_scaled(const Base& A, SumFlag sf,
+                                                     ValueTypeOf<Base> empty_default = {});
+
+
 template <FloatingBaseType Base>
 STRICT_CONSTEXPR_2026 ValueTypeOf<Base> norm_lp(const Base& A, ImplicitInt lp,
                                                 ValueTypeOf<Base> empty_default = {});
 
 
+template <FloatingBaseType Base>
+STRICT_CONSTEXPR_2026 ValueTypeOf<Base> norm_lp(const Base& A, ImplicitInt lp, SumFlag sf,
+                                                ValueTypeOf<Base> empty_default = {});
+
+
 template <FloatingBaseType Base>
 STRICT_CONSTEXPR_2026 ValueTypeOf<Base> norm_lp_scaled(const Base& A, ImplicitInt lp,
                                                        ValueTypeOf<Base> empty_default = {});
 
 
+template <FloatingBaseType Base>
+STRICT_CONSTEXPR_2026 ValueTypeOf<Base> norm_lp_scaled(const Base& A, ImplicitInt lp, SumFlag sf,
+                                                       ValueTypeOf<Base> empty_default = {});
+
+
 template <OneDimRealBaseType Base>
 STRICT_CONSTEXPR ValueTypeOf<Base> polynomial(const Base& coeffs, ValueTypeOf<Base> x,
                                               ValueTypeOf<Base> empty_default = {});
@@ -149,12 +217,24 @@ STRICT_CONSTEXPR_2026 ValueTypeOf<Base1> polynomial(const Base1& coeffs, ValueTy
                                                     ValueTypeOf<Base1> empty_default = {});
 
 
+template <OneDimRealBaseType Base1, OneDimSignedIntegerBaseType Base2>
+STRICT_CONSTEXPR_2026 ValueTypeOf<Base1> polynomial(const Base1& coeffs, ValueTypeOf<Base1> x,
+                                                    const Base2& powers, SumFlag sf,
+                                                    ValueTypeOf<Base1> empty_default = {});
+
+
 template <OneDimRealBaseType Base1, OneDimRealBaseType Base2, OneDimSignedIntegerBaseType Base3>
 STRICT_CONSTEXPR_2026 ValueTypeOf<Base1> gpolynomial(const Base1& coeffs, const Base2& X,
                                                      const Base3& powers,
                                                      ValueTypeOf<Base1> empty_default = {});
 
 
+template <OneDimRealBaseType Base1, OneDimRealBaseType Base2, OneDimSignedIntegerBaseType Base3>
+STRICT_CONSTEXPR_2026 ValueTypeOf<Base1> gpolynomial(const Base1& coeffs, const Base2& X,
+                                                     const Base3& powers, SumFlag sf,
+                                                     ValueTypeOf<Base1> empty_default = {});
+
+
 template <RealBaseType Base>
 STRICT_CONSTEXPR StrictBool has_zero(const Base& A, StrictBool empty_default = false_sb);
 
@@ -310,64 +390,424 @@ template <typename Base>
 void shuffle(Base&& A);
 
 
+// Only applies to square arrays.
+template <typename Base>
+   requires(detail::TwoDimNonConstBaseType<RemoveRef<Base>> && !detail::ArrayTypeRvalue<Base>)
+STRICT_CONSTEXPR void transpose_in_place(Base&& A);
+
+
+namespace detail {
+
+
+template <RealBaseType Base>
+STRICT_CONSTEXPR ValueTypeOf<Base> sum(const Base& A, index_t first, index_t last) {
+   ValueTypeOf<Base> s = A.un(first);
+   for(index_t i = first + 1_sl; i < last; ++i) {
+      s += A.un(i);
+   }
+   return s;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Pairwise summation, see sum_flag.hpp. Level k of the cascade holds the sum of 2^k consecutive
+// blocks, hence sums of blocks are added in the same order as by parallel_reduce if the blocks
+// of both are aligned.
+template <Floating T>
+class PairwiseCascade {
+public:
+   STRICT_CONSTEXPR void add(Strict<T> s) {
+      std::size_t k = 0;
+      for(unsigned long int j = count_++; j & 1; j >>= 1, ++k) {
+         s = levels_[k] + s;
+      }
+      levels_[k] = s;
+   }
+
+   // Requires at least one sum.
+   STRICT_CONSTEXPR Strict<T> result() const {
+      Strict<T> r{};
+      bool empty = true;
+      for(std::size_t k = 0; k < levels_.size(); ++k) {
+         if((count_ >> k) & 1) {
+            r = empty ? levels_[k] : levels_[k] + r;
+            empty = false;
+         }
+      }
+      return r;
+   }
+
+private:
+   std::array<Strict<T>, 64> levels_{};
+   unsigned long int count_ = 0;
+};
+
+
+// block_sum(i, j) returns the sum of terms i, ..., j - 1. first must be a multiple of block.
+template <Floating T, typename F>
+STRICT_CONSTEXPR Strict<T> pairwise_sum(index_t first, index_t last, index_t block, F block_sum) {
+   PairwiseCascade<T> cascade;
+   for(index_t i = first; i < last; i += block) {
+      cascade.add(block_sum(i, mins(i + block, last)));
+   }
+   return cascade.result();
+}
+
+
+// Number of packets of independent sums of blocks.
+inline constexpr long int pairwise_packets = 2;
+
+
+template <typename Base> concept PairwisePacketType =
+   FastMathType<RealTypeOf<Base>> && PacketType<Base>;
+
+
+// Lanes of packets are added pairwise. first must be a multiple of the packet size.
+template <PairwisePacketType Base>
+ValueTypeOf<Base> packet_sum(const Base& A, index_t first, index_t last) {
+   using T = RealTypeOf<Base>;
+   constexpr long int N = packet_size<T>;
+   constexpr long int K = pairwise_packets;
+   const index_t n{N};
+   const index_t nk{N * K};
+   const index_t tail = maxs(first, last / n * n);
+
+   // Negative zero is the identity of addition, including the sign of zero.
+   Packet<T, N> acc[K];
+   for(auto& a : acc) {
+      a = Packet<T, N>::broadcast(-T{0});
+   }
+   index_t i = first;
+   for(; i + nk <= tail; i += nk) {
+      for(long int k = 0; k < K; ++k) {
+         acc[k] = acc[k] + packet_at<N>(A, i + index_t{N * k});
+      }
+   }
+   for(; i < tail; i += n) {
+      acc[0] = acc[0] + packet_at<N>(A, i);
+   }
+
+   for(long int k = 1; k < K; ++k) {
+      acc[0] = acc[0] + acc[k];
+   }
+   auto& p = acc[0];
+   for(long int h = N / 2; h > 0; h /= 2) {
+      for(long int k = 0; k < h; ++k) {
+         p.v[k] += p.v[k + h];
+      }
+   }
+   Strict<T> s{p.v[0]};
+   for(i = tail; i < last; ++i) {
+      s += A.un(i);
+   }
+   return s;
+}
+
+
+template <FloatingBaseType Base>
+STRICT_CONSTEXPR ValueTypeOf<Base> block_sum(const Base& A, index_t first, index_t last) {
+   if constexpr(PairwisePacketType<Base>) {
+      if(!std::is_constant_evaluated() && is_packet_ready(A)
+         && first % index_t{packet_size<RealTypeOf<Base>>} == 0_sl) {
+         return detail::packet_sum(A, first, last);
+      }
+   }
+   return detail::sum(A, first, last);
+}
+
+
+template <FloatingBaseType Base>
+STRICT_CONSTEXPR ValueTypeOf<Base> pairwise_sum(const Base& A, index_t first, index_t last) {
+   return detail::pairwise_sum<RealTypeOf<Base>>(
+      first, last, detail::pairwise_block(),
+      [&A](index_t i, index_t j) { return detail::block_sum(A, i, j); });
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Reproducible summation, see binned_sum.hpp. Terms of a block are evaluated once and stored in
+// a buffer on the stack, while the largest term, which selects the grid, is found. Terms of float
+// and double are then rounded on the grid by packets, also for slices and for expressions that do
+// not support packet evaluation. Blocks with infinities or NaNs are summed term by term.
+inline constexpr long int binned_block = 2'048;
+
+
+template <typename Base> concept BinnedPacketType =
+   FastMathType<RealTypeOf<Base>> && PacketType<Base>;
+
+
+template <FloatingBaseType Base>
+void binned_block_sum(const Base& A, index_t first, index_t last,
+                      BinnedSum<BinnedWorkType<RealTypeOf<Base>>>& r) {
+   using W = BinnedWorkType<RealTypeOf<Base>>;
+   using B = BinnedSum<W>;
+   constexpr long int N = FastMathType<W> ? packet_size<W> : 1;
+   alignas(64) W terms[binned_block];
+   const long int n = (last - first).val();
+
+   W m{0};
+   long int j = 0;
+   if constexpr(BinnedPacketType<Base>) {
+      if(is_packet_ready(A) && first % index_t{N} == 0_sl) {
+         auto pm = Packet<W, N>::broadcast(W(0));
+         for(; j + N <= n; j += N) {
+            const auto x = packet_cast<W>(packet_at<N>(A, first + index_t{j}));
+            std::memcpy(terms + j, &x.v, sizeof(x.v));
+            const auto a = packet_abs(x);
+            pm = packet_select(packet_less(pm, a), a, pm);
+         }
+         for(long int k = 0; k < N; ++k) {
+            m = pm.v[k] > m ? pm.v[k] : m;
+         }
+      }
+   }
+   for(; j < n; ++j) {
+      const W x = strict_cast<W>(A.un(first + index_t{j})).val();
+      const W a = x < W(0) ? -x : x;
+      terms[j] = x;
+      m = a > m ? a : m;
+   }
+
+   // NaNs are not selected as the largest term, but make parts NaN.
+   if(isfinites(Strict<W>{m})) {
+      const auto g = B::grid(m);
+      typename B::template Folds<W> parts{};
+      j = 0;
+      if constexpr(FastMathType<W>) {
+#ifndef __FAST_MATH__
+         using P = Packet<W, N>;
+         typename B::template Folds<P> e, p;
+         for(std::size_t k = 0; k < e.size(); ++k) {
+            e[k] = P::broadcast(g.extractors[k]);
+            p[k] = P::broadcast(W(0));
+         }
+         const auto scale = P::broadcast(g.scale);
+         for(; j + N <= n; j += N) {
+            P x;
+            std::memcpy(&x.v, terms + j, sizeof(x.v));
+            B::deposit(x * scale, e, p);
+         }
+         // Parts are multiples of the grid much smaller than 2^digits times the grid, hence
+         // lanes are added exactly.
+         for(std::size_t k = 0; k < p.size(); ++k) {
+            for(long int l = 0; l < N; ++l) {
+               parts[k] += p[k].v[l];
+            }
+         }
+#endif
+      }
+      for(; j < n; ++j) {
+         B::deposit(terms[j] * g.scale, g.extractors, parts);
+      }
+      if(r.add(g, parts)) {
+         return;
+      }
+   }
+   for(j = 0; j < n; ++j) {
+      r.add(terms[j]);
+   }
+}
+
+
+template <FloatingBaseType Base>
+BinnedSum<BinnedWorkType<RealTypeOf<Base>>> binned_sum(const Base& A, index_t first,
+                                                       index_t last) {
+   BinnedSum<BinnedWorkType<RealTypeOf<Base>>> r;
+   for(index_t i = first; i < last; i += index_t{binned_block}) {
+      detail::binned_block_sum(A, i, mins(i + index_t{binned_block}, last), r);
+   }
+   return r;
+}
+
+
+template <Floating T>
+STRICT_NODISCARD_INLINE BinnedSum<T> merge_binned(BinnedSum<T> x, const BinnedSum<T>& y) {
+   x.merge(y);
+   return x;
+}
+
+
+template <RealBaseType Base>
+STRICT_CONSTEXPR ValueTypeOf<Base> prod(const Base& A, index_t first, index_t last) {
+   auto p = A.un(first);
+   for(index_t i = first + 1_sl; i < last; ++i) {
+      p *= A.un(i);
+   }
+   return p;
+}
+
+
+template <RealBaseType Base>
+STRICT_CONSTEXPR ValueTypeOf<Base> min(const Base& A, index_t first, index_t last) {
+   auto min_elem = A.un(first);
+   for(index_t i = first + 1_sl; i < last; ++i) {
+      min_elem = mins(A.un(i), min_elem);
+   }
+   return min_elem;
+}
+
+
+template <RealBaseType Base>
+STRICT_CONSTEXPR ValueTypeOf<Base> max(const Base& A, index_t first, index_t last) {
+   auto max_elem = A.un(first);
+   for(index_t i = first + 1_sl; i < last; ++i) {
+      max_elem = maxs(A.un(i), max_elem);
+   }
+   return max_elem;
+}
+
+
+// Uses linear indexing for two-dimensional types.
+template <RealBaseType Base>
+STRICT_CONSTEXPR std::pair<index_t, ValueTypeOf<Base>> min_index(const Base& A, index_t first,
+                                                                 index_t last) {
+   std::pair<index_t, ValueTypeOf<Base>> min = {first, A.un(first)};
+   for(index_t i = first + 1_sl; i < last; ++i) {
+      if(auto xi = A.un(i); xi < min.second) {
+         min = {i, xi};
+      }
+   }
+   return min;
+}
+
+
+template <RealBaseType Base>
+STRICT_CONSTEXPR std::pair<index_t, ValueTypeOf<Base>> max_index(const Base& A, index_t first,
+                                                                 index_t last) {
+   std::pair<index_t, ValueTypeOf<Base>> max = {first, A.un(first)};
+   for(index_t i = first + 1_sl; i < last; ++i) {
+      if(auto xi = A.un(i); xi > max.second) {
+         max = {i, xi};
+      }
+   }
+   return max;
+}
+
+
+// Blocks are combined from left to right, hence the first index is kept in case of ties.
+template <RealBaseType Base>
+std::pair<index_t, ValueTypeOf<Base>> parallel_min_index(const Base& A) {
+   using P = std::pair<index_t, ValueTypeOf<Base>>;
+   return parallel_reduce<P>(
+      A.size(), [&A](index_t first, index_t last) { return detail::min_index(A, first, last); },
+      [](const P& x, const P& y) { return y.second < x.second ? y : x; });
+}
+
+
+template <RealBaseType Base>
+std::pair<index_t, ValueTypeOf<Base>> parallel_max_index(const Base& A) {
+   using P = std::pair<index_t, ValueTypeOf<Base>>;
+   return parallel_reduce<P>(
+      A.size(), [&A](index_t first, index_t last) { return detail::max_index(A, first, last); },
+      [](const P& x, const P& y) { return y.second > x.second ? y : x; });
+}
+
+
+} // namespace detail
+
+
 template <RealBaseType Base>
 STRICT_CONSTEXPR ValueTypeOf<Base> sum(const Base& A, ValueTypeOf<Base> empty_default) {
+   return sum(A, detail::default_summation(), empty_default);
+}
+
+
+template <RealBaseType Base>
+STRICT_CONSTEXPR ValueTypeOf<Base> sum(const Base& A, [[maybe_unused]] SumFlag sf,
+                                       ValueTypeOf<Base> empty_default) {
+   STRICT_PROFILE_SCOPE("reduce/sum");
    if(A.empty()) {
       return empty_default;
    }
-   ValueTypeOf<Base> s = A.un(0);
-   for(index_t i = 1_sl; i < A.size(); ++i) {
-      s += A.un(i);
+   if constexpr(Floating<RealTypeOf<Base>>) {
+      if(sf == ReproducibleSum) {
+         using B = detail::BinnedSum<detail::BinnedWorkType<RealTypeOf<Base>>>;
+         auto f = [&A](index_t first, index_t last) { return detail::binned_sum(A, first, last); };
+         if(detail::use_parallel_reduction(A)) {
+            const auto r = detail::parallel_reduce<B>(
+               A.size(), f, [](const B& x, const B& y) { return detail::merge_binned(x, y); });
+            return strict_cast<RealTypeOf<Base>>(r.result());
+         }
+         return strict_cast<RealTypeOf<Base>>(f(0_sl, A.size()).result());
+      }
+      if(sf == PairwiseSum) {
+         auto f = [&A](index_t first, index_t last) {
+            return detail::pairwise_sum(A, first, last);
+         };
+         if(detail::use_parallel_reduction(A)) {
+            return detail::parallel_reduce<ValueTypeOf<Base>>(A.size(), f,
+                                                              [](auto x, auto y) { return x + y; });
+         }
+         return f(0_sl, A.size());
+      }
    }
-   return s;
+   if(detail::use_parallel_reduction(A)) {
+      return detail::parallel_reduce<ValueTypeOf<Base>>(
+         A.size(), [&A](index_t first, index_t last) { return detail::sum(A, first, last); },
+         [](auto x, auto y) { return x + y; });
+   }
+   return detail::sum(A, 0_sl, A.size());
 }
 
 
 template <RealBaseType Base>
 STRICT_CONSTEXPR ValueTypeOf<Base> prod(const Base& A, ValueTypeOf<Base> empty_default) {
+   STRICT_PROFILE_SCOPE("reduce/prod");
    if(A.empty()) {
       return empty_default;
    }
-   auto p = A.un(0);
-   for(index_t i = 1_sl; i < A.size(); ++i) {
-      p *= A.un(i);
+   if(detail::use_parallel_reduction(A)) {
+      return detail::parallel_reduce<ValueTypeOf<Base>>(
+         A.size(), [&A](index_t first, index_t last) { return detail::prod(A, first, last); },
+         [](auto x, auto y) { return x * y; });
    }
-   return p;
+   return detail::prod(A, 0_sl, A.size());
 }
 
 
 template <FloatingBaseType Base>
 STRICT_CONSTEXPR ValueTypeOf<Base> mean(const Base& A, ValueTypeOf<Base> empty_default) {
+   return mean(A, detail::default_summation(), empty_default);
+}
+
+
+template <FloatingBaseType Base>
+STRICT_CONSTEXPR ValueTypeOf<Base> mean(const Base& A, SumFlag sf,
+                                        ValueTypeOf<Base> empty_default) {
    if(A.empty()) {
       return empty_default;
    }
-   return sum(A) / value_type_cast<Base>(A.size());
+   return sum(A, sf) / value_type_cast<Base>(A.size());
 }
 
 
 template <RealBaseType Base>
 STRICT_CONSTEXPR ValueTypeOf<Base> min(const Base& A, ValueTypeOf<Base> empty_default) {
+   STRICT_PROFILE_SCOPE("reduce/min");
    if(A.empty()) {
       return empty_default;
    }
-   auto min_elem = A.un(0);
-   for(index_t i = 1_sl; i < A.size(); ++i) {
-      min_elem = mins(A.un(i), min_elem);
+   if(detail::use_parallel_reduction(A)) {
+      return detail::parallel_reduce<ValueTypeOf<Base>>(
+         A.size(), [&A](index_t first, index_t last) { return detail::min(A, first, last); },
+         [](auto x, auto y) { return mins(y, x); });
    }
-   return min_elem;
+   return detail::min(A, 0_sl, A.size());
 }
 
 
 template <RealBaseType Base>
 STRICT_CONSTEXPR ValueTypeOf<Base> max(const Base& A, ValueTypeOf<Base> empty_default) {
+   STRICT_PROFILE_SCOPE("reduce/max");
    if(A.empty()) {
       return empty_default;
    }
-   auto max_elem = A.un(0);
-   for(index_t i = 1_sl; i < A.size(); ++i) {
-      max_elem = maxs(A.un(i), max_elem);
+   if(detail::use_parallel_reduction(A)) {
+      return detail::parallel_reduce<ValueTypeOf<Base>>(
+         A.size(), [&A](index_t first, index_t last) { return detail::max(A, first, last); },
+         [](auto x, auto y) { return maxs(y, x); });
    }
-   return max_elem;
+   return detail::max(A, 0_sl, A.size());
 }
 
 
@@ -377,13 +817,10 @@ min_index(const Base& A, std::pair<index_t, ValueTypeOf<Base>> empty_default) {
    if(A.empty()) {
       return empty_default;
    }
-   std::pair<index_t, ValueTypeOf<Base>> min = {0_sl, A.un(0)};
-   for(index_t i = 1_sl; i < A.size(); ++i) {
-      if(auto xi = A.un(i); xi < min.second) {
-         min = {i, xi};
-      }
+   if(detail::use_parallel_reduction(A)) {
+      return detail::parallel_min_index(A);
    }
-   return min;
+   return detail::min_index(A, 0_sl, A.size());
 }
 
 
@@ -393,6 +830,10 @@ min_index(const Base& A, std::tuple<index_t, index_t, ValueTypeOf<Base>> empty_d
    if(A.empty()) {
       return empty_default;
    }
+   if(detail::use_parallel_reduction(A)) {
+      auto [k, x] = detail::parallel_min_index(A);
+      return {k / A.cols(), k % A.cols(), x};
+   }
    std::tuple<index_t, index_t, ValueTypeOf<Base>> min = {0_sl, 0_sl, A.un(0, 0)};
    for(index_t i = 0_sl; i < A.rows(); ++i) {
       for(index_t j = 0_sl; j < A.cols(); ++j) {
@@ -411,13 +852,10 @@ max_index(const Base& A, std::pair<index_t, ValueTypeOf<Base>> empty_default) {
    if(A.empty()) {
       return empty_default;
    }
-   std::pair<index_t, ValueTypeOf<Base>> max = {0_sl, A.un(0)};
-   for(index_t i = 1_sl; i < A.size(); ++i) {
-      if(auto xi = A.un(i); xi > max.second) {
-         max = {i, xi};
-      }
+   if(detail::use_parallel_reduction(A)) {
+      return detail::parallel_max_index(A);
    }
-   return max;
+   return detail::max_index(A, 0_sl, A.size());
 }
 
 
@@ -427,6 +865,10 @@ max_index(const Base& A, std::tuple<index_t, index_t, ValueTypeOf<Base>> empty_d
    if(A.empty()) {
       return empty_default;
    }
+   if(detail::use_parallel_reduction(A)) {
+      auto [k, x] = detail::parallel_max_index(A);
+      return {k / A.cols(), k % A.cols(), x};
+   }
    std::tuple<index_t, index_t, ValueTypeOf<Base>> max = {0_sl, 0_sl, A.un(0, 0)};
    for(index_t i = 0_sl; i < A.rows(); ++i) {
       for(index_t j = 0_sl; j < A.cols(); ++j) {
@@ -470,11 +912,20 @@ template <RealBaseType Base1, RealBaseType Base2>
    requires(same_dimension_b<Base1, Base2>())
 STRICT_CONSTEXPR ValueTypeOf<Base1> dot_prod(const Base1& A1, const Base2& A2,
                                              ValueTypeOf<Base1> empty_default) {
+   return dot_prod(A1, A2, detail::default_summation(), empty_default);
+}
+
+
+template <RealBaseType Base1, RealBaseType Base2>
+   requires(same_dimension_b<Base1, Base2>())
+STRICT_CONSTEXPR ValueTypeOf<Base1> dot_prod(const Base1& A1, const Base2& A2, SumFlag sf,
+                                             ValueTypeOf<Base1> empty_default) {
+   STRICT_PROFILE_SCOPE("reduce/dot_prod");
    ASSERT_STRICT_DEBUG(same_size(A1, A2));
    if(A1.empty()) {
       return empty_default;
    }
-   return sum(A1 * A2);
+   return sum(A1 * A2, sf);
 }
 
 
@@ -489,49 +940,85 @@ STRICT_CONSTEXPR ValueTypeOf<Base> norm_inf(const Base& A, ValueTypeOf<Base> emp
 
 template <FloatingBaseType Base>
 STRICT_CONSTEXPR ValueTypeOf<Base> norm1(const Base& A, ValueTypeOf<Base> empty_default) {
+   return norm1(A, detail::default_summation(), empty_default);
+}
+
+
+template <FloatingBaseType Base>
+STRICT_CONSTEXPR ValueTypeOf<Base> norm1(const Base& A, SumFlag sf,
+                                         ValueTypeOf<Base> empty_default) {
    if(A.empty()) {
       return empty_default;
    }
-   return sum(abs(A));
+   return sum(abs(A), sf);
 }
 
 
 template <FloatingBaseType Base>
 STRICT_CONSTEXPR ValueTypeOf<Base> norm1_scaled(const Base& A, ValueTypeOf<Base> empty_default) {
+   return norm1_scaled(A, detail::default_summation(), empty_default);
+}
+
+
+template <FloatingBaseType Base>
+STRICT_CONSTEXPR ValueTypeOf<Base> norm1_scaled(const Base& A, SumFlag sf,
+                                                ValueTypeOf<Base> empty_default) {
    if(A.empty()) {
       return empty_default;
    }
-   return mean(abs(A));
+   return mean(abs(A), sf);
 }
 
 
 template <FloatingBaseType Base>
 STRICT_CONSTEXPR_2026 ValueTypeOf<Base> norm2(const Base& A, ValueTypeOf<Base> empty_default) {
+   return norm2(A, detail::default_summation(), empty_default);
+}
+
+
+template <FloatingBaseType Base>
+STRICT_CONSTEXPR_2026 ValueTypeOf<Base> norm2(const Base& A, SumFlag sf,
+                                              ValueTypeOf<Base> empty_default) {
+   STRICT_PROFILE_SCOPE("reduce/norm2");
    if(A.empty()) {
       return empty_default;
    }
-   return sqrts(dot_prod(A, A));
+   return sqrts(dot_prod(A, A, sf));
 }
 
 
 template <FloatingBaseType Base>
 STRICT_CONSTEXPR_2026 ValueTypeOf<Base> norm2_scaled(const Base& A,
                                                      ValueTypeOf<Base> empty_default) {
+   return norm2_scaled(A, detail::default_summation(), empty_default);
+}
+
+
+template <FloatingBaseType Base>
+STRICT_CONSTEXPR_2026 ValueTypeOf<Base> norm2_scaled(const Base& A, SumFlag sf,
+                                                     ValueTypeOf<Base> empty_default) {
    if(A.empty()) {
       return empty_default;
    }
-   return norm2(A) / sqrts(value_type_cast<Base>(A.size()));
+   return norm2(A, sf) / sqrts(value_type_cast<Base>(A.size()));
 }
 
 
 template <FloatingBaseType Base>
 STRICT_CONSTEXPR_2026 ValueTypeOf<Base> norm_lp(const Base& A, ImplicitInt lp,
                                                 ValueTypeOf<Base> empty_default) {
+   return norm_lp(A, lp, detail::default_summation(), empty_default);
+}
+
+
+template <FloatingBaseType Base>
+STRICT_CONSTEXPR_2026 ValueTypeOf<Base> norm_lp(const Base& A, ImplicitInt lp, SumFlag sf,
+                                                ValueTypeOf<Base> empty_default) {
    ASSERT_STRICT_DEBUG(lp.get() > 0_sl);
    if(A.empty()) {
       return empty_default;
    }
-   ValueTypeOf<Base> s = sum(abs(pow_int(A, lp.get())));
+   ValueTypeOf<Base> s = sum(abs(pow_int(A, lp.get())), sf);
    return pows(s, invs(value_type_cast<Base>(lp.get())));
 }
 
@@ -539,11 +1026,18 @@ STRICT_CONSTEXPR_2026 ValueTypeOf<Base> norm_lp(const Base& A, ImplicitInt lp,
 template <FloatingBaseType Base>
 STRICT_CONSTEXPR_2026 ValueTypeOf<Base> norm_lp_scaled(const Base& A, ImplicitInt lp,
                                                        ValueTypeOf<Base> empty_default) {
+   return norm_lp_scaled(A, lp, detail::default_summation(), empty_default);
+}
+
+
+template <FloatingBaseType Base>
+STRICT_CONSTEXPR_2026 ValueTypeOf<Base> norm_lp_scaled(const Base& A, ImplicitInt lp, SumFlag sf,
+                                                       ValueTypeOf<Base> empty_default) {
    ASSERT_STRICT_DEBUG(lp.get() > 0_sl);
    if(A.empty()) {
       return empty_default;
    }
-   return norm_lp(A, lp)
+   return norm_lp(A, lp, sf)
         / pows(value_type_cast<Base>(A.size()), invs(value_type_cast<Base>(lp.get())));
 }
 
@@ -566,19 +1060,36 @@ template <OneDimRealBaseType Base1, OneDimSignedIntegerBaseType Base2>
 STRICT_CONSTEXPR_2026 ValueTypeOf<Base1> polynomial(const Base1& coeffs, ValueTypeOf<Base1> x,
                                                     const Base2& powers,
                                                     ValueTypeOf<Base1> empty_default) {
+   return polynomial(coeffs, x, powers, detail::default_summation(), empty_default);
+}
+
+
+template <OneDimRealBaseType Base1, OneDimSignedIntegerBaseType Base2>
+STRICT_CONSTEXPR_2026 ValueTypeOf<Base1> polynomial(const Base1& coeffs, ValueTypeOf<Base1> x,
+                                                    const Base2& powers, SumFlag sf,
+                                                    ValueTypeOf<Base1> empty_default) {
    ASSERT_STRICT_DEBUG(same_size(coeffs, powers));
    if(coeffs.empty()) {
       return empty_default;
    }
    ASSERT_STRICT_DEBUG(all_non_neg(powers));
    auto X = const1D(Size{coeffs.size()}, Value{x});
-   return gpolynomial(coeffs, X, powers);
+   return gpolynomial(coeffs, X, powers, sf);
+}
+
+
+template <OneDimRealBaseType Base1, OneDimRealBaseType Base2, OneDimSignedIntegerBaseType Base3>
+STRICT_CONSTEXPR_2026 ValueTypeOf<Base1> gpolynomial(const Base1& coeffs, const Base2& X,
+                                                     const Base3& powers,
+                                                     ValueTypeOf<Base1> empty_default) {
+   return gpolynomial(coeffs, X, powers, detail::default_summation(), empty_default);
 }
 
 
 template <OneDimRealBaseType Base1, OneDimRealBaseType Base2, OneDimSignedIntegerBaseType Base3>
 STRICT_CONSTEXPR_2026 ValueTypeOf<Base1> gpolynomial(const Base1& coeffs, const Base2& X,
                                                      const Base3& powers,
+                                                     [[maybe_unused]] SumFlag sf,
                                                      ValueTypeOf<Base1> empty_default) {
    ASSERT_STRICT_DEBUG(same_size(coeffs, X, powers));
    if(coeffs.empty()) {
@@ -586,11 +1097,31 @@ STRICT_CONSTEXPR_2026 ValueTypeOf<Base1> gpolynomial(const Base1& coeffs, const
    }
    ASSERT_STRICT_DEBUG(all_non_neg(powers));
 
-   ValueTypeOf<Base1> z{};
-   for(index_t i = 0_sl; i < X.size(); ++i) {
-      z += coeffs.un(i) * pows(X.un(i), value_type_cast<Base2>(powers.un(i)));
+   auto term = [&](index_t i) {
+      return coeffs.un(i) * pows(X.un(i), value_type_cast<Base2>(powers.un(i)));
+   };
+   auto sum_terms = [&](index_t first, index_t last) {
+      ValueTypeOf<Base1> z{};
+      for(index_t i = first; i < last; ++i) {
+         z += term(i);
+      }
+      return z;
+   };
+   if constexpr(Floating<RealTypeOf<Base1>>) {
+      if(sf == ReproducibleSum) {
+         using W = detail::BinnedWorkType<RealTypeOf<Base1>>;
+         detail::BinnedSum<W> r;
+         for(index_t i = 0_sl; i < X.size(); ++i) {
+            r.add(strict_cast<W>(term(i)).val());
+         }
+         return strict_cast<RealTypeOf<Base1>>(r.result());
+      }
+      if(sf == PairwiseSum) {
+         return detail::pairwise_sum<RealTypeOf<Base1>>(0_sl, X.size(), detail::pairwise_block(),
+                                                        sum_terms);
+      }
    }
-   return z;
+   return sum_terms(0_sl, X.size());
 }
 
 
@@ -864,4 +1395,12 @@ void shuffle(Base&& A) {
 }
 
 
+template <typename Base>
+   requires(detail::TwoDimNonConstBaseType<RemoveRef<Base>> && !detail::ArrayTypeRvalue<Base>)
+STRICT_CONSTEXPR void transpose_in_place(Base&& A) {
+   ASSERT_STRICT_DEBUG(A.rows() == A.cols());
+   detail::transpose_square(A);
+}
+
+
 } // namespace spp
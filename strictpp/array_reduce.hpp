@@ -0,0 +1,579 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include "ArrayCommon/array_auxiliary.hpp"
+#include "ArrayCommon/array_traits.hpp"
+#include "ArrayCommon/parallel.hpp"
+#include "StrictCommon/strict_common.hpp"
+#include "Util/profiler.hpp"
+#include "array_ops.hpp"
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+namespace spp {
+
+
+namespace detail {
+
+
+// Sum of terms of sum_op, mean_op, norm1_op, and norm2_op for floating-point types. Terms are
+// added one at a time by add for RecursiveSum. For PairwiseSum, sums of blocks of terms are
+// computed by add_block as by sum(packets of terms are used if sum would use them), and are added
+// pairwise, see sum_flag.hpp. Merged states hold the sum of both states, as the combined results
+// of blocks of parallel_reduce. For ReproducibleSum, blocks of terms are added to a binned sum,
+// which is merged exactly.
+template <Floating T>
+class SumState {
+public:
+   STRICT_CONSTEXPR SumState() = default;
+
+   STRICT_CONSTEXPR explicit SumState(SumFlag sf, Strict<T> s = {}) : sf_{sf}, s_{s} {
+   }
+
+   STRICT_CONSTEXPR void add(Strict<T> x) {
+      s_ += x;
+   }
+
+   // E are the terms of the block that starts at first.
+   template <FloatingBaseType Base>
+   void add_block(const Base& E, index_t first, bool packets) {
+      if(sf_ == ReproducibleSum) {
+         for(index_t i = 0_sl; i < E.size(); i += index_t{binned_block}) {
+            detail::binned_block_sum(E, i, mins(i + index_t{binned_block}, E.size()), binned_);
+         }
+         return;
+      }
+      if constexpr(PairwisePacketType<Base>) {
+         if(packets && first % index_t{packet_size<T>} == 0_sl) {
+            cascade_.add(detail::packet_sum(E, 0_sl, E.size()));
+            return;
+         }
+      }
+      cascade_.add(detail::sum(E, 0_sl, E.size()));
+   }
+
+   STRICT_CONSTEXPR void merge(const SumState& other) {
+      if(sf_ == ReproducibleSum) {
+         binned_.merge(other.binned_);
+      } else if(sf_ == PairwiseSum) {
+         const auto s = this->result() + other.result();
+         cascade_ = {};
+         cascade_.add(s);
+      } else {
+         s_ += other.s_;
+      }
+   }
+
+   STRICT_CONSTEXPR Strict<T> result() const {
+      if(sf_ == ReproducibleSum) {
+         return strict_cast<T>(binned_.result());
+      }
+      return sf_ == PairwiseSum ? cascade_.result() : s_;
+   }
+
+private:
+   SumFlag sf_ = RecursiveSum;
+   Strict<T> s_;
+   PairwiseCascade<T> cascade_;
+   BinnedSum<BinnedWorkType<T>> binned_;
+};
+
+
+} // namespace detail
+
+
+// Reduction operations for reduce_many. Each operation keeps a state that is initialized by
+// the first element, updated by the following elements, and merged with the state of the
+// next block of elements if the reduction is parallel. The results are the same as the ones of
+// the corresponding functions in array_ops.hpp, both for serial and parallel reductions, including
+// the flag of summation of execution(see sum_flag.hpp) used by sum_op, mean_op, norm1_op, and
+// norm2_op. For PairwiseSum and ReproducibleSum, blocks of elements are evaluated into a buffer
+// E, and the terms(E) are added as by sum.
+struct sum_op {
+   template <Real T>
+   STRICT_CONSTEXPR auto init(Strict<T> x) const {
+      if constexpr(Floating<T>) {
+         return detail::SumState<T>{RecursiveSum, x};
+      } else {
+         return x;
+      }
+   }
+
+   template <Real T>
+   STRICT_CONSTEXPR void update(Strict<T>& s, Strict<T> x) const {
+      s += x;
+   }
+
+   template <Floating T>
+   STRICT_CONSTEXPR void update(detail::SumState<T>& s, Strict<T> x) const {
+      s.add(x);
+   }
+
+   template <Real T>
+   STRICT_CONSTEXPR void merge(Strict<T>& s, Strict<T> t) const {
+      s += t;
+   }
+
+   template <Floating T>
+   STRICT_CONSTEXPR void merge(detail::SumState<T>& s, const detail::SumState<T>& t) const {
+      s.merge(t);
+   }
+
+   template <Real T>
+   STRICT_CONSTEXPR Strict<T> result(Strict<T> s, [[maybe_unused]] index_t n) const {
+      return s;
+   }
+
+   template <Floating T>
+   STRICT_CONSTEXPR Strict<T> result(const detail::SumState<T>& s,
+                                     [[maybe_unused]] index_t n) const {
+      return s.result();
+   }
+
+   template <Real T>
+   STRICT_CONSTEXPR Strict<T> empty() const {
+      return {};
+   }
+
+   template <FloatingBaseType Base>
+   static const Base& terms(const Base& E) {
+      return E;
+   }
+};
+
+
+struct prod_op {
+   template <Real T>
+   STRICT_CONSTEXPR Strict<T> init(Strict<T> x) const {
+      return x;
+   }
+
+   template <Real T>
+   STRICT_CONSTEXPR void update(Strict<T>& p, Strict<T> x) const {
+      p *= x;
+   }
+
+   template <Real T>
+   STRICT_CONSTEXPR void merge(Strict<T>& p, Strict<T> q) const {
+      p *= q;
+   }
+
+   template <Real T>
+   STRICT_CONSTEXPR Strict<T> result(Strict<T> p, [[maybe_unused]] index_t n) const {
+      return p;
+   }
+
+   template <Real T>
+   STRICT_CONSTEXPR Strict<T> empty() const {
+      return {};
+   }
+};
+
+
+struct mean_op : sum_op {
+   template <Floating T>
+   STRICT_CONSTEXPR Strict<T> result(const detail::SumState<T>& s, index_t n) const {
+      return s.result() / strict_cast<T>(n);
+   }
+};
+
+
+struct min_op {
+   template <Real T>
+   STRICT_CONSTEXPR Strict<T> init(Strict<T> x) const {
+      return x;
+   }
+
+   template <Real T>
+   STRICT_CONSTEXPR void update(Strict<T>& m, Strict<T> x) const {
+      m = mins(x, m);
+   }
+
+   template <Real T>
+   STRICT_CONSTEXPR void merge(Strict<T>& m, Strict<T> q) const {
+      m = mins(q, m);
+   }
+
+   template <Real T>
+   STRICT_CONSTEXPR Strict<T> result(Strict<T> m, [[maybe_unused]] index_t n) const {
+      return m;
+   }
+
+   template <Real T>
+   STRICT_CONSTEXPR Strict<T> empty() const {
+      return {};
+   }
+};
+
+
+struct max_op {
+   template <Real T>
+   STRICT_CONSTEXPR Strict<T> init(Strict<T> x) const {
+      return x;
+   }
+
+   template <Real T>
+   STRICT_CONSTEXPR void update(Strict<T>& m, Strict<T> x) const {
+      m = maxs(x, m);
+   }
+
+   template <Real T>
+   STRICT_CONSTEXPR void merge(Strict<T>& m, Strict<T> q) const {
+      m = maxs(q, m);
+   }
+
+   template <Real T>
+   STRICT_CONSTEXPR Strict<T> result(Strict<T> m, [[maybe_unused]] index_t n) const {
+      return m;
+   }
+
+   template <Real T>
+   STRICT_CONSTEXPR Strict<T> empty() const {
+      return {};
+   }
+};
+
+
+// Returns the pair {min, max}.
+struct minmax_op {
+   template <Real T>
+   STRICT_CONSTEXPR std::pair<Strict<T>, Strict<T>> init(Strict<T> x) const {
+      return {x, x};
+   }
+
+   template <Real T>
+   STRICT_CONSTEXPR void update(std::pair<Strict<T>, Strict<T>>& m, Strict<T> x) const {
+      m.first = mins(x, m.first);
+      m.second = maxs(x, m.second);
+   }
+
+   template <Real T>
+   STRICT_CONSTEXPR void merge(std::pair<Strict<T>, Strict<T>>& m,
+                               const std::pair<Strict<T>, Strict<T>>& q) const {
+      m.first = mins(q.first, m.first);
+      m.second = maxs(q.second, m.second);
+   }
+
+   template <Real T>
+   STRICT_CONSTEXPR std::pair<Strict<T>, Strict<T>>
+   result(const std::pair<Strict<T>, Strict<T>>& m, [[maybe_unused]] index_t n) const {
+      return m;
+   }
+
+   template <Real T>
+   STRICT_CONSTEXPR std::pair<Strict<T>, Strict<T>> empty() const {
+      return {};
+   }
+};
+
+
+struct norm_inf_op : max_op {
+   template <Floating T>
+   STRICT_CONSTEXPR Strict<T> init(Strict<T> x) const {
+      return abss(x);
+   }
+
+   template <Floating T>
+   STRICT_CONSTEXPR void update(Strict<T>& m, Strict<T> x) const {
+      max_op::update(m, abss(x));
+   }
+};
+
+
+struct norm1_op : sum_op {
+   template <Floating T>
+   STRICT_CONSTEXPR detail::SumState<T> init(Strict<T> x) const {
+      return sum_op::init(abss(x));
+   }
+
+   template <Floating T>
+   STRICT_CONSTEXPR void update(detail::SumState<T>& s, Strict<T> x) const {
+      s.add(abss(x));
+   }
+
+   template <FloatingBaseType Base>
+   static auto terms(const Base& E) {
+      return abs(E);
+   }
+};
+
+
+struct norm2_op : sum_op {
+   template <Floating T>
+   STRICT_CONSTEXPR detail::SumState<T> init(Strict<T> x) const {
+      return sum_op::init(x * x);
+   }
+
+   template <Floating T>
+   STRICT_CONSTEXPR void update(detail::SumState<T>& s, Strict<T> x) const {
+      s.add(x * x);
+   }
+
+   template <Floating T>
+   STRICT_CONSTEXPR_2026 Strict<T> result(const detail::SumState<T>& s,
+                                          [[maybe_unused]] index_t n) const {
+      return sqrts(s.result());
+   }
+
+   template <FloatingBaseType Base>
+   static auto terms(const Base& E) {
+      return E * E;
+   }
+};
+
+
+namespace detail {
+
+
+// Adds x to the sum s with compensation c(Neumaier's algorithm), volatile prevents the
+// compensation from being optimized away.
+template <Floating T>
+void compensated_add(Strict<T>& s, Strict<T>& c, Strict<T> x) {
+   volatile T t = s.val() + x.val();
+   if(abss(s) >= abss(x)) {
+      volatile T z = s.val() - t;
+      c += Strict<T>{z + x.val()};
+   } else {
+      volatile T z = x.val() - t;
+      c += Strict<T>{z + s.val()};
+   }
+   s = Strict<T>{t};
+}
+
+
+} // namespace detail
+
+
+// Adds elements in order by compensated_add, the result may differ from the one of stable_sum
+// by rounding of the compensation. The state is the pair {sum, compensation}.
+struct stable_sum_op {
+   template <Floating T>
+   std::pair<Strict<T>, Strict<T>> init(Strict<T> x) const {
+      return {x, Strict<T>{}};
+   }
+
+   template <Floating T>
+   void update(std::pair<Strict<T>, Strict<T>>& s, Strict<T> x) const {
+      detail::compensated_add(s.first, s.second, x);
+   }
+
+   template <Floating T>
+   void merge(std::pair<Strict<T>, Strict<T>>& s, const std::pair<Strict<T>, Strict<T>>& t) const {
+      detail::compensated_add(s.first, s.second, t.first);
+      s.second += t.second;
+   }
+
+   template <Floating T>
+   Strict<T> result(const std::pair<Strict<T>, Strict<T>>& s, [[maybe_unused]] index_t n) const {
+      return s.first + s.second;
+   }
+
+   template <Floating T>
+   STRICT_CONSTEXPR Strict<T> empty() const {
+      return {};
+   }
+};
+
+
+#define STRICT_GENERATE_BOOL_REDUCE_OP(op_name, test, combine, empty_value)                  \
+   struct op_name {                                                                           \
+      template <Floating T>                                                                   \
+      STRICT_CONSTEXPR_2023 StrictBool init(Strict<T> x) const {                              \
+         return test(x);                                                                      \
+      }                                                                                       \
+                                                                                              \
+      template <Floating T>                                                                   \
+      STRICT_CONSTEXPR_2023 void update(StrictBool& b, Strict<T> x) const {                   \
+         b = b combine test(x);                                                               \
+      }                                                                                       \
+                                                                                              \
+      STRICT_CONSTEXPR void merge(StrictBool& b, StrictBool c) const {                        \
+         b = b combine c;                                                                     \
+      }                                                                                       \
+                                                                                              \
+      STRICT_CONSTEXPR StrictBool result(StrictBool b, [[maybe_unused]] index_t n) const {    \
+         return b;                                                                            \
+      }                                                                                       \
+                                                                                              \
+      template <Floating T>                                                                   \
+      STRICT_CONSTEXPR StrictBool empty() const {                                             \
+         return empty_value;                                                                  \
+      }                                                                                       \
+   };
+
+
+STRICT_GENERATE_BOOL_REDUCE_OP(has_nan_op, isnans, ||, false_sb)
+STRICT_GENERATE_BOOL_REDUCE_OP(has_inf_op, isinfs, ||, false_sb)
+STRICT_GENERATE_BOOL_REDUCE_OP(all_finite_op, isfinites, &&, true_sb)
+#undef STRICT_GENERATE_BOOL_REDUCE_OP
+
+
+namespace detail {
+
+
+template <typename Op, typename T>
+using ReduceStateOf = decltype(std::declval<const Op&>().init(std::declval<Strict<T>>()));
+
+
+template <typename Op, typename T> concept ReduceOperation =
+   requires(const Op& op, ReduceStateOf<Op, T>& s, const ReduceStateOf<Op, T>& t, Strict<T> x,
+            index_t n) {
+      op.update(s, x);
+      op.merge(s, t);
+      op.result(t, n);
+      op.template empty<T>();
+   };
+
+
+template <typename... States, typename F>
+STRICT_CONSTEXPR void for_each_state(std::tuple<States...>& states, F f) {
+   [&]<std::size_t... I>(std::index_sequence<I...>) {
+      (f(std::integral_constant<std::size_t, I>{}, std::get<I>(states)), ...);
+   }(std::index_sequence_for<States...>{});
+}
+
+
+// Operations whose sums are added by blocks for flags of summation other than RecursiveSum.
+template <typename Op, typename T> concept BlockSumOperation =
+   Floating<T> && SameAs<ReduceStateOf<Op, T>, SumState<T>>
+   && requires(const Array1D<T>& E) { Op::terms(E); };
+
+
+// Elements of blocks of the flag of summation are evaluated into a buffer. Operations that add
+// terms by blocks do so as sum does for the same blocks, other operations are updated by the
+// elements of the buffer. first must be a multiple of the block size of PairwiseSum.
+template <RealBaseType Base, typename... Ops>
+auto reduce_many_by_blocks(const Base& A, index_t first, index_t last,
+                           const std::tuple<Ops...>& ops, SumFlag sf) {
+   using T = RealTypeOf<Base>;
+   using States = std::tuple<ReduceStateOf<Ops, T>...>;
+   const index_t block = sf == PairwiseSum ? pairwise_block() : index_t{binned_block};
+
+   // Whether sums of the terms of each operation are evaluated by packets.
+   auto packets = [&A]<typename Op>(const Op&) {
+      if constexpr(BlockSumOperation<Op, T>) {
+         if constexpr(PairwisePacketType<std::remove_cvref_t<decltype(Op::terms(A))>>) {
+            return is_packet_ready(Op::terms(A));
+         }
+      }
+      return false;
+   };
+   const auto op_packets = std::apply([&](const auto&... op) {
+      return std::array<bool, sizeof...(Ops)>{packets(op)...};
+   }, ops);
+
+   Array1D<T> buffer(mins(block, last - first), uninitialized);
+   auto fill = [&A, &buffer](index_t i, index_t n) {
+      if(n != buffer.size()) {
+         buffer.resize(n, uninitialized, false);
+      }
+      for(index_t k = 0_sl; k < n; ++k) {
+         buffer.un(k) = A.un(i + k);
+      }
+   };
+
+   fill(first, buffer.size());
+   auto init = [sf, x = buffer.un(0_sl)]<typename Op>(const Op& op) {
+      if constexpr(BlockSumOperation<Op, T>) {
+         return SumState<T>{sf};
+      } else {
+         return op.init(x);
+      }
+   };
+   States states = std::apply([&](const auto&... op) { return States{init(op)...}; }, ops);
+
+   for(index_t i = first; i < last; i += block) {
+      if(i != first) {
+         fill(i, mins(block, last - i));
+      }
+      for_each_state(states, [&](auto I, auto& s) {
+         using Op = std::tuple_element_t<I, std::tuple<Ops...>>;
+         if constexpr(BlockSumOperation<Op, T>) {
+            s.add_block(Op::terms(buffer), i, op_packets[I]);
+         } else {
+            for(index_t k = i == first ? 1_sl : 0_sl; k < buffer.size(); ++k) {
+               std::get<I>(ops).update(s, buffer.un(k));
+            }
+         }
+      });
+   }
+   return states;
+}
+
+
+// Evaluates each element once and updates the states of all operations.
+template <RealBaseType Base, typename... Ops>
+STRICT_CONSTEXPR auto reduce_many(const Base& A, index_t first, index_t last,
+                                  const std::tuple<Ops...>& ops) {
+   if constexpr((BlockSumOperation<Ops, RealTypeOf<Base>> || ...)) {
+      if(auto sf = default_summation(); sf != RecursiveSum) {
+         return detail::reduce_many_by_blocks(A, first, last, ops, sf);
+      }
+   }
+
+   auto x = A.un(first);
+   auto states = std::apply([x](const auto&... op) { return std::make_tuple(op.init(x)...); }, ops);
+   for(index_t i = first + 1_sl; i < last; ++i) {
+      auto xi = A.un(i);
+      for_each_state(states, [&ops, xi](auto I, auto& s) { std::get<I>(ops).update(s, xi); });
+   }
+   return states;
+}
+
+
+// States of all operations after reducing A, which must not be empty.
+template <RealBaseType Base, typename... Ops>
+STRICT_CONSTEXPR auto reduce_states(const Base& A, const std::tuple<Ops...>& op_tuple) {
+   using T = RealTypeOf<Base>;
+   if(use_parallel_reduction(A)) {
+      using States = std::tuple<ReduceStateOf<Ops, T>...>;
+      return parallel_reduce<States>(
+         A.size(),
+         [&A, &op_tuple](index_t first, index_t last) {
+            return detail::reduce_many(A, first, last, op_tuple);
+         },
+         [&op_tuple](States x, const States& y) {
+            for_each_state(
+               x, [&](auto I, auto& s) { std::get<I>(op_tuple).merge(s, std::get<I>(y)); });
+            return x;
+         });
+   }
+   return detail::reduce_many(A, 0_sl, A.size(), op_tuple);
+}
+
+
+} // namespace detail
+
+
+// Reduces A by all operations in a single pass and returns the tuple of their results, which is
+// useful when A is large or is an expression that is expensive to evaluate. Operations other
+// than the ones above may be used if they provide the same member functions. Two-dimensional
+// types are reduced in row-major order.
+template <RealBaseType Base, typename... Ops>
+   requires(sizeof...(Ops) > 0 && (detail::ReduceOperation<Ops, RealTypeOf<Base>> && ...))
+STRICT_CONSTEXPR auto reduce_many(const Base& A, Ops... ops) {
+   STRICT_PROFILE_SCOPE("reduce/reduce_many");
+   using T = RealTypeOf<Base>;
+   if(A.empty()) {
+      return std::make_tuple(ops.template empty<T>()...);
+   }
+
+   std::tuple<Ops...> op_tuple{ops...};
+   auto states = detail::reduce_states(A, op_tuple);
+
+   return [&]<std::size_t... I>(std::index_sequence<I...>) {
+      return std::make_tuple(std::get<I>(op_tuple).result(std::get<I>(states), A.size())...);
+   }(std::index_sequence_for<Ops...>{});
+}
+
+
+} // namespace spp
@@ -6,12 +6,21 @@
 
 #include "ArrayCommon/array_auxiliary.hpp"
 #include "ArrayCommon/array_traits.hpp"
+#include "ArrayCommon/long_accumulator.hpp"
+#include "ArrayCommon/packet.hpp"
+#include "ArrayCommon/packet_math.hpp"
+#include "ArrayCommon/parallel.hpp"
 #include "Expr/expr.hpp"
 #include "StrictCommon/strict_common.hpp"
+#include "Util/profiler.hpp"
 #include "array_ops.hpp"
 #include "derived1D.hpp"
 
-#include <tuple>
+#include <cmath>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
 
 
 namespace spp {
@@ -21,6 +30,7 @@ template <FloatingBaseType Base>
 ValueTypeOf<Base> stable_sum(const Base& A, ValueTypeOf<Base> empty_default = {});
 
 
+// Same as sum(A, PairwiseSum), see sum_flag.hpp.
 template <FloatingBaseType Base>
 ValueTypeOf<Base> semi_stable_sum(const Base& A, ValueTypeOf<Base> empty_default = {});
 
@@ -45,6 +55,16 @@ ValueTypeOf<Base1> semi_stable_dot_prod(const Base1& A1, const Base2& A2,
                                         ValueTypeOf<Base1> empty_default = {});
 
 
+template <FloatingBaseType Base>
+ValueTypeOf<Base> exact_sum(const Base& A, ValueTypeOf<Base> empty_default = {});
+
+
+template <FloatingBaseType Base1, FloatingBaseType Base2>
+   requires(same_dimension_b<Base1, Base2>())
+ValueTypeOf<Base1> exact_dot_prod(const Base1& A1, const Base2& A2,
+                                  ValueTypeOf<Base1> empty_default = {});
+
+
 template <FloatingBaseType Base>
 ValueTypeOf<Base> stable_norm1(const Base& A, ValueTypeOf<Base> empty_default = {});
 
@@ -87,60 +107,370 @@ ValueTypeOf<Base1> stable_gpolynomial(const Base1& coeffs, const Base2& X, const
                                       ValueTypeOf<Base1> empty_default = {});
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Compensated sums. The state is the pair {sum, compensation}, where the compensation accumulates
+// the rounding errors of additions. Elements of float and double types that support packet
+// evaluation are added to compensated_packets packets of independent sums by the branch-free
+// two_sum, and the lanes are then merged in order. Ranges are split into blocks of
+// reduction_block elements, which are reduced in parallel if execution allows it and merged in a
+// fixed order(see parallel_reduce), hence the results do not depend on the number of threads.
+namespace detail {
+
+
+template <Floating T>
+using CompensatedState = std::pair<Strict<T>, Strict<T>>;
+
+
+// Number of packets of independent sums, which hides the latency of additions.
+inline constexpr long int compensated_packets = 2;
+
+
+// The rounding error of the addition of sums is obtained exactly by two_sums.
+template <Floating T>
+STRICT_NODISCARD_INLINE CompensatedState<T> merge_compensated(const CompensatedState<T>& x,
+                                                             const CompensatedState<T>& y) {
+   auto [s, e] = two_sums(x.first, y.first);
+   return {s, x.second + y.second + e};
+}
+
+
+// Compensated sum and the sum of absolute values of the rounding errors that are added to the
+// compensation, which bounds the error of the compensation(see exact_sum).
+template <Floating T>
+struct ExactEstimate {
+   CompensatedState<T> sum{};
+   Strict<T> error{};
+};
+
+
+template <Floating T>
+STRICT_NODISCARD_INLINE ExactEstimate<T> merge_estimates(const ExactEstimate<T>& x,
+                                                        const ExactEstimate<T>& y) {
+   auto [s, e] = two_sums(x.sum.first, y.sum.first);
+   return {{s, x.sum.second + y.sum.second + e}, x.error + y.error + abss(e)};
+}
+
+
+// Adds x and the rounding error e of x(e.g. of a product) to the estimate.
+template <Floating T>
+STRICT_INLINE void add_estimate(ExactEstimate<T>& r, Strict<T> x, Strict<T> e = {}) {
+   auto [s, q] = two_sums(r.sum.first, x);
+   r.sum = {s, r.sum.second + (q + e)};
+   r.error += abss(q) + abss(e);
+}
+
+
+// Sums of absolute values of errors are only accumulated for ExactEstimate.
+template <FastMathType T, long int N, bool track_error>
+struct CompensatedPacket {
+   Packet<T, N> s = Packet<T, N>::broadcast(T{0});
+   Packet<T, N> c = Packet<T, N>::broadcast(T{0});
+   Packet<T, N> error = Packet<T, N>::broadcast(T{0});
+
+   STRICT_INLINE void add(const Packet<T, N>& x) {
+      Packet<T, N> t, e;
+      two_sum(s, x, t, e);
+      s = t;
+      this->add_error(e);
+   }
+
+   STRICT_INLINE void add_error(const Packet<T, N>& e) {
+      c = c + e;
+      if constexpr(track_error) {
+         error = error + packet_abs(e);
+      }
+   }
+
+   // The rounding error of the product is added to the compensation.
+   STRICT_INLINE void add_product(const Packet<T, N>& x, const Packet<T, N>& y) {
+      Packet<T, N> p, e;
+      two_prod(x, y, p, e);
+      this->add(p);
+      this->add_error(e);
+   }
+
+   STRICT_INLINE void merge_into(CompensatedState<T>& r) const {
+      for(long int k = 0; k < N; ++k) {
+         r = merge_compensated(r, CompensatedState<T>{Strict{s.v[k]}, Strict{c.v[k]}});
+      }
+   }
+
+   STRICT_INLINE void merge_into(ExactEstimate<T>& r) const {
+      for(long int k = 0; k < N; ++k) {
+         const ExactEstimate<T> lane{{Strict{s.v[k]}, Strict{c.v[k]}}, Strict{error.v[k]}};
+         r = merge_estimates(r, lane);
+      }
+   }
+};
+
+
+// add_packet(acc, i) adds terms i, ..., i + N - 1 to the packet acc and add_scalar(r, i) adds
+// term i to the state r, which is either CompensatedState<T> or ExactEstimate<T>. first must be
+// a multiple of N.
+template <FastMathType T, typename State = CompensatedState<T>, typename F, typename G>
+State compensated_packet_sum(index_t first, index_t last, F add_packet, G add_scalar) {
+   constexpr long int N = packet_size<T>;
+   constexpr long int K = compensated_packets;
+   const index_t n{N};
+   const index_t nk{N * K};
+   const index_t tail = maxs(first, last / n * n);
+
+   CompensatedPacket<T, N, SameAs<State, ExactEstimate<T>>> acc[K];
+   index_t i = first;
+   for(; i + nk <= tail; i += nk) {
+      for(long int k = 0; k < K; ++k) {
+         add_packet(acc[k], i + index_t{N * k});
+      }
+   }
+   for(; i < tail; i += n) {
+      add_packet(acc[0], i);
+   }
+
+   State r{};
+   for(const auto& a : acc) {
+      a.merge_into(r);
+   }
+   for(i = tail; i < last; ++i) {
+      add_scalar(r, i);
+   }
+   return r;
+}
+
+
+// Compilers may reassociate additions of packets under -ffast-math, while the scalar
+// algorithms use volatile temporaries.
+template <typename Base> concept CompensatedPacketType =
+   FastMathType<RealTypeOf<Base>> && PacketType<Base>;
+
+
+template <CompensatedPacketType Base>
+STRICT_NODISCARD_INLINE bool use_compensated_packets(const Base& A) {
+#ifndef __FAST_MATH__
+   return is_packet_ready(A);
+#else
+   return false;
+#endif
+}
+
+
 template <FloatingBaseType Base>
-ValueTypeOf<Base> stable_sum(const Base& A, ValueTypeOf<Base> empty_default) {
-   if(A.empty()) {
-      return empty_default;
+CompensatedState<RealTypeOf<Base>> compensated_sum(const Base& A, index_t first, index_t last) {
+   using T = RealTypeOf<Base>;
+   auto add_scalar = [&A](CompensatedState<T>& r, index_t i) {
+      compensated_add(r.first, r.second, A.un(i));
+   };
+
+   if constexpr(CompensatedPacketType<Base>) {
+      if(use_compensated_packets(A)) {
+         auto add_packet = [&A](auto& acc, index_t i) {
+            acc.add(packet_at<packet_size<T>>(A, i));
+         };
+         return compensated_packet_sum<T>(first, last, add_packet, add_scalar);
+      }
    }
 
-   using real_type = RealTypeOf<Base>;
-   using value_type = ValueTypeOf<Base>;
-
-   real_type s{};
-   real_type c{};
-   for(index_t i = 0_sl; i < A.size(); ++i) {
-      auto xi = A.un(i);
-      volatile real_type t = s + xi.val();
-      if(abss(value_type{s}) >= abss(xi)) {
-         volatile real_type z = s - t;
-         c += z + xi.val();
-      } else {
-         volatile real_type z = xi.val() - t;
-         c += z + s;
+   CompensatedState<T> r{};
+   for(index_t i = first; i < last; ++i) {
+      add_scalar(r, i);
+   }
+   return r;
+}
+
+
+template <FloatingBaseType Base1, FloatingBaseType Base2>
+CompensatedState<RealTypeOf<Base1>> compensated_dot_prod(const Base1& A1, const Base2& A2,
+                                                         index_t first, index_t last) {
+   using T = RealTypeOf<Base1>;
+   auto add_scalar = [&A1, &A2](CompensatedState<T>& r, index_t i) {
+      auto [h, e] = two_prods(A1.un(i), A2.un(i));
+      auto [s, q] = two_sums(r.first, h);
+      r = {s, r.second + (q + e)};
+   };
+
+   if constexpr(CompensatedPacketType<Base1> && CompensatedPacketType<Base2>) {
+      if(use_compensated_packets(A1) && use_compensated_packets(A2)) {
+         auto add_packet = [&A1, &A2](auto& acc, index_t i) {
+            constexpr long int N = packet_size<T>;
+            acc.add_product(packet_at<N>(A1, i), packet_at<N>(A2, i));
+         };
+         auto r = compensated_packet_sum<T>(first, last, add_packet, add_scalar);
+         // Products are split into halves without fused multiply-add, which may overflow even
+         // if the products do not.
+         if(std::isfinite((r.first + r.second).val())) {
+            return r;
+         }
       }
-      s = t;
    }
-   return value_type{s + c};
+
+   CompensatedState<T> r{};
+   for(index_t i = first; i < last; ++i) {
+      add_scalar(r, i);
+   }
+   return r;
 }
 
 
+} // namespace detail
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Correctly rounded sums. The compensated sum is computed along with the bound of its error. If
+// the bound proves that the exact sum rounds to the same number as the compensated sum, the
+// latter is returned, which fails only for sums that are close to midpoints between numbers or
+// that are extremely ill-conditioned. Otherwise, terms are summed again by LongAccumulator.
+// Terms of float are summed in double, where products of float are exact.
+namespace detail {
+
+
+template <Floating T>
+using ExactWorkType = std::conditional_t<SameAs<T, float>, double, T>;
+
+
 template <FloatingBaseType Base>
-ValueTypeOf<Base> semi_stable_sum(const Base& A, ValueTypeOf<Base> empty_default) {
-   if(A.empty()) {
-      return empty_default;
+ExactEstimate<ExactWorkType<RealTypeOf<Base>>> exact_sum_estimate(const Base& A, index_t first,
+                                                                  index_t last) {
+   using W = ExactWorkType<RealTypeOf<Base>>;
+   auto add_scalar = [&A](ExactEstimate<W>& r, index_t i) {
+      add_estimate(r, strict_cast<W>(A.un(i)));
+   };
+
+   if constexpr(CompensatedPacketType<Base>) {
+      if(use_compensated_packets(A)) {
+         auto add_packet = [&A](auto& acc, index_t i) {
+            acc.add(packet_cast<W>(packet_at<packet_size<W>>(A, i)));
+         };
+         return compensated_packet_sum<W, ExactEstimate<W>>(first, last, add_packet, add_scalar);
+      }
    }
 
-   const index_t block_size = 64_sl;
-   const index_t nblocks = A.size() / block_size;
-   const index_t rem = A.size() % block_size;
+   ExactEstimate<W> r;
+   for(index_t i = first; i < last; ++i) {
+      add_scalar(r, i);
+   }
+   return r;
+}
+
 
-   Array1D<RealTypeOf<Base>> sb(nblocks);
-   for(index_t i = 0_sl; i < nblocks; ++i) {
-      for(index_t j = 0_sl; j < block_size; ++j) {
-         sb[i] += A.un(i * block_size + j);
+template <FloatingBaseType Base1, FloatingBaseType Base2>
+ExactEstimate<ExactWorkType<RealTypeOf<Base1>>>
+exact_dot_prod_estimate(const Base1& A1, const Base2& A2, index_t first, index_t last) {
+   using W = ExactWorkType<RealTypeOf<Base1>>;
+   auto add_scalar = [&A1, &A2](ExactEstimate<W>& r, index_t i) {
+      const auto [p, e] = two_prods(strict_cast<W>(A1.un(i)), strict_cast<W>(A2.un(i)));
+      add_estimate(r, p, e);
+   };
+
+   if constexpr(CompensatedPacketType<Base1> && CompensatedPacketType<Base2>) {
+      if(use_compensated_packets(A1) && use_compensated_packets(A2)) {
+         auto add_packet = [&A1, &A2](auto& acc, index_t i) {
+            constexpr long int N = packet_size<W>;
+            acc.add_product(packet_cast<W>(packet_at<N>(A1, i)),
+                            packet_cast<W>(packet_at<N>(A2, i)));
+         };
+         return compensated_packet_sum<W, ExactEstimate<W>>(first, last, add_packet, add_scalar);
       }
    }
 
-   ValueTypeOf<Base> r{};
-   for(index_t i = 0_sl; i < rem; ++i) {
-      r += A.un(A.size() - 1_sl - i);
+   ExactEstimate<W> r;
+   for(index_t i = first; i < last; ++i) {
+      add_scalar(r, i);
+   }
+   return r;
+}
+
+
+// Returns the correctly rounded sum of n terms if the estimate proves it. All terms added to the
+// compensation are exact rounding errors, except for errors of products in the subnormal range,
+// which are rounded by less than 2 * denorm_min. The compensation is the sum of at most 4 * n
+// such terms, hence its error is less than 4 * n * u times the sum of their absolute values for
+// n * u < 2^-10, which is doubled to account for the rounding of the bound.
+template <Floating T, Floating W>
+std::optional<Strict<T>> certify_rounding(const ExactEstimate<W>& r, index_t n) {
+   const auto nu = Strict<W>{W(n.val())} * constants::epsilon<W> / Strict<W>{W(2)};
+   if(!(nu < Strict<W>{W(0x1p-10)}) || !isfinites(r.error)) {
+      return std::nullopt;
+   }
+
+   const auto [hi, lo] = two_sums(r.sum.first, r.sum.second);
+   const auto x = strict_cast<T>(hi);
+   if(!isfinites(hi) || !isfinites(x)) {
+      return std::nullopt;
    }
 
-   if(sb.empty()) {
-      return r;
+   const auto bound = Strict<W>{W(8)} * nu * r.error
+                    + Strict<W>{W(2) * W(n.val()) * FloatTraits<W>::denorm_min()};
+   const auto d = (hi - strict_cast<W>(x)) + lo;
+   const auto half_gap = Strict<W>{W(gap_below(x.val()))} * Strict<W>{W(0.5) - W(0x1p-10)};
+   if(abss(d) + bound < half_gap) {
+      return x;
+   }
+   return std::nullopt;
+}
+
+
+template <FloatingBaseType Base>
+LongAccumulator<RealTypeOf<Base>> exact_sum_accumulate(const Base& A, index_t first,
+                                                       index_t last) {
+   LongAccumulator<RealTypeOf<Base>> acc;
+   for(index_t i = first; i < last; ++i) {
+      acc.add(A.un(i));
+   }
+   return acc;
+}
+
+
+template <FloatingBaseType Base1, FloatingBaseType Base2>
+LongAccumulator<RealTypeOf<Base1>> exact_dot_prod_accumulate(const Base1& A1, const Base2& A2,
+                                                             index_t first, index_t last) {
+   LongAccumulator<RealTypeOf<Base1>> acc;
+   for(index_t i = first; i < last; ++i) {
+      acc.add_product(A1.un(i), A2.un(i));
+   }
+   return acc;
+}
+
+
+// Accumulators are exact, hence each thread accumulates the terms of its contiguous range, and
+// the accumulators of threads are merged in place in any order. Memory is proportional to the
+// number of threads rather than to the number of terms.
+template <Floating T, typename F>
+LongAccumulator<T> parallel_accumulate(index_t n, F accumulate, bool parallel) {
+   if(!parallel || in_parallel_region || execution.threads() == 1_sl) {
+      return accumulate(0_sl, n);
+   }
+   LongAccumulator<T> total;
+   std::mutex m;
+   parallel_for(n, cache_line_elements<T>(), [&](index_t first, index_t last) {
+      const auto acc = accumulate(first, last);
+      std::lock_guard lock{m};
+      total.merge(acc);
+   });
+   return total;
+}
+
+
+} // namespace detail
+
+
+template <FloatingBaseType Base>
+ValueTypeOf<Base> stable_sum(const Base& A, ValueTypeOf<Base> empty_default) {
+   STRICT_PROFILE_SCOPE("stable/stable_sum");
+   if(A.empty()) {
+      return empty_default;
    }
 
-   return stable_sum(sb) + r;
+   const auto [s, c] = detail::parallel_reduce<detail::CompensatedState<RealTypeOf<Base>>>(
+      A.size(),
+      [&A](index_t first, index_t last) { return detail::compensated_sum(A, first, last); },
+      [](const auto& x, const auto& y) { return detail::merge_compensated(x, y); },
+      detail::use_parallel_reduction(A));
+   return s + c;
+}
+
+
+template <FloatingBaseType Base>
+ValueTypeOf<Base> semi_stable_sum(const Base& A, ValueTypeOf<Base> empty_default) {
+   return sum(A, PairwiseSum, empty_default);
 }
 
 
@@ -182,20 +512,20 @@ template <FloatingBaseType Base1, FloatingBaseType Base2>
    requires(same_dimension_b<Base1, Base2>())
 ValueTypeOf<Base1> stable_dot_prod(const Base1& A1, const Base2& A2,
                                    ValueTypeOf<Base1> empty_default) {
+   STRICT_PROFILE_SCOPE("stable/stable_dot_prod");
    ASSERT_STRICT_DEBUG(same_size(A1, A2));
    if(A1.empty()) {
       return empty_default;
    }
 
-   auto [p, s] = two_prods(A1.un(0), A2.un(0));
-   decltype(p) q;
-   for(index_t i = 1_sl; i < A1.size(); ++i) {
-      auto [h, r] = two_prods(A1.un(i), A2.un(i));
-      std::tie(p, q) = two_sums(p, h);
-      s = s + (q + r);
-   }
-
-   return p + s;
+   auto dot_prod = [&A1, &A2](index_t first, index_t last) {
+      return detail::compensated_dot_prod(A1, A2, first, last);
+   };
+   const auto [s, c] = detail::parallel_reduce<detail::CompensatedState<RealTypeOf<Base1>>>(
+      A1.size(), dot_prod,
+      [](const auto& x, const auto& y) { return detail::merge_compensated(x, y); },
+      detail::use_parallel_reduction(A1) && detail::use_parallel_reduction(A2));
+   return s + c;
 }
 
 
@@ -211,6 +541,71 @@ ValueTypeOf<Base1> semi_stable_dot_prod(const Base1& A1, const Base2& A2,
 }
 
 
+// Results are correctly rounded, i.e. equal to the exact results rounded to nearest, and do not
+// depend on the order of elements. Zero results are positive.
+template <FloatingBaseType Base>
+ValueTypeOf<Base> exact_sum(const Base& A, ValueTypeOf<Base> empty_default) {
+   STRICT_PROFILE_SCOPE("stable/exact_sum");
+   if(A.empty()) {
+      return empty_default;
+   }
+
+   using T = RealTypeOf<Base>;
+   using W = detail::ExactWorkType<T>;
+   const bool parallel = detail::use_parallel_reduction(A);
+   // Expressions that cannot be copied generate random values, hence they are only evaluated once.
+   if constexpr(std::is_copy_constructible_v<Base>) {
+      const auto estimate = detail::parallel_reduce<detail::ExactEstimate<W>>(
+         A.size(),
+         [&A](index_t first, index_t last) { return detail::exact_sum_estimate(A, first, last); },
+         [](const auto& x, const auto& y) { return detail::merge_estimates(x, y); }, parallel);
+      if(const auto x = detail::certify_rounding<T>(estimate, A.size())) {
+         return *x;
+      }
+   }
+
+   return detail::parallel_accumulate<T>(
+             A.size(),
+             [&A](index_t first, index_t last) {
+                return detail::exact_sum_accumulate(A, first, last);
+             },
+             parallel)
+      .result();
+}
+
+
+template <FloatingBaseType Base1, FloatingBaseType Base2>
+   requires(same_dimension_b<Base1, Base2>())
+ValueTypeOf<Base1> exact_dot_prod(const Base1& A1, const Base2& A2,
+                                  ValueTypeOf<Base1> empty_default) {
+   STRICT_PROFILE_SCOPE("stable/exact_dot_prod");
+   ASSERT_STRICT_DEBUG(same_size(A1, A2));
+   if(A1.empty()) {
+      return empty_default;
+   }
+
+   using T = RealTypeOf<Base1>;
+   using W = detail::ExactWorkType<T>;
+   const bool parallel = detail::use_parallel_reduction(A1) && detail::use_parallel_reduction(A2);
+   if constexpr(std::is_copy_constructible_v<Base1> && std::is_copy_constructible_v<Base2>) {
+      auto dot_prod = [&A1, &A2](index_t first, index_t last) {
+         return detail::exact_dot_prod_estimate(A1, A2, first, last);
+      };
+      const auto estimate = detail::parallel_reduce<detail::ExactEstimate<W>>(
+         A1.size(), dot_prod,
+         [](const auto& x, const auto& y) { return detail::merge_estimates(x, y); }, parallel);
+      if(const auto x = detail::certify_rounding<T>(estimate, A1.size())) {
+         return *x;
+      }
+   }
+
+   auto dot_prod = [&A1, &A2](index_t first, index_t last) {
+      return detail::exact_dot_prod_accumulate(A1, A2, first, last);
+   };
+   return detail::parallel_accumulate<T>(A1.size(), dot_prod, parallel).result();
+}
+
+
 template <FloatingBaseType Base>
 ValueTypeOf<Base> stable_norm1(const Base& A, ValueTypeOf<Base> empty_default) {
    if(A.empty()) {
@@ -231,6 +626,7 @@ ValueTypeOf<Base> stable_norm1_scaled(const Base& A, ValueTypeOf<Base> empty_def
 
 template <FloatingBaseType Base>
 ValueTypeOf<Base> stable_norm2(const Base& A, ValueTypeOf<Base> empty_default) {
+   STRICT_PROFILE_SCOPE("stable/stable_norm2");
    if(A.empty()) {
       return empty_default;
    }
@@ -0,0 +1,338 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include "ArrayCommon/text_parser.hpp"
+#include "StrictCommon/strict_common.hpp"
+#include "Util/profiler.hpp"
+#include "array_binary_IO.hpp"
+#include "array_npy_IO.hpp"
+#include "array_ops.hpp"
+#include "array_reduce.hpp"
+#include "derived1D.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+
+namespace spp {
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Sequential access to arrays stored in files that do not fit in memory. The elements are read
+// in chunks of chunk_size elements(the last chunk may be smaller) into one of two buffers that
+// are reused, and the next chunk is read by another thread while the current one is processed.
+// The format is detected from the contents of the file: binary files(see save_binary) and .npy
+// files are read in storage order, other files are read as text(see read_from_file and
+// read_from_csv), ignoring rows. The checksum of binary files is verified after the last chunk
+// if the number of bytes of chunks is a multiple of 8.
+template <Builtin T>
+class STRICT_NODISCARD ChunkedSource {
+public:
+   // Values of text files are separated by the delimiter and optional whitespace, or by
+   // whitespace if the delimiter is '\0'.
+   explicit ChunkedSource(const std::string& file_path, ImplicitInt chunk_size,
+                          char delimiter = '\0')
+       : ifs_{file_path, std::ios::binary},
+         chunk_size_{chunk_size.get()},
+         delimiter_{delimiter} {
+      ASSERT_STRICT_ALWAYS_MSG(ifs_, "Invalid file path.\n");
+      ASSERT_STRICT_ALWAYS_MSG(chunk_size_ > 0_sl, "Chunk size must be positive.\n");
+      if(delimiter_ != '\0') {
+         detail::validate_delimiter(delimiter_);
+      }
+
+      std::array<char, detail::binary_magic.size()> magic{};
+      ifs_.read(magic.data(), std::streamsize(magic.size()));
+      const auto n = static_cast<std::size_t>(ifs_.gcount());
+      ifs_.clear();
+      ifs_.seekg(0);
+      if(n >= detail::npy_magic.size()
+         && std::memcmp(magic.data(), detail::npy_magic.data(), detail::npy_magic.size()) == 0) {
+         format_ = Format::npy;
+         header_ = detail::decode_npy_header(detail::read_npy_preamble(ifs_));
+      } else if(n == magic.size() && magic == detail::binary_magic) {
+         format_ = Format::binary;
+         header_ = detail::read_binary_header(ifs_);
+      }
+
+      if(format_ != Format::text) {
+         ASSERT_STRICT_ALWAYS_MSG(header_.has_type<T>(),
+                                  "Type of elements of file does not match.\n");
+         data_offset_ = ifs_.tellg();
+      }
+   }
+
+   ChunkedSource(const ChunkedSource&) = delete;
+   ChunkedSource& operator=(const ChunkedSource&) = delete;
+
+   STRICT_NODISCARD index_t chunk_size() const {
+      return chunk_size_;
+   }
+
+   // Calls f(chunk, offset) for consecutive chunks, where chunk is a const Array1D<T>& and
+   // offset is the index of its first element. The reference is only valid during the call.
+   // Every call starts from the beginning of the file.
+   template <typename F>
+   void for_each_chunk(F f) {
+      STRICT_PROFILE_SCOPE("stream/for_each_chunk");
+      this->rewind();
+      index_t offset = 0_sl;
+      auto pending = std::async(std::launch::async, [this] { this->read(buffers_[0]); });
+      for(std::size_t k = 0;; k ^= 1) {
+         pending.get();
+         if(buffers_[k].empty()) {
+            break;
+         }
+         pending = std::async(std::launch::async, [this, k] { this->read(buffers_[k ^ 1]); });
+         f(std::as_const(buffers_[k]), offset);
+         offset += buffers_[k].size();
+      }
+   }
+
+private:
+   enum Format { text, binary, npy };
+
+   std::ifstream ifs_;
+   index_t chunk_size_;
+   char delimiter_;
+   Format format_ = Format::text;
+   detail::BinaryHeader header_;
+   std::streampos data_offset_{};
+   std::array<Array1D<T>, 2> buffers_;
+
+   // Binary and .npy files.
+   std::uint64_t remaining_ = 0;
+   std::uint64_t checksum_ = 0;
+
+   // Text files, characters and values that follow the previous chunk.
+   std::string text_;
+   std::vector<Strict<T>> values_;
+   std::size_t first_value_ = 0;
+   bool after_delimiter_ = false;
+   bool eof_ = false;
+
+   void rewind() {
+      ifs_.clear();
+      ifs_.seekg(format_ == Format::text ? std::streampos{} : data_offset_);
+      remaining_ = static_cast<std::uint64_t>(header_.rows * header_.cols);
+      checksum_ = detail::binary_checksum(nullptr, 0);
+      text_.clear();
+      values_.clear();
+      first_value_ = 0;
+      after_delimiter_ = false;
+      eof_ = false;
+   }
+
+   void read(Array1D<T>& A) {
+      if(format_ == Format::text) {
+         this->read_text(A);
+      } else {
+         this->read_binary(A);
+      }
+   }
+
+   void read_binary(Array1D<T>& A) {
+      const auto n = std::min(remaining_, static_cast<std::uint64_t>(chunk_size_.val()));
+      A.resize(static_cast<long int>(n), uninitialized, false);
+      detail::BinaryHeader h = header_;
+      h.rows = A.size().val();
+      h.cols = 1;
+      detail::read_elements(ifs_, h, A.data());
+      remaining_ -= n;
+
+      if(format_ == Format::binary && chunk_size_.val() * long(sizeof(T)) % 8 == 0) {
+         checksum_ = detail::binary_checksum(A.data(), h.bytes(), checksum_);
+         if(remaining_ == 0) {
+            ASSERT_STRICT_ALWAYS_MSG(checksum_ == header_.checksum,
+                                     "Checksum mismatch, binary file is corrupted.\n");
+         }
+      }
+      if(!header_.native_order()) {
+         detail::swap_bytes(A.data(), A.size().val());
+      }
+   }
+
+   void read_text(Array1D<T>& A) {
+      constexpr std::size_t block = 1 << 20;
+      const auto chunk_size = static_cast<std::size_t>(chunk_size_.val());
+      while(values_.size() - first_value_ < chunk_size && !eof_) {
+         const std::size_t size = text_.size();
+         text_.resize(size + block);
+         ifs_.read(text_.data() + size, std::streamsize(block));
+         text_.resize(size + static_cast<std::size_t>(ifs_.gcount()));
+         eof_ = text_.size() == size;
+
+         // Values are parsed up to the last separator, the rest is kept for the next block.
+         // Separators are newlines and delimiters(blanks if there is no delimiter), so that long
+         // lines are split as well. A delimiter at the end of the block is not parsed, and the
+         // value that follows it is required at the beginning of the next block instead.
+         std::size_t last = text_.size();
+         bool delimited = false;
+         if(!eof_) {
+            auto separator = [this](char c) {
+               return c == '\n' || (delimiter_ == '\0' ? detail::is_blank(c) : c == delimiter_);
+            };
+            auto it = std::find_if(text_.rbegin(), text_.rend(), separator);
+            last = static_cast<std::size_t>(text_.rend() - it);
+            delimited = last > 0 && delimiter_ != '\0' && text_[last - 1] == delimiter_;
+         }
+         if(last == 0 && !eof_) {
+            continue;
+         }
+
+         const char* first = text_.data();
+         if(after_delimiter_) {
+            first = detail::skip_blanks(first, text_.data() + last);
+            ASSERT_STRICT_ALWAYS_MSG(first != text_.data() + last && *first != '\n',
+                                     "Invalid input.\n");
+         }
+         values_.erase(values_.begin(), values_.begin() + long(first_value_));
+         first_value_ = 0;
+         const auto chunk = detail::parse_chunk<T>(first, text_.data() + last - (delimited ? 1 : 0),
+                                                   delimiter_, false);
+         values_.insert(values_.end(), chunk.values.begin(), chunk.values.end());
+         text_.erase(0, last);
+         after_delimiter_ = delimited;
+      }
+
+      const auto n = std::min(values_.size() - first_value_, chunk_size);
+      A.resize(static_cast<long int>(n), uninitialized, false);
+      std::copy_n(values_.begin() + long(first_value_), n, A.data());
+      first_value_ += n;
+   }
+};
+
+
+// Functions below reduce f(chunk) for all chunks of the source, e.g. sum(source) is the sum of
+// all elements and norm2(source, [](const auto& x) { return x - 1._sd; }) is the Euclidean norm
+// of the elements minus one. The results of min_index and max_index contain global indexes.
+template <Real T, typename F = std::identity>
+auto sum(ChunkedSource<T>& source, F f = {});
+
+
+template <Real T, typename F = std::identity>
+auto stable_sum(ChunkedSource<T>& source, F f = {});
+
+
+template <Real T, typename F = std::identity>
+auto norm2(ChunkedSource<T>& source, F f = {});
+
+
+template <Real T, typename F = std::identity>
+auto min_index(ChunkedSource<T>& source, F f = {});
+
+
+template <Real T, typename F = std::identity>
+auto max_index(ChunkedSource<T>& source, F f = {});
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Reduces f(chunk) for all chunks of the source by all operations(see array_reduce.hpp) and
+// returns the tuple of their results. States of chunks are merged in order, hence the results
+// may differ from the ones of the whole array by rounding, but do not depend on the timing of
+// reads. Under ReproducibleSum(see sum_flag.hpp), sums are the same as the ones of the whole
+// array for any size of chunks. f must return a one-dimensional object of the same size as the
+// chunk, e.g. an expression of the chunk.
+template <Builtin T, typename F, typename... Ops>
+   requires(sizeof...(Ops) > 0)
+auto reduce_many(ChunkedSource<T>& source, F f, Ops... ops) {
+   STRICT_PROFILE_SCOPE("stream/reduce_many");
+   using R = RealTypeOf<std::invoke_result_t<F&, const Array1D<T>&>>;
+   using States = std::tuple<detail::ReduceStateOf<Ops, R>...>;
+   std::tuple<Ops...> op_tuple{ops...};
+   std::optional<States> states;
+   index_t n = 0_sl;
+
+   source.for_each_chunk([&](const Array1D<T>& chunk, index_t) {
+      const auto& E = f(chunk);
+      ASSERT_STRICT_ALWAYS_MSG(E.size() == chunk.size(),
+                               "Expression of chunk must have the same size as the chunk.\n");
+      auto s = detail::reduce_states(E, op_tuple);
+      if(!states) {
+         states = std::move(s);
+      } else {
+         detail::for_each_state(
+            *states, [&](auto I, auto& x) { std::get<I>(op_tuple).merge(x, std::get<I>(s)); });
+      }
+      n += chunk.size();
+   });
+
+   if(!states) {
+      return std::make_tuple(ops.template empty<R>()...);
+   }
+   return [&]<std::size_t... I>(std::index_sequence<I...>) {
+      return std::make_tuple(std::get<I>(op_tuple).result(std::get<I>(*states), n)...);
+   }(std::index_sequence_for<Ops...>{});
+}
+
+
+template <Real T, typename F>
+auto sum(ChunkedSource<T>& source, F f) {
+   return std::get<0>(reduce_many(source, f, sum_op{}));
+}
+
+
+template <Real T, typename F>
+auto stable_sum(ChunkedSource<T>& source, F f) {
+   return std::get<0>(reduce_many(source, f, stable_sum_op{}));
+}
+
+
+template <Real T, typename F>
+auto norm2(ChunkedSource<T>& source, F f) {
+   return std::get<0>(reduce_many(source, f, norm2_op{}));
+}
+
+
+namespace detail {
+
+
+// Indexes are global, the first index is kept in case of ties.
+template <Real T, typename F, typename G>
+auto chunked_index(ChunkedSource<T>& source, F f, G chunk_index, bool less) {
+   using E = std::invoke_result_t<F&, const Array1D<T>&>;
+   std::pair<index_t, ValueTypeOf<E>> result{-1_sl, {}};
+   source.for_each_chunk([&](const Array1D<T>& chunk, index_t offset) {
+      const auto& E = f(chunk);
+      ASSERT_STRICT_ALWAYS_MSG(E.size() == chunk.size(),
+                               "Expression of chunk must have the same size as the chunk.\n");
+      const auto [i, x] = chunk_index(E);
+      if(result.first == -1_sl || (less ? x < result.second : x > result.second)) {
+         result = {i + offset, x};
+      }
+   });
+   return result;
+}
+
+
+} // namespace detail
+
+
+template <Real T, typename F>
+auto min_index(ChunkedSource<T>& source, F f) {
+   return detail::chunked_index(
+      source, f, [](const auto& E) { return min_index(E); }, true);
+}
+
+
+template <Real T, typename F>
+auto max_index(ChunkedSource<T>& source, F f) {
+   return detail::chunked_index(
+      source, f, [](const auto& E) { return max_index(E); }, false);
+}
+
+
+} // namespace spp
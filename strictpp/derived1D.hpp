@@ -406,6 +406,12 @@ public:
    STRICT_CONSTEXPR static StrictBool is_fixed() {
       return !is_dynamic();
    }
+
+   ////////////////////////////////////////////////////////////////////////////////////////////////////
+   // Evaluates the right-hand side of an assignment in parallel, e.g. A.par() = B + C.
+   auto par() & {
+      return detail::ParallelAssign<StrictArray1D>{*this};
+   }
 };
 
 
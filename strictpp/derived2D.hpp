@@ -29,8 +29,8 @@ template <typename Base>
 class StrictArray2D;
 
 
-template <Builtin T, AlignmentFlag AF = Unaligned>
-using Array2D = StrictArray2D<detail::ArrayBase2D<T, AF>>;
+template <Builtin T, AlignmentFlag AF = Unaligned, LayoutFlag LF = RowMajor>
+using Array2D = StrictArray2D<detail::ArrayBase2D<T, AF, LF>>;
 
 
 template <Builtin T, ImplicitIntStatic M, ImplicitIntStatic N, AlignmentFlag AF = Unaligned>
@@ -216,8 +216,12 @@ public:
       using namespace detail;
       auto ih = index_row_helper(*this, i);
       ASSERT_STRICT_DEBUG(valid_row(*this, ih));
-      auto first = ih * Base::cols();
-      return this->view1D()(seq{first, first + Base::cols() - 1_sl, 1});
+      if constexpr(ColMajorArrayType<Base>) {
+         return this->storage_view(seqN{ih, Base::cols(), Base::rows()});
+      } else {
+         auto first = ih * Base::cols();
+         return this->view1D()(seq{first, first + Base::cols() - 1_sl, 1});
+      }
    }
 
    template <IndexType Index>
@@ -225,17 +229,25 @@ public:
       using namespace detail;
       auto jh = index_col_helper(*this, j);
       ASSERT_STRICT_DEBUG(valid_col(*this, jh));
-      auto first = jh;
-      auto lst = first + (Base::rows() - 1_sl) * Base::cols();
-      return this->view1D()(seq{first, lst, Base::cols()});
+      if constexpr(ColMajorArrayType<Base>) {
+         return this->storage_view(seqN{jh * Base::rows(), Base::rows(), 1});
+      } else {
+         auto first = jh;
+         auto lst = first + (Base::rows() - 1_sl) * Base::cols();
+         return this->view1D()(seq{first, lst, Base::cols()});
+      }
    }
 
    STRICT_CONSTEXPR auto diag() & {
-      return this->view1D()(seqN{0, mins(Base::rows(), Base::cols()), Base::cols() + 1_sl});
+      return this->diag(0);
    }
 
    STRICT_CONSTEXPR auto diag(ImplicitInt i) & {
-      return this->view1D()(this->diag_slice_impl(i));
+      if constexpr(detail::ColMajorArrayType<Base>) {
+         return this->storage_view(this->diag_slice_impl(i));
+      } else {
+         return this->view1D()(this->diag_slice_impl(i));
+      }
    }
 
    STRICT_CONSTEXPR auto view1D() & {
@@ -260,8 +272,12 @@ public:
       using namespace detail;
       auto ih = index_row_helper(*this, i);
       ASSERT_STRICT_DEBUG(valid_row(*this, ih));
-      auto first = ih * Base::cols();
-      return this->view1D()(seq{first, first + Base::cols() - 1_sl, 1});
+      if constexpr(ColMajorArrayType<Base>) {
+         return this->storage_view(seqN{ih, Base::cols(), Base::rows()});
+      } else {
+         auto first = ih * Base::cols();
+         return this->view1D()(seq{first, first + Base::cols() - 1_sl, 1});
+      }
    }
 
    template <IndexType Index>
@@ -269,17 +285,25 @@ public:
       using namespace detail;
       auto jh = index_col_helper(*this, j);
       ASSERT_STRICT_DEBUG(valid_col(*this, jh));
-      auto first = jh;
-      auto lst = first + (Base::rows() - 1_sl) * Base::cols();
-      return this->view1D()(seq{first, lst, Base::cols()});
+      if constexpr(ColMajorArrayType<Base>) {
+         return this->storage_view(seqN{jh * Base::rows(), Base::rows(), 1});
+      } else {
+         auto first = jh;
+         auto lst = first + (Base::rows() - 1_sl) * Base::cols();
+         return this->view1D()(seq{first, lst, Base::cols()});
+      }
    }
 
    STRICT_CONSTEXPR auto diag() const& {
-      return this->view1D()(seqN{0, mins(Base::rows(), Base::cols()), Base::cols() + 1_sl});
+      return this->diag(0);
    }
 
    STRICT_CONSTEXPR auto diag(ImplicitInt i) const& {
-      return this->view1D()(this->diag_slice_impl(i));
+      if constexpr(detail::ColMajorArrayType<Base>) {
+         return this->storage_view(this->diag_slice_impl(i));
+      } else {
+         return this->view1D()(this->diag_slice_impl(i));
+      }
    }
 
    STRICT_CONSTEXPR auto view1D() const& {
@@ -631,17 +655,39 @@ public:
    }
 
 private:
+   // Positions of diagonal elements in memory.
    STRICT_CONSTEXPR auto diag_slice_impl(ImplicitInt i) const {
+      constexpr bool row_major = !detail::ColMajorArrayType<Base>;
+      const auto ld = row_major ? Base::cols() : Base::rows();
       if(i.get() >= 0_sl) {
          ASSERT_STRICT_DEBUG(i.get() < Base::cols());
-         return seqN{i, mins(Base::rows(), Base::cols() - i.get()), Base::cols() + 1_sl};
+         return seqN{row_major ? i.get() : i.get() * ld,
+                     mins(Base::rows(), Base::cols() - i.get()),
+                     ld + 1_sl};
       } else {
          ASSERT_STRICT_DEBUG(abss(i.get()) < Base::rows());
-         return seqN{abss(i.get()) * Base::cols(),
+         return seqN{row_major ? abss(i.get()) * ld : abss(i.get()),
                      mins(Base::rows() - abss(i.get()), Base::cols()),
-                     Base::cols() + 1_sl};
+                     ld + 1_sl};
       }
    }
+
+   // Views of the storage of column-major arrays, which are contiguous for columns.
+   STRICT_CONSTEXPR auto storage_view(seqN sl) & {
+      using namespace detail;
+      using Storage = RemoveCVRef<decltype(Base::storage())>;
+      if constexpr(NonConstBaseType<Base>) {
+         return StrictArrayMutable1D<SliceArrayBase1D<Storage, seqN>>{Base::storage(), sl};
+      } else {
+         return StrictArrayBase1D<ConstSliceArrayBase1D<Storage, seqN>>{Base::storage(), sl};
+      }
+   }
+
+   STRICT_CONSTEXPR auto storage_view(seqN sl) const& {
+      using namespace detail;
+      using Storage = RemoveCVRef<decltype(Base::storage())>;
+      return StrictArrayBase1D<ConstSliceArrayBase1D<Storage, seqN>>{Base::storage(), sl};
+   }
 };
 
 
@@ -777,6 +823,12 @@ public:
    STRICT_CONSTEXPR static StrictBool is_fixed() {
       return !is_dynamic();
    }
+
+   ////////////////////////////////////////////////////////////////////////////////////////////////////
+   // Evaluates the right-hand side of an assignment in parallel, e.g. A.par() = B + C.
+   auto par() & {
+      return detail::ParallelAssign<StrictArray2D>{*this};
+   }
 };
 
 
@@ -6,6 +6,7 @@
 
 #include "ArrayCommon/array_auxiliary.hpp"
 #include "ArrayCommon/array_traits.hpp"
+#include "ArrayCommon/parallel.hpp"
 #include "StrictCommon/strict_common.hpp"
 
 
@@ -208,4 +209,45 @@ public:
 };
 
 
+// Returned by par() so that the right-hand side of an assignment, e.g. A.par() = B + C,
+// is evaluated in parallel regardless of spp::execution.
+template <typename Base>
+class STRICT_NODISCARD ParallelAssign {
+public:
+   STRICT_NODISCARD explicit ParallelAssign(Base& A) : A_{A} {
+   }
+
+   ParallelAssign(const ParallelAssign&) = delete;
+   ParallelAssign& operator=(const ParallelAssign&) = delete;
+
+   Base& operator=(const auto& x) && {
+      ParallelGuard guard;
+      return A_ = x;
+   }
+
+   Base& operator+=(const auto& x) && {
+      ParallelGuard guard;
+      return A_ += x;
+   }
+
+   Base& operator-=(const auto& x) && {
+      ParallelGuard guard;
+      return A_ -= x;
+   }
+
+   Base& operator*=(const auto& x) && {
+      ParallelGuard guard;
+      return A_ *= x;
+   }
+
+   Base& operator/=(const auto& x) && {
+      ParallelGuard guard;
+      return A_ /= x;
+   }
+
+private:
+   Base& A_;
+};
+
+
 } // namespace spp::detail
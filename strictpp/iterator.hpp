@@ -592,7 +592,7 @@ STRICT_NODISCARD_CONSTEXPR auto ConstIterator<Base, F>::operator->() const {
    if constexpr(std::is_lvalue_reference_v<decltype(f_(pos_))>) {
       return &(f_(pos_));
    } else {
-      static_assert(false, "Taking the address of a temporary object.");
+      static_assert(!sizeof(F), "Taking the address of a temporary object.");
       return;
    }
 }
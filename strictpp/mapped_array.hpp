@@ -0,0 +1,158 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include "ArrayCommon/layout.hpp"
+#include "StrictCommon/strict_common.hpp"
+#include "Util/file_mapping.hpp"
+#include "array_binary_IO.hpp"
+#include "array_npy_IO.hpp"
+#include "attach1D.hpp"
+#include "attach2D.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+
+#ifdef STRICT_HAS_MMAP
+namespace spp {
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Read-only memory mapping of an array stored in a binary file(see save_binary), an .npy file,
+// or a member of an uncompressed .npz archive(see save_npy and NpzWriter). Views are non-owning
+// arrays(see attach1D and attach2D) whose elements are read from the mapped file without being
+// copied, hence they must not outlive the mapping. The type of elements must match the one of
+// the file, and elements must be stored in the native byte order and be aligned. This is always
+// the case for files written by strictpp on the same platform, but not necessarily for members
+// of archives written by NumPy; load_binary, load_npy, and load_npz read such files instead.
+template <Builtin T>
+class STRICT_NODISCARD MappedArray {
+public:
+   // Binary or .npy file, the format is detected from the contents of the file.
+   explicit MappedArray(const std::string& file_path) : map_{file_path} {
+      const auto* p = map_.data();
+      if(map_.size() >= detail::npy_magic.size()
+         && std::memcmp(p, detail::npy_magic.data(), detail::npy_magic.size()) == 0) {
+         format_ = Format::npy;
+         this->init_npy();
+      } else {
+         ASSERT_STRICT_ALWAYS_MSG(map_.size() >= detail::binary_header_size,
+                                  "Not a strictpp binary file.\n");
+         header_ = detail::decode_header(p);
+         member_offset_ = 0;
+         offset_ = detail::binary_header_size;
+         this->check();
+      }
+   }
+
+   // Array of the given name in .npz archive.
+   explicit MappedArray(const std::string& file_path, const std::string& name)
+      : map_{file_path}, format_{Format::npz} {
+      auto read_at = [this](std::uint64_t offset, std::uint64_t n) {
+         return map_.read_at(offset, n);
+      };
+      const auto entries = detail::read_zip_directory(map_.size(), read_at);
+      const auto& e = detail::find_npz_member(entries, name);
+      member_offset_ = detail::zip_data_offset(e, read_at);
+      this->init_npy();
+      header_.checksum = e.crc;
+   }
+
+   STRICT_NODISCARD index_t dims() const {
+      return index_t{long(header_.dims)};
+   }
+
+   STRICT_NODISCARD index_t rows() const {
+      return index_t{header_.rows};
+   }
+
+   STRICT_NODISCARD index_t cols() const {
+      return index_t{header_.cols};
+   }
+
+   STRICT_NODISCARD index_t size() const {
+      return index_t{header_.rows * header_.cols};
+   }
+
+   STRICT_NODISCARD LayoutFlag layout() const {
+      return header_.layout;
+   }
+
+   // Compares the checksum stored in the file with the one of the mapped bytes, which reads
+   // the whole file. Not available for .npy files, which have no checksum.
+   STRICT_NODISCARD StrictBool verify() const {
+      ASSERT_STRICT_ALWAYS_MSG(format_ != Format::npy, "npy files have no checksum.\n");
+      if(format_ == Format::binary) {
+         return StrictBool{detail::binary_checksum(this->data(), header_.bytes())
+                           == header_.checksum};
+      }
+      const auto bytes = offset_ - member_offset_ + header_.bytes();
+      return StrictBool{detail::crc32(0, map_.data() + member_offset_, bytes)
+                        == header_.checksum};
+   }
+
+   STRICT_NODISCARD const T* data() const {
+      return reinterpret_cast<const T*>(map_.data() + offset_);
+   }
+
+   // Elements in storage order.
+   STRICT_NODISCARD auto view1D() const& {
+      const T* p = this->data();
+      return attach1D(p, this->size());
+   }
+
+   // Only row-major files can be viewed as two-dimensional arrays.
+   STRICT_NODISCARD auto view2D() const& {
+      ASSERT_STRICT_ALWAYS_MSG(header_.dims == 2 && header_.layout == RowMajor,
+                               "Only row-major two-dimensional files can be viewed by view2D.\n");
+      const T* p = this->data();
+      return attach2D(p, this->rows(), this->cols());
+   }
+
+   void view1D() const&& = delete;
+   void view2D() const&& = delete;
+
+private:
+   enum Format { binary, npy, npz };
+
+   detail::FileMapping map_;
+   Format format_ = Format::binary;
+   detail::BinaryHeader header_;
+   // Offsets of the data of the array(the header for binary and .npy files) and of the elements.
+   std::size_t member_offset_ = 0;
+   std::size_t offset_ = 0;
+
+   void init_npy() {
+      ASSERT_STRICT_ALWAYS_MSG(member_offset_ <= map_.size() && map_.size() - member_offset_ >= 12,
+                               "File is truncated.\n");
+      const auto* p = map_.data() + member_offset_;
+      const auto size = detail::npy_preamble_size(p);
+      ASSERT_STRICT_ALWAYS_MSG(size >= 12 && size <= map_.size() - member_offset_,
+                               "File is truncated.\n");
+      header_ = detail::decode_npy_header({reinterpret_cast<const char*>(p), size});
+      offset_ = member_offset_ + size;
+      this->check();
+   }
+
+   void check() const {
+      ASSERT_STRICT_ALWAYS_MSG(header_.has_type<T>(),
+                               "Type of elements of mapped file does not match.\n");
+      ASSERT_STRICT_ALWAYS_MSG(header_.native_order(),
+                               "Elements of mapped file are not in native byte order.\n");
+      ASSERT_STRICT_ALWAYS_MSG(offset_ % alignof(T) == 0,
+                               "Elements of mapped file are not aligned.\n");
+      ASSERT_STRICT_ALWAYS_MSG(header_.valid_sizes(), "Corrupted header of mapped file.\n");
+      ASSERT_STRICT_ALWAYS_MSG(offset_ <= map_.size() && header_.bytes() <= map_.size() - offset_,
+                               "File is truncated.\n");
+   }
+};
+
+
+} // namespace spp
+#endif
@@ -0,0 +1,347 @@
+// Arkadijs Slobodkins, 2023
+
+
+#pragma once
+
+
+#include "ArrayCommon/array_common.hpp"
+#include "StrictCommon/strict_common.hpp"
+#include "Util/profiler.hpp"
+#include "derived1D.hpp"
+#include "derived2D.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+
+// Matrix products of arrays, slices, and their expression templates. The Eigen versions of the
+// same functions are provided in namespace spp::eigen if STRICT_ENABLE_EIGEN is defined.
+namespace spp {
+
+
+// Computes C = A * B. C must not overlap A or B.
+template <TwoDimRealBaseType Base1, TwoDimRealBaseType Base2, typename Base3>
+   requires(detail::TwoDimNonConstBaseType<RemoveRef<Base3>> && !detail::ArrayTypeRvalue<Base3>
+            && SameAs<BuiltinTypeOf<Base1>, BuiltinTypeOf<Base2>>
+            && SameAs<BuiltinTypeOf<Base1>, BuiltinTypeOf<Base3>>)
+STRICT_CONSTEXPR void matrix_prod(const Base1& A, const Base2& B, Base3&& C);
+
+
+template <TwoDimRealBaseType Base1, TwoDimRealBaseType Base2>
+   requires(SameAs<BuiltinTypeOf<Base1>, BuiltinTypeOf<Base2>>)
+STRICT_CONSTEXPR Array2D<BuiltinTypeOf<Base1>> matrix_prod(const Base1& A, const Base2& B);
+
+
+// Computes y = A * x. y must not overlap A or x.
+template <TwoDimRealBaseType Base1, OneDimRealBaseType Base2, typename Base3>
+   requires(detail::NonConstBaseType<RemoveRef<Base3>> && OneDimBaseType<RemoveRef<Base3>>
+            && !detail::ArrayTypeRvalue<Base3>
+            && SameAs<BuiltinTypeOf<Base1>, BuiltinTypeOf<Base2>>
+            && SameAs<BuiltinTypeOf<Base1>, BuiltinTypeOf<Base3>>)
+STRICT_CONSTEXPR void matrix_vector_prod(const Base1& A, const Base2& x, Base3&& y);
+
+
+template <TwoDimRealBaseType Base1, OneDimRealBaseType Base2>
+   requires(SameAs<BuiltinTypeOf<Base1>, BuiltinTypeOf<Base2>>)
+STRICT_CONSTEXPR Array1D<BuiltinTypeOf<Base1>> matrix_vector_prod(const Base1& A,
+                                                                  const Base2& x);
+
+
+namespace detail {
+
+
+// Blocks of A and B are packed into contiguous buffers, padded with zeros to multiples of the
+// register tile. The micro-kernel multiplies a panel of gemm_mr rows of A by a panel of gemm_nr
+// columns of B, keeping the gemm_mr x gemm_nr tile of C in packets. Packed blocks of A fit into
+// L2 cache and panels of B into L1 cache.
+template <Real T>
+inline constexpr long int gemm_mr = 4;
+
+
+template <Real T>
+inline constexpr long int gemm_nr = packet_size<T>;
+
+
+template <Real T>
+inline constexpr long int gemm_kc = sizeof(T) <= 8 ? 256 : 128;
+
+
+template <Real T>
+inline constexpr long int gemm_mc = 96;
+
+
+template <Real T>
+inline constexpr long int gemm_nc = 2'048;
+
+
+STRICT_NODISCARD_CONSTEXPR_INLINE index_t round_up(index_t n, long int m) {
+   return (n + index_t{m - 1}) / index_t{m} * index_t{m};
+}
+
+
+// Rows [i0, i0 + mc) and columns [p0, p0 + kc) of A are packed into panels of gemm_mr rows,
+// each panel being stored by columns.
+template <TwoDimRealBaseType Base>
+STRICT_INLINE void pack_gemm_a(const Base& A, index_t i0, index_t mc, index_t p0, index_t kc,
+                               Strict<BuiltinTypeOf<Base>>* STRICT_RESTRICT a) {
+   constexpr long int mr = gemm_mr<BuiltinTypeOf<Base>>;
+   for(index_t ir = 0_sl; ir < mc; ir += index_t{mr}) {
+      for(index_t p = 0_sl; p < kc; ++p) {
+         for(long int r = 0; r < mr; ++r) {
+            const index_t i = ir + index_t{r};
+            *a++ = i < mc ? A.un(i0 + i, p0 + p) : Zero<BuiltinTypeOf<Base>>;
+         }
+      }
+   }
+}
+
+
+// Rows [p0, p0 + kc) and columns [j0, j0 + nc) of B are packed into panels of gemm_nr columns,
+// each panel being stored by rows.
+template <TwoDimRealBaseType Base>
+STRICT_INLINE void pack_gemm_b(const Base& B, index_t p0, index_t kc, index_t j0, index_t nc,
+                               Strict<BuiltinTypeOf<Base>>* STRICT_RESTRICT b) {
+   constexpr long int nr = gemm_nr<BuiltinTypeOf<Base>>;
+   for(index_t jr = 0_sl; jr < nc; jr += index_t{nr}) {
+      for(index_t p = 0_sl; p < kc; ++p) {
+         for(long int c = 0; c < nr; ++c) {
+            const index_t j = jr + index_t{c};
+            *b++ = j < nc ? B.un(p0 + p, j0 + j) : Zero<BuiltinTypeOf<Base>>;
+         }
+      }
+   }
+}
+
+
+// Adds the product of packed panels to rows [i0, i0 + m) and columns [j0, j0 + n) of C.
+template <TwoDimBaseType Base, Real T>
+STRICT_INLINE void gemm_micro_kernel(index_t kc, const Strict<T>* STRICT_RESTRICT a,
+                                     const Strict<T>* STRICT_RESTRICT b, Base& C, index_t i0,
+                                     index_t m, index_t j0, index_t n) {
+   constexpr long int mr = gemm_mr<T>;
+   constexpr long int nr = gemm_nr<T>;
+   Packet<T, nr> c[static_cast<std::size_t>(mr)];
+   for(long int r = 0; r < mr; ++r) {
+      c[r] = Packet<T, nr>::broadcast(T{0});
+   }
+
+   for(index_t p = 0_sl; p < kc; ++p) {
+      const auto bp = load_packet<nr, false>(b);
+      for(long int r = 0; r < mr; ++r) {
+         c[r] = c[r] + Packet<T, nr>::broadcast(a[r].val()) * bp;
+      }
+      a += mr;
+      b += nr;
+   }
+
+   for(index_t i = 0_sl; i < m; ++i) {
+      for(index_t j = 0_sl; j < n; ++j) {
+         C.un(i0 + i, j0 + j) += Strict{c[i.val()].v[j.val()]};
+      }
+   }
+}
+
+
+// Computes rows [first, last) of C.
+template <TwoDimBaseType Base1, TwoDimBaseType Base2, TwoDimBaseType Base3>
+void gemm_rows(const Base1& A, const Base2& B, Base3& C, index_t first, index_t last) {
+   using T = BuiltinTypeOf<Base3>;
+   constexpr long int mr = gemm_mr<T>;
+   constexpr long int nr = gemm_nr<T>;
+   const index_t mc_max = mins(index_t{gemm_mc<T>}, round_up(last - first, mr));
+   const index_t kc_max = mins(index_t{gemm_kc<T>}, A.cols());
+   const index_t nc_max = mins(index_t{gemm_nc<T>}, round_up(B.cols(), nr));
+
+   for(index_t i = first; i < last; ++i) {
+      for(index_t j = 0_sl; j < C.cols(); ++j) {
+         C.un(i, j) = Zero<T>;
+      }
+   }
+
+   Array1D<T> a(mc_max * kc_max, uninitialized);
+   Array1D<T> b(kc_max * nc_max, uninitialized);
+   for(index_t jc = 0_sl; jc < B.cols(); jc += nc_max) {
+      const index_t nc = mins(nc_max, B.cols() - jc);
+      for(index_t pc = 0_sl; pc < A.cols(); pc += kc_max) {
+         const index_t kc = mins(kc_max, A.cols() - pc);
+         pack_gemm_b(B, pc, kc, jc, nc, b.data());
+         for(index_t ic = first; ic < last; ic += mc_max) {
+            const index_t mc = mins(mc_max, last - ic);
+            pack_gemm_a(A, ic, mc, pc, kc, a.data());
+            for(index_t jr = 0_sl; jr < nc; jr += index_t{nr}) {
+               for(index_t ir = 0_sl; ir < mc; ir += index_t{mr}) {
+                  gemm_micro_kernel(kc, a.data() + (ir * kc).val(), b.data() + (jr * kc).val(),
+                                    C, ic + ir, mins(index_t{mr}, mc - ir), jc + jr,
+                                    mins(index_t{nr}, nc - jr));
+               }
+            }
+         }
+      }
+   }
+}
+
+
+// Sums n products of contiguous elements using two packets of partial sums.
+template <Real T>
+STRICT_INLINE Strict<T> gemv_dot(const Strict<T>* STRICT_RESTRICT a,
+                                 const Strict<T>* STRICT_RESTRICT x, long int n) {
+   constexpr long int N = packet_size<T>;
+   auto s0 = Packet<T, N>::broadcast(T{0});
+   auto s1 = s0;
+   long int k = 0;
+   for(; k + 2 * N <= n; k += 2 * N) {
+      s0 = s0 + load_packet<N, false>(a + k) * load_packet<N, false>(x + k);
+      s1 = s1 + load_packet<N, false>(a + k + N) * load_packet<N, false>(x + k + N);
+   }
+   for(; k + N <= n; k += N) {
+      s0 = s0 + load_packet<N, false>(a + k) * load_packet<N, false>(x + k);
+   }
+   s0 = s0 + s1;
+
+   T s{0};
+   for(long int l = 0; l < N; ++l) {
+      s += s0.v[l];
+   }
+   for(; k < n; ++k) {
+      s += a[k].val() * x[k].val();
+   }
+   return Strict{s};
+}
+
+
+// Computes elements [first, last) of y. Columns of column-major arrays are contiguous, so that
+// y is updated by columns. Otherwise, rows of A are multiplied by x, rows that are not
+// contiguous in memory being packed first.
+template <TwoDimBaseType Base1, Real T, OneDimBaseType Base3>
+void gemv_rows(const Base1& A, const Strict<T>* STRICT_RESTRICT x, Base3& y, index_t first,
+               index_t last) {
+   if constexpr(ColMajorArrayType<Base1>) {
+      for(index_t i = first; i < last; ++i) {
+         y.un(i) = Zero<T>;
+      }
+      for(index_t j = 0_sl; j < A.cols(); ++j) {
+         const auto xj = x[j.val()];
+         for(index_t i = first; i < last; ++i) {
+            y.un(i) += A.un(i, j) * xj;
+         }
+      }
+   } else if constexpr(LinearArrayType<Base1>) {
+      for(index_t i = first; i < last; ++i) {
+         y.un(i) = A.cols() > 0_sl ? gemv_dot(&A.un(i, 0_sl), x, A.cols().val()) : Zero<T>;
+      }
+   } else {
+      Array1D<T> row(A.cols(), uninitialized);
+      for(index_t i = first; i < last; ++i) {
+         for(index_t j = 0_sl; j < A.cols(); ++j) {
+            row.un(j) = A.un(i, j);
+         }
+         y.un(i) = gemv_dot(row.data(), x, A.cols().val());
+      }
+   }
+}
+
+
+// Expressions that cannot be copied generate random values and are evaluated serially.
+template <typename Base1, typename Base2> concept ParallelProduct =
+   std::is_copy_constructible_v<Base1> && std::is_copy_constructible_v<Base2>;
+
+
+} // namespace detail
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <TwoDimRealBaseType Base1, TwoDimRealBaseType Base2, typename Base3>
+   requires(detail::TwoDimNonConstBaseType<RemoveRef<Base3>> && !detail::ArrayTypeRvalue<Base3>
+            && SameAs<BuiltinTypeOf<Base1>, BuiltinTypeOf<Base2>>
+            && SameAs<BuiltinTypeOf<Base1>, BuiltinTypeOf<Base3>>)
+STRICT_CONSTEXPR void matrix_prod(const Base1& A, const Base2& B, Base3&& C) {
+   STRICT_PROFILE_SCOPE("matrix_prod");
+   using namespace detail;
+   ASSERT_STRICT_DEBUG(A.cols() == B.rows());
+   ASSERT_STRICT_DEBUG(C.rows() == A.rows());
+   ASSERT_STRICT_DEBUG(C.cols() == B.cols());
+
+   if(std::is_constant_evaluated()) {
+      for(index_t i = 0_sl; i < A.rows(); ++i) {
+         for(index_t j = 0_sl; j < B.cols(); ++j) {
+            C.un(i, j) = Zero<BuiltinTypeOf<Base3>>;
+            for(index_t p = 0_sl; p < A.cols(); ++p) {
+               C.un(i, j) += A.un(i, p) * B.un(p, j);
+            }
+         }
+      }
+      return;
+   }
+
+   if constexpr(ParallelProduct<Base1, Base2>) {
+      // Rows are split in multiples of the register tile.
+      if(use_parallel(C.size() * A.cols())) {
+         parallel_for(A.rows(), index_t{gemm_mr<BuiltinTypeOf<Base3>>},
+                      [&A, &B, &C](index_t first, index_t last) {
+                         gemm_rows(A, B, C, first, last);
+                      });
+         return;
+      }
+   }
+   gemm_rows(A, B, C, 0_sl, A.rows());
+}
+
+
+template <TwoDimRealBaseType Base1, TwoDimRealBaseType Base2>
+   requires(SameAs<BuiltinTypeOf<Base1>, BuiltinTypeOf<Base2>>)
+STRICT_CONSTEXPR Array2D<BuiltinTypeOf<Base1>> matrix_prod(const Base1& A, const Base2& B) {
+   ASSERT_STRICT_DEBUG(A.cols() == B.rows());
+   Array2D<BuiltinTypeOf<Base1>> C(A.rows(), B.cols(), uninitialized);
+   matrix_prod(A, B, C);
+   return C;
+}
+
+
+template <TwoDimRealBaseType Base1, OneDimRealBaseType Base2, typename Base3>
+   requires(detail::NonConstBaseType<RemoveRef<Base3>> && OneDimBaseType<RemoveRef<Base3>>
+            && !detail::ArrayTypeRvalue<Base3>
+            && SameAs<BuiltinTypeOf<Base1>, BuiltinTypeOf<Base2>>
+            && SameAs<BuiltinTypeOf<Base1>, BuiltinTypeOf<Base3>>)
+STRICT_CONSTEXPR void matrix_vector_prod(const Base1& A, const Base2& x, Base3&& y) {
+   STRICT_PROFILE_SCOPE("matrix_vector_prod");
+   using namespace detail;
+   ASSERT_STRICT_DEBUG(A.cols() == x.size());
+   ASSERT_STRICT_DEBUG(A.rows() == y.size());
+
+   if(std::is_constant_evaluated()) {
+      for(index_t i = 0_sl; i < A.rows(); ++i) {
+         y.un(i) = Zero<BuiltinTypeOf<Base3>>;
+         for(index_t j = 0_sl; j < A.cols(); ++j) {
+            y.un(i) += A.un(i, j) * x.un(j);
+         }
+      }
+      return;
+   }
+
+   // x is packed once and shared by all threads.
+   const Array1D<BuiltinTypeOf<Base2>> xp = x;
+   if constexpr(ParallelProduct<Base1, Base2>) {
+      if(use_parallel(A.size())) {
+         parallel_for(A.rows(), cache_line_elements<ValueTypeOf<Base3>>(),
+                      [&A, &xp, &y](index_t first, index_t last) {
+                         gemv_rows(A, xp.data(), y, first, last);
+                      });
+         return;
+      }
+   }
+   gemv_rows(A, xp.data(), y, 0_sl, A.rows());
+}
+
+
+template <TwoDimRealBaseType Base1, OneDimRealBaseType Base2>
+   requires(SameAs<BuiltinTypeOf<Base1>, BuiltinTypeOf<Base2>>)
+STRICT_CONSTEXPR Array1D<BuiltinTypeOf<Base1>> matrix_vector_prod(const Base1& A,
+                                                                  const Base2& x) {
+   ASSERT_STRICT_DEBUG(A.cols() == x.size());
+   Array1D<BuiltinTypeOf<Base1>> y(A.rows(), uninitialized);
+   matrix_vector_prod(A, x, y);
+   return y;
+}
+
+
+} // namespace spp
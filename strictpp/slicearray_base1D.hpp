@@ -39,6 +39,14 @@ public:
 
    STRICT_NODISCARD_CONSTEXPR_INLINE value_type& un(ImplicitInt i);
    STRICT_NODISCARD_CONSTEXPR_INLINE const value_type& un(ImplicitInt i) const;
+
+   // Slices of arrays with stride 1 are contiguous.
+   template <long int N>
+   STRICT_NODISCARD_INLINE Packet<builtin_type, N> un_packet(index_t i) const
+      requires(SameAs<Sl, seqN> && LinearArrayType<Base>);
+   STRICT_NODISCARD_INLINE bool packet_ready() const
+      requires(SameAs<Sl, seqN> && LinearArrayType<Base>);
+
    STRICT_NODISCARD_CONSTEXPR const auto& get_slice() const&;
    STRICT_NODISCARD_CONSTEXPR auto get_slice() &&;
    STRICT_NODISCARD_CONSTEXPR auto get_slice() const&&;
@@ -107,6 +115,24 @@ STRICT_NODISCARD_CONSTEXPR_INLINE auto SliceArrayBase1D<Base, Sl>::un(ImplicitIn
 }
 
 
+template <NonConstBaseType Base, typename Sl>
+template <long int N>
+STRICT_NODISCARD_INLINE auto SliceArrayBase1D<Base, Sl>::un_packet(index_t i) const
+   -> Packet<builtin_type, N>
+   requires(SameAs<Sl, seqN> && LinearArrayType<Base>)
+{
+   return load_packet<N, false>(&A_.un(slw_.get().start() + i));
+}
+
+
+template <NonConstBaseType Base, typename Sl>
+STRICT_NODISCARD_INLINE bool SliceArrayBase1D<Base, Sl>::packet_ready() const
+   requires(SameAs<Sl, seqN> && LinearArrayType<Base>)
+{
+   return slw_.get().stride() == 1_sl;
+}
+
+
 template <NonConstBaseType Base, typename Sl>
 STRICT_NODISCARD_CONSTEXPR const auto& SliceArrayBase1D<Base, Sl>::get_slice() const& {
    return slw_.get();
@@ -146,6 +172,14 @@ public:
    STRICT_CONSTEXPR ~ConstSliceArrayBase1D() = default;
 
    STRICT_NODISCARD_CONSTEXPR_INLINE decltype(auto) un(ImplicitInt i) const;
+
+   // Slices of arrays with stride 1 are contiguous.
+   template <long int N>
+   STRICT_NODISCARD_INLINE Packet<builtin_type, N> un_packet(index_t i) const
+      requires(SameAs<Sl, seqN> && LinearArrayType<Base>);
+   STRICT_NODISCARD_INLINE bool packet_ready() const
+      requires(SameAs<Sl, seqN> && LinearArrayType<Base>);
+
    STRICT_NODISCARD_CONSTEXPR const auto& get_slice() const&;
    STRICT_NODISCARD_CONSTEXPR auto get_slice() &&;
    STRICT_NODISCARD_CONSTEXPR auto get_slice() const&&;
@@ -174,6 +208,24 @@ ConstSliceArrayBase1D<Base, Sl>::un(ImplicitInt i) const {
 }
 
 
+template <BaseType Base, typename Sl>
+template <long int N>
+STRICT_NODISCARD_INLINE auto ConstSliceArrayBase1D<Base, Sl>::un_packet(index_t i) const
+   -> Packet<builtin_type, N>
+   requires(SameAs<Sl, seqN> && LinearArrayType<Base>)
+{
+   return load_packet<N, false>(&A_.un(slw_.get().start() + i));
+}
+
+
+template <BaseType Base, typename Sl>
+STRICT_NODISCARD_INLINE bool ConstSliceArrayBase1D<Base, Sl>::packet_ready() const
+   requires(SameAs<Sl, seqN> && LinearArrayType<Base>)
+{
+   return slw_.get().stride() == 1_sl;
+}
+
+
 template <BaseType Base, typename Sl>
 STRICT_NODISCARD_CONSTEXPR const auto& ConstSliceArrayBase1D<Base, Sl>::get_slice() const& {
    return slw_.get();
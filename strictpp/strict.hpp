@@ -17,13 +17,19 @@
 #include "StrictCommon/strict_common.hpp"
 #include "Util/util.hpp"
 #include "array_IO.hpp"
+#include "array_binary_IO.hpp"
+#include "array_npy_IO.hpp"
 #include "array_ops.hpp"
+#include "array_reduce.hpp"
 #include "array_stable_ops.hpp"
 #include "attach1D.hpp"
 #include "attach2D.hpp"
+#include "chunked_source.hpp"
 #include "concepts.hpp"
 #include "derived1D.hpp"
 #include "derived2D.hpp"
+#include "mapped_array.hpp"
+#include "matrix_ops.hpp"
 
 
 #endif
@@ -1,6 +1,8 @@
 #include "test.hpp"
 
+#include <algorithm>
 #include <cstdlib>
+#include <limits>
 
 
 using namespace spp;
@@ -394,6 +396,145 @@ void empty_ops() {
 }
 
 
+// Blocks of serial and parallel pairwise sums are the same for all block sizes.
+template <typename T>
+void test_pairwise_sum() {
+   const long int n = 100'003;
+   Array1D<T> A(n, Strict<T>{T(0.1)});
+   const auto exact = Strict<T>{T(n)} * Strict<T>{T(0.1)};
+   const auto tol = Strict<T>{T(64)} * constants::epsilon<T> * exact;
+   ASSERT(abss(sum(A, PairwiseSum) - exact) < tol);
+   const auto exact2 = Strict<T>{T(n / 2)} * Strict<T>{T(0.1)};
+   ASSERT(abss(sum(A(seqN{0, n / 2, 2}), PairwiseSum) - exact2) < tol);
+
+   A[7] = Strict<T>{T(-1)};
+   A[n - 1] = Strict<T>{T(2)};
+   for(long int block : {1L, 8L, 256L, 4'096L}) {
+      execution.pairwise_block(block);
+      const auto s = sum(A, PairwiseSum);
+      const auto d = dot_prod(A, A, PairwiseSum);
+      for(long int threads : {1L, 3L, 4L}) {
+         execution.parallel(true).threads(threads).threshold(0);
+         ASSERT(sum(A, PairwiseSum) == s && dot_prod(A, A, PairwiseSum) == d);
+         execution.parallel(false);
+      }
+   }
+   execution.reset();
+   ASSERT(execution.pairwise_block() == 256_sl);
+   REQUIRE_THROW(execution.pairwise_block(0));
+   REQUIRE_THROW(execution.pairwise_block(100));
+   REQUIRE_THROW(execution.pairwise_block(8'192));
+
+   // The flag of spp::execution is used by default.
+   const auto s = sum(A, PairwiseSum);
+   execution.summation(PairwiseSum);
+   ASSERT(execution.summation() == PairwiseSum);
+   ASSERT(sum(A) == s && mean(A) == mean(A, PairwiseSum));
+   ASSERT(dot_prod(A, A) == sum(A * A, PairwiseSum));
+   ASSERT(norm1(A) == norm1(A, PairwiseSum) && norm1_scaled(A) == norm1_scaled(A, PairwiseSum));
+   ASSERT(norm2(A) == norm2(A, PairwiseSum) && norm2_scaled(A) == norm2_scaled(A, PairwiseSum));
+   ASSERT(norm_lp(A, 3) == norm_lp(A, 3, PairwiseSum));
+   ASSERT(norm_lp_scaled(A, 3) == norm_lp_scaled(A, 3, PairwiseSum));
+   execution.reset();
+   ASSERT(execution.summation() == RecursiveSum && sum(A) == sum(A, RecursiveSum));
+
+   // Terms of blocks are added in order, other than by packets.
+   Array1D<T> coeffs = random(200, Strict<T>{T(-1)}, Strict<T>{T(1)});
+   Array1D<int> powers = random(200, 0_si, 10_si);
+   const auto x = Strict<T>{T(0.75)};
+   ASSERT(polynomial(coeffs, x, powers, PairwiseSum) == polynomial(coeffs, x, powers));
+   ASSERT(gpolynomial(coeffs, A(seqN{0, 200}), powers, PairwiseSum)
+          == gpolynomial(coeffs, A(seqN{0, 200}), powers));
+
+   Array1D<int> I{1_si, 2_si, 3_si};
+   Array1D<T> Z{};
+   ASSERT(sum(I, PairwiseSum) == 6_si && sum(Z, PairwiseSum, Strict<T>{T(1)}) == Strict<T>{T(1)});
+}
+
+
+// Results do not depend on the order of terms, slices, packets, or threads. Terms of the form
+// big, 1, -big are summed exactly.
+template <typename T>
+void test_reproducible_sum() {
+   const long int n = 12'291;
+   const Strict<T> one{T(1)};
+   const Strict<T> big = Strict<T>{T(2)} / constants::epsilon<T>;
+   Array1D<T> A(n);
+   for(long int i = 0; i < n; ++i) {
+      A[i] = i % 3 == 0 ? big : (i % 3 == 1 ? one : -big);
+   }
+   ASSERT(sum(A, ReproducibleSum) == Strict<T>{T(n / 3)});
+
+   Array1D<T> B = random(n, Strict<T>{T(-1)}, Strict<T>{T(1)});
+   for(long int i = 0; i < n; i += 5) {
+      B[i] *= Strict<T>{T(1e6)};
+   }
+   const auto s = sum(B, ReproducibleSum);
+   const auto d = dot_prod(B, A, ReproducibleSum);
+   ASSERT(abss(s - exact_sum(B)) <= constants::epsilon<T> * sum(abs(B)));
+
+   Array1D<T> R = B;
+   std::reverse(R.begin(), R.end());
+   ASSERT(sum(R, ReproducibleSum) == s);
+   Array1D<T> C = B(seqN{1, n - 1});
+   Array1D<T> D = B(seqN{0, n / 2, 2});
+   ASSERT(sum(B(seqN{1, n - 1}), ReproducibleSum) == sum(C, ReproducibleSum));
+   ASSERT(sum(B(seqN{0, n / 2, 2}), ReproducibleSum) == sum(D, ReproducibleSum));
+   for(long int threads : {1L, 3L, 4L}) {
+      execution.parallel(true).threads(threads).threshold(0);
+      ASSERT(sum(R, ReproducibleSum) == s && dot_prod(B, A, ReproducibleSum) == d);
+      execution.parallel(false);
+   }
+
+   // The flag of spp::execution is used by default.
+   execution.summation(ReproducibleSum);
+   ASSERT(sum(B) == s && mean(B) == s / Strict<T>{T(n)});
+   ASSERT(dot_prod(B, B) == sum(B * B, ReproducibleSum));
+   ASSERT(norm2(B) == sqrts(dot_prod(B, B, ReproducibleSum)));
+   execution.reset();
+
+   Array1D<int> powers = random(200, 0_si, 10_si);
+   Array1D<T> coeffs = B(seqN{0, 200});
+   Array1D<T> X = random(200, Strict<T>{T(-1)}, Strict<T>{T(1)});
+   const auto p = gpolynomial(coeffs, X, powers, ReproducibleSum);
+   std::reverse(coeffs.begin(), coeffs.end());
+   std::reverse(X.begin(), X.end());
+   std::reverse(powers.begin(), powers.end());
+   ASSERT(gpolynomial(coeffs, X, powers, ReproducibleSum) == p);
+
+   const Strict<T> inf{T(std::numeric_limits<double>::infinity())};
+   B[n - 1] = inf;
+   ASSERT(sum(B, ReproducibleSum) == inf);
+   B[0] = -inf;
+   ASSERT(isnans(sum(B, ReproducibleSum)));
+
+   Array1D<int> I{1_si, 2_si, 3_si};
+   Array1D<T> Z{};
+   ASSERT(sum(I, ReproducibleSum) == 6_si);
+   ASSERT(sum(Z, ReproducibleSum, Strict<T>{T(1)}) == Strict<T>{T(1)});
+}
+
+
+// Terms close to the largest and to the smallest numbers.
+void test_reproducible_range() {
+   const auto max = Strict{std::numeric_limits<double>::max()};
+   const auto min = Strict{std::numeric_limits<double>::denorm_min()};
+   const auto big = Strict{0x1p+1022};
+   const auto h = Strict{0x1p+962};
+   Array1D<double> A{big, h, -big, h / 2._sd};
+   ASSERT(sum(A, ReproducibleSum) == 1.5_sd * h);
+   std::reverse(A.begin(), A.end());
+   ASSERT(sum(A, ReproducibleSum) == 1.5_sd * h);
+
+   Array1D<double> B{min, 3._sd * min, -min};
+   ASSERT(sum(B, ReproducibleSum) == 3._sd * min);
+   Array1D<double> C{max / 2._sd, max / 2._sd, max / 4._sd, -max / 2._sd};
+   ASSERT(sum(C, ReproducibleSum) == max / 2._sd + max / 4._sd);
+   C[3] = max / 2._sd;
+   ASSERT(!isfinites(sum(C, ReproducibleSum)));
+}
+
+
 //////////////////////////////////////////////////////////////////////////////////////////////////
 int main() {
    TEST_NON_TYPE(standard_ops);
@@ -403,5 +544,8 @@ int main() {
    TEST_NON_TYPE(bool_ops);
    TEST_NON_TYPE(range_ops);
    TEST_NON_TYPE(empty_ops);
+   TEST_ALL_FLOAT_TYPES(test_pairwise_sum);
+   TEST_ALL_FLOAT_TYPES(test_reproducible_sum);
+   TEST_NON_TYPE(test_reproducible_range);
    return EXIT_SUCCESS;
 }
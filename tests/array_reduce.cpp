@@ -0,0 +1,120 @@
+#include "test.hpp"
+
+#include <cstdlib>
+#include <tuple>
+
+
+using namespace spp;
+using namespace spp::place;
+
+
+template <typename T>
+void test_reduce_many_real() {
+   Array1D<T> A = random(1'001, Zero<T>, Strict{T(10)});
+   Array2D<T> B = random(13, 17, Zero<T>, Strict{T(10)});
+
+   auto [s, mn, mx, mm] = reduce_many(A, sum_op{}, min_op{}, max_op{}, minmax_op{});
+   ASSERT(s == sum(A));
+   ASSERT(mn == min(A));
+   ASSERT(mx == max(A));
+   ASSERT(mm.first == min(A) && mm.second == max(A));
+
+   auto [p] = reduce_many(A(seqN{0, 5}), prod_op{});
+   ASSERT(p == prod(A(seqN{0, 5})));
+
+   // Expressions, slices, and two-dimensional types.
+   ASSERT((reduce_many(A + A, sum_op{}, max_op{}) == std::tuple{sum(A + A), max(A + A)}));
+   ASSERT((reduce_many(A(skipN{3}), min_op{}) == std::tuple{min(A(skipN{3}))}));
+   ASSERT((reduce_many(B, sum_op{}, min_op{}) == std::tuple{sum(B), min(B)}));
+   ASSERT((reduce_many(transpose(B), max_op{}) == std::tuple{max(transpose(B))}));
+
+   ASSERT((reduce_many(Array1D<T>{}, sum_op{}, minmax_op{})
+          == std::tuple{Zero<T>, std::pair{Zero<T>, Zero<T>}}));
+}
+
+
+template <typename T>
+void test_reduce_many_floating() {
+   Array1D<T> A = random(1'001, Strict{T(-10)}, Strict{T(10)});
+
+   auto [m, n1, n2, ninf, nan, inf, fin] = reduce_many(A, mean_op{}, norm1_op{}, norm2_op{},
+                                                       norm_inf_op{}, has_nan_op{}, has_inf_op{},
+                                                       all_finite_op{});
+   ASSERT(m == mean(A));
+   ASSERT(n1 == norm1(A));
+   ASSERT(n2 == norm2(A));
+   ASSERT(ninf == norm_inf(A));
+   ASSERT(!nan && !inf && fin);
+
+   A[500] = One<T> / Zero<T>;
+   ASSERT((reduce_many(A, has_nan_op{}, has_inf_op{}, all_finite_op{})
+          == std::tuple{false_sb, true_sb, false_sb}));
+   A[1'000] = Zero<T> / Zero<T>;
+   ASSERT(std::get<0>(reduce_many(A, has_nan_op{})));
+
+   ASSERT((reduce_many(Array1D<T>{}, all_finite_op{}, has_nan_op{})
+          == std::tuple{true_sb, false_sb}));
+}
+
+
+template <typename T>
+void test_reduce_many_parallel() {
+   Array1D<T> A = random(20'000, Zero<T>, One<T>);
+   Array2D<T> B = random(101, 99, Zero<T>, One<T>);
+
+   // Results are the same as the ones of the corresponding functions for any number of threads.
+   execution.parallel(true).threshold(0);
+   for(auto nthreads : {1, 2, 3, 4}) {
+      execution.threads(nthreads);
+      ASSERT((reduce_many(A * A + A, sum_op{}, minmax_op{}, norm2_op{})
+             == std::tuple{sum(A * A + A), std::pair{min(A * A + A), max(A * A + A)},
+                           norm2(A * A + A)}));
+      ASSERT((reduce_many(B, sum_op{}, max_op{}) == std::tuple{sum(B), max(B)}));
+   }
+
+   // Random expressions are reduced serially.
+   auto [mn, mx] = reduce_many(random(1'000, Zero<T>, One<T>), min_op{}, max_op{});
+   ASSERT(mn >= Zero<T> && mx <= One<T>);
+
+   execution.reset();
+}
+
+
+template <typename T>
+void test_reduce_many_summation() {
+   Array1D<T> A = random(20'001, -One<T>, One<T>);
+   Array2D<T> B = random(101, 99, Zero<T>, One<T>);
+
+   // Sums use the flag of summation of execution, also for slices and expressions.
+   for(auto sf : {PairwiseSum, ReproducibleSum}) {
+      execution.summation(sf).threshold(0);
+      for(auto nthreads : {1, 2, 3, 4}) {
+         execution.threads(nthreads);
+         for(auto parallel : {false, true}) {
+            execution.parallel(parallel);
+            ASSERT((reduce_many(A, sum_op{}, mean_op{}, norm1_op{}, norm2_op{}, max_op{})
+                    == std::tuple{sum(A), mean(A), norm1(A), norm2(A), max(A)}));
+            ASSERT((reduce_many(A * A + A, sum_op{}, norm2_op{}, min_op{})
+                    == std::tuple{sum(A * A + A), norm2(A * A + A), min(A * A + A)}));
+            ASSERT((reduce_many(A(seqN(3, 9'999, 2)), sum_op{}, norm1_op{})
+                    == std::tuple{sum(A(seqN(3, 9'999, 2))), norm1(A(seqN(3, 9'999, 2)))}));
+            ASSERT((reduce_many(B, mean_op{}, norm2_op{}) == std::tuple{mean(B), norm2(B)}));
+         }
+      }
+   }
+
+   // Reproducible sums do not depend on the order of terms.
+   execution.summation(ReproducibleSum);
+   ASSERT(std::get<0>(reduce_many(A, sum_op{})) == std::get<0>(reduce_many(A(reverse), sum_op{})));
+   execution.reset();
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+int main() {
+   TEST_ALL_REAL_TYPES(test_reduce_many_real);
+   TEST_ALL_FLOAT_TYPES(test_reduce_many_floating);
+   TEST_ALL_FLOAT_TYPES(test_reduce_many_parallel);
+   TEST_ALL_FLOAT_TYPES(test_reduce_many_summation);
+   return EXIT_SUCCESS;
+}
@@ -1,6 +1,8 @@
 #include "test.hpp"
 
+#include <algorithm>
 #include <cstdlib>
+#include <limits>
 
 
 using namespace spp;
@@ -87,7 +89,110 @@ void stable_ops(ImplicitInt n) {
 }
 
 
+// Rounding errors of additions and products cancel exactly, so that the results are exact
+// while the results of sum and dot_prod are not. Sizes cover packets, remaining elements,
+// and several blocks of parallel reductions, n must be a multiple of 3.
+template <typename T>
+void test_compensated(ImplicitInt n) {
+   const auto m = n.get().val();
+   const Strict<T> big = Strict<T>{T(2)} / constants::epsilon<T>;
+
+   Array1D<T> A(n);
+   for(long int i = 0; i < m; ++i) {
+      A[i] = i % 3 == 0 ? big : (i % 3 == 1 ? Strict<T>{T(1)} : -big);
+   }
+   const auto ones = Strict<T>{T(m / 3)};
+   ASSERT(stable_sum(A) == ones);
+   ASSERT(stable_sum(A + A) == Strict<T>{T(2)} * ones);
+   ASSERT(stable_mean(A) == ones / Strict<T>{T(m)});
+   ASSERT(stable_norm1(-A) == stable_sum(abs(A)));
+
+   Array1D<T> X(n + 1_sl, Strict<T>{T(1)} + constants::epsilon<T>);
+   Array1D<T> Y(n + 1_sl, Strict<T>{T(1)} - constants::epsilon<T>);
+   X[m] = Strict<T>{T(m)};
+   Y[m] = Strict<T>{T(-1)};
+   const auto eps = constants::epsilon<T>;
+   ASSERT(stable_dot_prod(X, Y) == -Strict<T>{T(m)} * eps * eps);
+}
+
+
+// Blocks are merged in a fixed order, hence results do not depend on the number of threads.
+void test_deterministic(ImplicitInt n) {
+   const Array1D<double> A = random<double>(n, -1._sd, 1._sd);
+   const Array1D<float> B = random<float>(n, -1._sf, 1._sf);
+   const auto s = stable_sum(A);
+   const auto d = stable_dot_prod(A, A * 3._sd);
+   const auto m = stable_mean(B);
+   const auto n1 = stable_norm1(B);
+
+   for(long int threads : {2L, 3L, 4L}) {
+      execution.parallel(true).threads(threads).threshold(0);
+      ASSERT(stable_sum(A) == s && stable_dot_prod(A, A * 3._sd) == d);
+      ASSERT(stable_mean(B) == m && stable_norm1(B) == n1);
+   }
+   execution.reset();
+}
+
+
+// Results are correctly rounded, also in the cases of ties and of cancellation, and do not depend
+// on the order of elements.
+template <typename T>
+void test_exact(ImplicitInt n) {
+   const auto m = n.get().val();
+   const auto eps = constants::epsilon<T>;
+   const Strict<T> one{T(1)};
+   const Strict<T> big = Strict<T>{T(2)} / eps;
+
+   Array1D<T> A(n);
+   for(long int i = 0; i < m; ++i) {
+      A[i] = i % 3 == 0 ? big : (i % 3 == 1 ? one : -big);
+   }
+   ASSERT(exact_sum(A) == Strict<T>{T(m / 3)});
+   std::reverse(A.begin(), A.end());
+   ASSERT(exact_sum(A) == Strict<T>{T(m / 3)});
+
+   // 1 + eps / 2 is halfway between 1 and 1 + eps.
+   Array1D<T> B(n);
+   B[0] = one;
+   B[1] = eps / Strict<T>{T(2)};
+   for(long int i = 3; i + 1 < m; i += 2) {
+      B[i] = big;
+      B[i + 1] = -big;
+   }
+   ASSERT(exact_sum(B) == one && exact_sum(-B) == -one);
+   B[2] = eps * eps * eps;
+   ASSERT(exact_sum(B) == one + eps && exact_sum(-B) == -one - eps);
+   B[2] = -B[2];
+   ASSERT(exact_sum(B) == one);
+
+   Array1D<T> X(n + 1_sl, one + eps);
+   Array1D<T> Y(n + 1_sl, one - eps);
+   X[m] = Strict<T>{T(m)};
+   Y[m] = Strict<T>{T(-1)};
+   ASSERT(exact_dot_prod(X, Y) == -Strict<T>{T(m)} * eps * eps);
+
+   const Strict<T> inf{T(std::numeric_limits<double>::infinity())};
+   Array1D<T> Z{};
+   ASSERT(exact_sum(Z) == Strict<T>{T(0)} && exact_sum(Z, one) == one);
+   ASSERT(exact_dot_prod(Z, Z, one) == one);
+   A[0] = inf;
+   ASSERT(exact_sum(A) == inf && exact_dot_prod(A, A) == inf);
+   A[m - 1] = -inf;
+   ASSERT(isnans(exact_sum(A)));
+
+   execution.parallel(true).threads(3).threshold(0);
+   ASSERT(exact_sum(B) == one && exact_dot_prod(X, Y) == -Strict<T>{T(m)} * eps * eps);
+   execution.reset();
+}
+
+
 int main() {
    TEST_NON_TYPE(stable_ops, 1'000);
+   TEST_ALL_FLOAT_TYPES(test_compensated, 3);
+   TEST_ALL_FLOAT_TYPES(test_compensated, 48);
+   TEST_ALL_FLOAT_TYPES(test_compensated, 12'294);
+   TEST_NON_TYPE(test_deterministic, 100'003);
+   TEST_ALL_FLOAT_TYPES(test_exact, 3);
+   TEST_ALL_FLOAT_TYPES(test_exact, 12'294);
    return EXIT_SUCCESS;
 }
@@ -0,0 +1,230 @@
+#include "test.hpp"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+
+using namespace spp;
+
+
+static std::string temp_file(const std::string& name) {
+   return (std::filesystem::temp_directory_path() / ("strictpp_" + name + ".bin")).string();
+}
+
+
+template <typename T>
+Array2D<T> values(long int m, long int n) {
+   Array2D<T> A(m, n);
+   for(long int i = 0; i < m; ++i) {
+      for(long int j = 0; j < n; ++j) {
+         A(i, j) = Strict{T((i * 5 + j * 3) % 7)};
+      }
+   }
+   return A;
+}
+
+
+static void flip_byte(const std::string& file_path, long int offset) {
+   std::fstream fs{file_path, std::ios::in | std::ios::out | std::ios::binary};
+   fs.seekg(offset);
+   char c{};
+   fs.get(c);
+   fs.seekp(offset);
+   fs.put(static_cast<char>(c ^ 1));
+}
+
+
+// Header of a one-dimensional array of doubles of the given sizes, without elements.
+static void write_header(const std::string& file_path, long int rows, long int cols) {
+   detail::BinaryHeader h;
+   h.kind = 'f';
+   h.element_size = sizeof(double);
+   h.dims = 1;
+   h.rows = rows;
+   h.cols = cols;
+   h.checksum = detail::binary_checksum(nullptr, 0);
+   auto buf = detail::encode_header(h);
+   std::ofstream ofs{file_path, std::ios::binary};
+   ofs.write(reinterpret_cast<const char*>(buf.data()), long(buf.size()));
+}
+
+
+template <typename T>
+void test_round_trip() {
+   const auto file = temp_file("round_trip");
+
+   for(long int n : {0L, 1L, 7L, 1'000L}) {
+      Array1D<T> A(n);
+      for(long int i = 0; i < n; ++i) {
+         A[i] = Strict{T(i % 7)};
+      }
+      save_binary(file, A);
+      Array1D<T, Aligned> B(3);
+      load_binary(file, B);
+      ASSERT(B == A);
+   }
+
+   auto A = values<T>(13, 17);
+   Array2D<T, Unaligned, ColMajor> AC = A;
+   for(int k = 0; k < 2; ++k) {
+      if(k == 0) {
+         save_binary(file, A);
+      } else {
+         save_binary(file, AC);
+      }
+      Array2D<T> B;
+      Array2D<T, Aligned, ColMajor> BC(2, 2);
+      load_binary(file, B);
+      load_binary(file, BC);
+      ASSERT(B == A && BC == A);
+   }
+
+   Array2D<T> E;
+   save_binary(file, E);
+   load_binary(file, A);
+   ASSERT(A.empty());
+
+   std::filesystem::remove(file);
+}
+
+
+template <typename T>
+void test_expressions() {
+   const auto file = temp_file("expressions");
+   auto A = values<T>(20, 30);
+   save_binary(file, A(seqN{1, 10, 2}, place::all));
+   Array2D<T> B;
+   load_binary(file, B);
+   ASSERT(B == A(seqN{1, 10, 2}, place::all));
+
+   save_binary(file, transpose(A) + transpose(A));
+   load_binary(file, B);
+   ASSERT(B == transpose(A) + transpose(A));
+
+   auto x = A.row(3);
+   save_binary(file, x);
+   Array1D<T> y;
+   load_binary(file, y);
+   ASSERT(y == x);
+   std::filesystem::remove(file);
+}
+
+
+void test_errors() {
+   const auto file = temp_file("errors");
+   auto V = values<double>(100, 1);
+   Array1D<double> A = V.view1D();
+   save_binary(file, A);
+
+   Array1D<float> B;
+   Array2D<double> C;
+   REQUIRE_THROW(load_binary(file, B));
+   REQUIRE_THROW(load_binary(file, C));
+   REQUIRE_THROW(load_binary(temp_file("does_not_exist"), A));
+
+   // A single bit flipped in the elements is detected by the checksum.
+   flip_byte(file, 64 + 8 * 37);
+   REQUIRE_THROW(load_binary(file, A));
+   flip_byte(file, 0);
+   REQUIRE_THROW(load_binary(file, A));
+
+   std::ofstream{file} << "1 2 3";
+   REQUIRE_THROW(load_binary(file, A));
+
+   // Sizes of forged headers are checked before A is resized.
+   for(auto [rows, cols] : {std::pair{1L << 61, 1L}, std::pair{1L << 40, 1L << 30},
+                            std::pair{-1L, 1L}, std::pair{1'000L, 1L}}) {
+      write_header(file, rows, cols);
+      REQUIRE_THROW(load_binary(file, A));
+      ASSERT(A.size() == 100_sl);
+#ifdef STRICT_HAS_MMAP
+      REQUIRE_THROW(MappedArray<double>{file});
+#endif
+   }
+   std::filesystem::remove(file);
+}
+
+
+// Files written on a platform of the opposite byte order.
+void test_byte_order() {
+   const auto file = temp_file("byte_order");
+   auto V = values<double>(50, 1);
+   Array1D<double> A = V.view1D();
+   Array1D<double> S = A;
+   detail::swap_bytes(S.data(), 50);
+
+   detail::BinaryHeader h;
+   h.kind = 'f';
+   h.element_size = sizeof(double);
+   h.dims = 1;
+   h.rows = 50;
+   h.cols = 1;
+   h.little_endian = !h.little_endian;
+   h.checksum = detail::binary_checksum(S.data(), h.bytes());
+   auto buf = detail::encode_header(h);
+   std::ofstream ofs{file, std::ios::binary};
+   ofs.write(reinterpret_cast<const char*>(buf.data()), long(buf.size()));
+   ofs.write(reinterpret_cast<const char*>(S.data()), long(h.bytes()));
+   ofs.close();
+
+   Array1D<double> B;
+   load_binary(file, B);
+   ASSERT(B == A);
+#ifdef STRICT_HAS_MMAP
+   REQUIRE_THROW(MappedArray<double>{file});
+#endif
+   std::filesystem::remove(file);
+}
+
+
+#ifdef STRICT_HAS_MMAP
+template <typename T>
+void test_mapped() {
+   const auto file = temp_file("mapped");
+   auto A = values<T>(31, 9);
+   save_binary(file, A);
+   {
+      MappedArray<T> M{file};
+      ASSERT(M.dims() == 2_sl && M.rows() == 31_sl && M.cols() == 9_sl && M.layout() == RowMajor);
+      ASSERT(M.verify());
+      auto V = M.view2D();
+      ASSERT(V == A);
+      ASSERT(M.view1D() == A.view1D());
+      ASSERT(sum(M.view1D()) == sum(A));
+
+      MappedArray<T> N = std::move(M);
+      ASSERT(N.view2D() == A);
+      using U = std::conditional_t<std::is_same_v<T, int>, long int, int>;
+      REQUIRE_THROW(MappedArray<U>{file});
+   }
+
+   Array2D<T, Unaligned, ColMajor> AC = A;
+   save_binary(file, AC);
+   MappedArray<T> M{file};
+   Array2D<T> ACT = transpose(AC);
+   ASSERT(M.layout() == ColMajor && M.view1D() == ACT.view1D());
+   REQUIRE_THROW(M.view2D());
+
+   Array1D<T> E;
+   save_binary(file, E);
+   MappedArray<T> ME{file};
+   ASSERT(ME.size() == 0_sl && ME.view1D().empty() && ME.verify());
+   std::filesystem::remove(file);
+}
+#endif
+
+
+int main() {
+   TEST_ALL_TYPES(test_round_trip);
+   TEST_ALL_REAL_TYPES(test_expressions);
+   TEST_NON_TYPE(test_errors);
+   TEST_NON_TYPE(test_byte_order);
+#ifdef STRICT_HAS_MMAP
+   TEST_ALL_REAL_TYPES(test_mapped);
+#endif
+   return EXIT_SUCCESS;
+}
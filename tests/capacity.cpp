@@ -0,0 +1,167 @@
+#include "test.hpp"
+
+#include <cstdlib>
+#include <memory_resource>
+#include <vector>
+
+
+using namespace spp;
+
+
+class CountingResource : public std::pmr::memory_resource {
+public:
+   long int allocations = 0;
+   long int deallocations = 0;
+
+private:
+   void* do_allocate(std::size_t n, std::size_t alignment) override {
+      ++allocations;
+      return std::pmr::new_delete_resource()->allocate(n, alignment);
+   }
+
+   void do_deallocate(void* p, std::size_t n, std::size_t alignment) override {
+      ++deallocations;
+      std::pmr::new_delete_resource()->deallocate(p, n, alignment);
+   }
+
+   bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+      return this == &other;
+   }
+};
+
+
+template <typename T>
+void test_capacity1D() {
+   Array1D<T> A;
+   ASSERT(A.capacity() == 0_sl);
+
+   A.reserve(10);
+   ASSERT(A.empty() && A.capacity() == 10_sl);
+   A.reserve(5);
+   ASSERT(A.capacity() == 10_sl);
+
+   A.resize(7);
+   ASSERT(A.capacity() == 10_sl);
+   A = random(7, Zero<T>, One<T>);
+   Array1D<T> B = A;
+   ASSERT(B.capacity() == 7_sl);
+
+   // Removing elements and resizing within the capacity keep the storage.
+   B.reserve(20);
+   const auto* p = B.data();
+   B.remove_front(2);
+   B.remove(std::vector<ImplicitInt>{0, 2});
+   ASSERT(B == A(seqN{2, 5})(std::vector<ImplicitInt>{1, 3, 4}));
+   B.resize(12);
+   ASSERT(B.data() == p && B.capacity() == 20_sl);
+   ASSERT(B(seqN{0, 3}) == A(std::vector<ImplicitInt>{3, 5, 6}));
+   ASSERT(all_zeros(B(seqN{3, 9})));
+   B.resize(4, false);
+   ASSERT(all_zeros(B) && B.data() == p);
+
+   B.shrink_to_fit();
+   ASSERT(B.capacity() == 4_sl);
+   B.resize(0);
+   B.shrink_to_fit();
+   ASSERT(B.capacity() == 0_sl && B.data() == nullptr);
+
+   // Insertions in the middle and at the front.
+   Array1D<T> C{One<T>, Zero<T>};
+   C.insert(1, Strict{T(2)});
+   C.insert_front(Strict{T(3)});
+   C.insert(2, Array1D<T>{Strict{T(4)}, Strict{T(5)}});
+   ASSERT((C == Array1D<T>{Strict{T(3)}, One<T>, Strict{T(4)}, Strict{T(5)}, Strict{T(2)},
+                           Zero<T>}));
+
+   // Appending to itself.
+   Array1D<T> D{One<T>, Zero<T>};
+   D.append(D);
+   D.append(D + D);
+   ASSERT((D == Array1D<T>{One<T>, Zero<T>, One<T>, Zero<T>, Strict{T(2)}, Zero<T>,
+                           Strict{T(2)}, Zero<T>}));
+}
+
+
+template <typename T>
+void test_push_back() {
+   CountingResource mr;
+   {
+      Array1D<T> A(0, &mr);
+      for(index_t i = 0_sl; i < 1'000_sl; ++i) {
+         A.push_back(Strict{T(i.val() % 100)});
+      }
+      A.push_back(Value{T(1)});
+
+      ASSERT(A.size() == 1'001_sl && A.capacity() >= A.size());
+      ASSERT(A[999] == Strict{T(99)} && A[1'000] == One<T>);
+      // Capacity grows geometrically.
+      ASSERT(mr.allocations <= 12);
+
+      for(index_t i = 0_sl; i < 100_sl; ++i) {
+         A.append(A(seqN{0, 10}));
+      }
+      ASSERT(A.size() == 2'001_sl && mr.allocations <= 14);
+      ASSERT(A(seqN{1'991, 10}) == A(seqN{0, 10}));
+
+      auto allocations = mr.allocations;
+      A.remove_back(1'000);
+      A.shrink_to_fit();
+      ASSERT(A.size() == 1'001_sl && A.capacity() == 1'001_sl);
+      ASSERT(mr.allocations == allocations + 1);
+   }
+   ASSERT(mr.allocations == mr.deallocations);
+}
+
+
+template <typename T>
+void test_capacity2D() {
+   CountingResource mr;
+   {
+      Array2D<T> A(0, 0, &mr);
+      Array1D<T> row = random(5, Zero<T>, One<T>);
+
+      for(int i = 0; i < 1'000; ++i) {
+         A.insert_row_back(row);
+      }
+      ASSERT(A.rows() == 1'000_sl && A.cols() == 5_sl);
+      ASSERT(A.capacity() >= A.size());
+      ASSERT(A.row(999) == row && A.row(0) == row);
+      ASSERT(mr.allocations <= 12);
+
+      auto allocations = mr.allocations;
+      A.remove_rows_back(500);
+      A.remove_row(0);
+      A.insert_rows_back(A(seqN{0, 2}, seqN{0, 5}));
+      A.resize(600, 5);
+      ASSERT(A.rows() == 600_sl && mr.allocations == allocations);
+      ASSERT(A.row(500) == row && all_zeros(A.row(501)));
+
+      A.shrink_to_fit();
+      ASSERT(A.capacity() == 3'000_sl);
+
+      A.remove_rows_front(600);
+      ASSERT(A.rows() == 0_sl && A.cols() == 0_sl);
+   }
+   ASSERT(mr.allocations == mr.deallocations);
+
+   Array2D<T> B(2, 3);
+   B.reserve(10, 3);
+   ASSERT(B.capacity() == 30_sl);
+   B.insert_rows_back(B);
+   B.insert_row_back(B.row(0) + One<T>);
+   ASSERT(B.rows() == 5_sl && B.capacity() == 30_sl);
+   ASSERT(all_zeros(B(seqN{0, 4}, seqN{0, 3})) && B.row(4) == const1D<T>(3, One<T>));
+
+   // Changing the number of columns preserves the elements.
+   B.resize(2, 2);
+   ASSERT(B == const2D<T>(2, 2, Zero<T>));
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+int main() {
+   TEST_ALL_REAL_TYPES(test_capacity1D);
+   TEST_ALL_REAL_TYPES(test_push_back);
+   TEST_ALL_REAL_TYPES(test_capacity2D);
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,175 @@
+#include "test.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+using namespace spp;
+
+
+static std::string temp_file(const std::string& name) {
+   return (std::filesystem::temp_directory_path() / ("strictpp_" + name)).string();
+}
+
+
+template <typename T>
+Array1D<T> values(long int n) {
+   Array1D<T> A(n);
+   for(long int i = 0; i < n; ++i) {
+      A[i] = Strict{T((i * 37) % 101) - T(50)};
+   }
+   return A;
+}
+
+
+// Chunks are read in order and cover the whole file, including a smaller last chunk.
+template <typename T>
+void test_chunks() {
+   const auto file = temp_file("chunks.bin");
+   auto A = values<T>(1'003);
+   save_binary(file, A);
+
+   for(long int chunk_size : {1L, 10L, 1'003L, 5'000L}) {
+      ChunkedSource<T> source{file, chunk_size};
+      ASSERT(source.chunk_size() == index_t{chunk_size});
+      for(int pass = 0; pass < 2; ++pass) {
+         std::vector<Strict<T>> B;
+         long int nchunks = 0;
+         source.for_each_chunk([&](const Array1D<T>& chunk, index_t offset) {
+            ASSERT(offset == index_t{long(B.size())} && chunk.size() <= source.chunk_size());
+            B.insert(B.end(), chunk.begin(), chunk.end());
+            ++nchunks;
+         });
+         ASSERT(std::equal(B.begin(), B.end(), A.begin(), A.end()));
+         ASSERT(nchunks == (1'003 + chunk_size - 1) / chunk_size);
+      }
+   }
+
+   if constexpr(NotQuadruple<T>) {
+      save_npy(file, A);
+      ChunkedSource<T> npy{file, 100};
+      ASSERT(sum(npy) == sum(A));
+   }
+   std::filesystem::remove(file);
+}
+
+
+template <typename T>
+void test_reductions() {
+   const auto file = temp_file("reductions.bin");
+   auto A = values<T>(10'007);
+   A[7'777] = Strict{T(-60)};
+   A[8'888] = Strict{T(60)};
+   save_binary(file, A);
+
+   ChunkedSource<T> source{file, 1'000};
+   ASSERT(sum(source) == sum(A));
+   ASSERT(stable_sum(source) == stable_sum(A));
+   ASSERT(norm2(source) == norm2(A));
+   ASSERT(min_index(source) == min_index(A) && min_index(source).first == 7'777_sl);
+   ASSERT(max_index(source) == max_index(A) && max_index(source).first == 8'888_sl);
+
+   auto f = [](const auto& x) { return abs(x - Strict{T(3)}); };
+   ASSERT(sum(source, f) == sum(f(A)));
+   ASSERT(min_index(source, f) == min_index(f(A)));
+   const auto [s, m, n] = reduce_many(source, f, stable_sum_op{}, max_op{}, norm_inf_op{});
+   ASSERT(s == stable_sum(f(A)) && m == max(f(A)) && n == norm_inf(f(A)));
+
+   execution.parallel(true).threads(4).threshold(0);
+   ASSERT(sum(source) == sum(A));
+   ASSERT(max_index(source, f) == max_index(f(A)));
+
+   // Reproducible sums do not depend on the size of chunks.
+   execution.summation(ReproducibleSum);
+   for(auto chunk_size : {1, 999, 4'096, 20'000}) {
+      ChunkedSource<T> chunks{file, chunk_size};
+      ASSERT(sum(chunks) == sum(A) && norm2(chunks, f) == norm2(f(A)));
+   }
+   execution.reset();
+   std::filesystem::remove(file);
+}
+
+
+void test_text() {
+   const auto file = temp_file("chunks.csv");
+   auto A = values<double>(100'000);
+   {
+      std::ofstream ofs{file};
+      for(long int i = 0; i < A.size().val(); ++i) {
+         ofs << A[i] << (i % 7 == 6 || i + 1 == A.size().val() ? "\n" : ", ");
+      }
+   }
+
+   ChunkedSource<double> source{file, 4'096, ','};
+   Array1D<double> B(A.size());
+   source.for_each_chunk([&](const Array1D<double>& chunk, index_t offset) {
+      B(seqN{offset, chunk.size()}) = chunk;
+   });
+   ASSERT(B == A && sum(source) == sum(A) && min_index(source) == min_index(A));
+
+   // A single line longer than the blocks read from the file is split at delimiters, and values
+   // may cross blocks.
+   Array1D<double> L = values<double>(300'000);
+   L += 0.125_sd;
+   {
+      std::ofstream ofs{file};
+      for(long int i = 0; i < L.size().val(); ++i) {
+         ofs << L[i] << (i + 1 == L.size().val() ? "" : " ,");
+      }
+   }
+   ASSERT(std::filesystem::file_size(file) > 2 << 20);
+   ChunkedSource<double> line{file, 1'000, ','};
+   ASSERT(sum(line) == sum(L) && max_index(line) == max_index(L));
+   std::ofstream{file, std::ios::app} << ", ";
+   REQUIRE_THROW(sum(line));
+
+   std::ofstream{file} << "1 2\n3\n\n 4 5 6";
+   ChunkedSource<long int> integers{file, 2};
+   ASSERT(sum(integers) == 21_sl && max_index(integers).first == 5_sl);
+
+   std::ofstream{file} << "1 2 x 4";
+   ChunkedSource<long int> invalid{file, 2};
+   REQUIRE_THROW(sum(invalid));
+   std::filesystem::remove(file);
+}
+
+
+void test_errors() {
+   const auto file = temp_file("errors.bin");
+   Array1D<double> x{};
+   save_binary(file, values<double>(100));
+   REQUIRE_THROW((ChunkedSource<double>{temp_file("does_not_exist.bin"), 10}));
+   REQUIRE_THROW((ChunkedSource<double>{file, 0}));
+   REQUIRE_THROW((ChunkedSource<float>{file, 10}));
+
+   ChunkedSource<double> source{file, 10};
+   REQUIRE_THROW(sum(source, [](const auto& y) { return y(seqN{0, 4}); }));
+
+   save_binary(file, x);
+   ChunkedSource<double> empty{file, 10};
+   ASSERT(sum(empty) == 0._sd && min_index(empty).first == -1_sl);
+
+   // Elements are protected by the checksum, which is verified after the last chunk.
+   save_binary(file, values<double>(100));
+   {
+      std::fstream fs{file, std::ios::in | std::ios::out | std::ios::binary};
+      fs.seekp(100);
+      fs.put('\x7F');
+   }
+   ChunkedSource<double> corrupted{file, 10};
+   REQUIRE_THROW(sum(corrupted));
+   std::filesystem::remove(file);
+}
+
+
+int main() {
+   TEST_ALL_REAL_TYPES(test_chunks);
+   TEST_ALL_FLOAT_TYPES(test_reductions);
+   TEST_NON_TYPE(test_text);
+   TEST_NON_TYPE(test_errors);
+   return EXIT_SUCCESS;
+}
@@ -229,6 +229,10 @@ consteval void array_ops() {
    norm1(x);
    norm1_scaled(x);
    polynomial(x.view1D(), Zero<T>);
+   sum(x, PairwiseSum);
+   mean(x, PairwiseSum);
+   dot_prod(x, x, PairwiseSum);
+   norm1(x, PairwiseSum);
 
    has_zero(x);
    all_zeros(x);
@@ -390,6 +390,51 @@ void run_col_reduce() {
 }
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Contiguous expressions are evaluated by packets, the reference is evaluated one element at a
+// time since lambdas are never applied to packets. Values are small integers, so that results
+// are exact regardless of the order of operations.
+template <typename T>
+void run_packet_sizes() {
+   auto ref = [](auto x, auto y) { return x * y + x + Strict{T(3)}; };
+
+   for(auto n : {0_sl, 1_sl, 7_sl, 8_sl, 9_sl, 15_sl, 16_sl, 17_sl, 63_sl, 64_sl, 65_sl, 100_sl}) {
+      Array1D<T> A = sequence<T>(n, One<T>, One<T>);
+      Array1D<T, Aligned> B = const1D<T>(n, Strict{T(2)});
+
+      Array1D<T> C = A * B + A + Strict{T(3)};
+      ASSERT(equal(C, generate(A, B, ref)));
+
+      Array1D<T, Aligned> D = A * B + A + Strict{T(3)};
+      ASSERT(equal(D, generate(A, B, ref)));
+
+      D = array_cast<T>(sequence<int>(n)) + B;
+      ASSERT(equal(D, generate(sequence<T>(n), B, [](auto x, auto y) { return x + y; })));
+   }
+}
+
+
+template <typename T>
+void run_packet_slices() {
+   auto ref = [](auto x, auto y) { return x + y; };
+
+   Array1D<T> A = sequence<T>(100);
+   Array1D<T, Aligned> B = sequence<T>(100, One<T>);
+   Array1D<T, Aligned> C(37);
+
+   // Slices with stride 1 start at an arbitrary offset.
+   C = A(seqN{3, 37}) + B(seqN{50, 37});
+   ASSERT(equal(C, generate(A(seqN{3, 37}), B(seqN{50, 37}), ref)));
+
+   C = A(seq{0, 72, 2}) + B(seqN{1, 37});
+   ASSERT(equal(C, generate(A(seq{0, 72, 2}), B(seqN{1, 37}), ref)));
+
+   Array2D<T> D = sequence<T>(77).view2D(7, 11);
+   Array2D<T> E = D + D(all, all) + Strict{T(2)};
+   ASSERT(equal(E, generate(D, D + Strict{T(2)}, ref)));
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 void unary() {
    run_unary_plus();
@@ -459,5 +504,7 @@ int main() {
    TEST_NON_TYPE(unary);
    TEST_NON_TYPE(binary);
    TEST_NON_TYPE(special);
+   TEST_ALL_REAL_TYPES(run_packet_sizes);
+   TEST_ALL_REAL_TYPES(run_packet_slices);
    return EXIT_SUCCESS;
 }
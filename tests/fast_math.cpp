@@ -0,0 +1,169 @@
+#include "test.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+
+using namespace spp;
+
+
+// Maximum errors in ULP documented in math_flag.hpp.
+template <typename T>
+double max_ulp(double bound_double) {
+   return SameAs<T, float> ? 1. : bound_double;
+}
+
+
+// NaNs are equal, zeros must have the same sign.
+template <typename T>
+bool same_values(const Array1D<T>& A, const Array1D<T>& B) {
+   for(index_t i = 0_sl; i < A.size(); ++i) {
+      auto x = A[i].val();
+      auto y = B[i].val();
+      if(std::isnan(x) || std::isnan(y)) {
+         if(!std::isnan(x) || !std::isnan(y)) {
+            return false;
+         }
+      } else if(x != y || std::signbit(x) != std::signbit(y)) {
+         return false;
+      }
+   }
+   return true;
+}
+
+
+#ifdef STRICT_QUAD_PRECISION
+template <typename T>
+Strict<float128> ulp_error(Strict<T> x, Strict<float128> ref) {
+   T r = abss(strict_cast<T>(ref)).val();
+   auto ulp = Strict<T>{std::nextafter(r, std::numeric_limits<T>::max()) - r};
+   return abss(strict_cast<float128>(x) - ref) / strict_cast<float128>(ulp);
+}
+
+
+// Packets are evaluated for contiguous arrays, one element at a time for the slice with
+// stride 3. Both are compared against quadruple precision.
+template <typename T>
+void check_accuracy(const Array1D<T>& A, const Array1D<float128>& R, const auto& f,
+                    double bound) {
+   Array1D<T> B = f(A);
+   Array1D<T> C(A.size());
+   for(auto first : {0_sl, 1_sl, 2_sl}) {
+      auto s = seqN{first, (A.size() - first + 2_sl) / 3_sl, 3};
+      C(s) = f(A(s));
+   }
+
+   for(index_t i = 0_sl; i < A.size(); ++i) {
+      ASSERT(ulp_error(B[i], R[i]) <= strict_cast<float128>(Strict{bound}));
+      ASSERT(ulp_error(C[i], R[i]) <= strict_cast<float128>(Strict{bound}));
+   }
+}
+
+
+template <typename T>
+void test_fast_math_accuracy() {
+   constexpr long int n = 10'007;
+   auto val = [](auto x) { return Strict<T>{static_cast<T>(x)}; };
+
+   Array1D<T> A = random(n, val(-80), val(80));
+   check_accuracy(A, exp(array_cast<float128>(A)),
+                  [](const auto& X) { return exp(X, FastMath); }, max_ulp<T>(1.5));
+
+   Array1D<T> B = random(n, val(-80), val(80));
+   B = exp(B);
+   check_accuracy(B, log(array_cast<float128>(B)),
+                  [](const auto& X) { return log(X, FastMath); }, max_ulp<T>(1.));
+   check_accuracy(B, sqrt(array_cast<float128>(B)),
+                  [](const auto& X) { return sqrt(X, FastMath); }, 0.5);
+
+   for(auto high : {4, 1'000, 100'000}) {
+      Array1D<T> S = random(n, val(-high), val(high));
+      check_accuracy(S, sin(array_cast<float128>(S)),
+                     [](const auto& X) { return sin(X, FastMath); }, max_ulp<T>(2.5));
+      check_accuracy(S, cos(array_cast<float128>(S)),
+                     [](const auto& X) { return cos(X, FastMath); }, max_ulp<T>(2.5));
+   }
+
+   Array1D<T> P = random(n, val(-8), val(8));
+   P = exp(P);
+   for(auto p : {0.5, -1.7, 2.5, 10.3}) {
+      auto pw = Strict<T>{static_cast<T>(p)};
+      check_accuracy(P, pow(array_cast<float128>(P), strict_cast<float128>(pw)),
+                     [pw](const auto& X) { return pow(X, pw, FastMath); },
+                     max_ulp<T>(2. + std::abs(p) / 8.));
+   }
+}
+#endif
+
+
+template <typename T>
+void test_fast_math_special() {
+   constexpr T inf = std::numeric_limits<T>::infinity();
+   constexpr T nan = std::numeric_limits<T>::quiet_NaN();
+   constexpr T min = std::numeric_limits<T>::min();
+   constexpr T max = std::numeric_limits<T>::max();
+
+   // Values outside of the ranges of the kernels are passed to the standard library.
+   Array1D<T> A = {Strict<T>{inf},  Strict<T>{-inf},  Strict<T>{nan}, Strict<T>{T(0)},
+                   Strict<T>{-T(0)}, Strict<T>{-T(1)}, Strict<T>{T(1)}};
+
+   ASSERT(same_values<T>(exp(A(seqN{0, 5}), FastMath), exp(A(seqN{0, 5}), ExactMath)));
+   ASSERT(same_values<T>(log(A, FastMath), log(A, ExactMath)));
+   ASSERT(same_values<T>(sqrt(A, FastMath), sqrt(A, ExactMath)));
+   for(auto p : {T(2), T(-0.5), nan}) {
+      ASSERT(same_values<T>(pow(A, Strict{p}, FastMath), pow(A, Strict{p}, ExactMath)));
+   }
+
+   // Overflow, underflow, and subnormals.
+   Array1D<T> E = {Strict<T>{T(-750)}, Strict<T>{T(710)}, Strict<T>{max}, Strict<T>{min / 4},
+                   Strict<T>{-min / 4}};
+   ASSERT(same_values<T>(exp(E, FastMath), exp(E, ExactMath)));
+
+   Array1D<T> B = sin(A, FastMath);
+   Array1D<T> C = cos(A, FastMath);
+   ASSERT(isnans(B[0]) && isnans(B[1]) && isnans(B[2]));
+   ASSERT(isnans(C[0]) && isnans(C[1]) && isnans(C[2]));
+   ASSERT(B[3] == Zero<T> && !std::signbit(B[3].val()));
+   ASSERT(B[4] == Zero<T> && std::signbit(B[4].val()));
+   ASSERT(C[3] == One<T> && C[4] == One<T>);
+}
+
+
+template <typename T>
+void test_fast_math_policy() {
+   Array1D<T> A = random(1'000, Strict<T>{T(-10)}, Strict<T>{T(10)});
+
+   Array1D<T> B = exp(A);
+   Array1D<T> C = generate(A, [](auto x) { return exps(x); });
+   ASSERT(B == C);
+
+   execution.math(FastMath);
+   ASSERT(execution.math() == FastMath);
+   B = exp(A);
+   C = exp(A, FastMath);
+   ASSERT(same_values<T>(B, C));
+   C = exp(A, ExactMath);
+   ASSERT(same_values<T>(C, generate(A, [](auto x) { return exps(x); })));
+
+   // Other floating-point types are always evaluated exactly.
+   Array1D<long double> L = array_cast<long double>(A);
+   ASSERT(exp(L) == generate(L, [](auto x) { return exps(x); }));
+
+   execution.reset();
+   ASSERT(execution.math() == ExactMath);
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+int main() {
+#ifdef STRICT_QUAD_PRECISION
+   PERFORM_FUNCTION_CALLS(test_fast_math_accuracy, test_fast_math_accuracy<float>();
+                          test_fast_math_accuracy<double>());
+#endif
+   PERFORM_FUNCTION_CALLS(test_fast_math_special, test_fast_math_special<float>();
+                          test_fast_math_special<double>());
+   PERFORM_FUNCTION_CALLS(test_fast_math_policy, test_fast_math_policy<float>();
+                          test_fast_math_policy<double>());
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,183 @@
+#include "test.hpp"
+
+#include <cstdlib>
+#include <sstream>
+
+
+using namespace spp;
+
+
+template <typename T>
+using ColArray2D = Array2D<T, Unaligned, ColMajor>;
+
+
+template <typename T>
+void test_col_major() {
+   Array2D<T> A = random<T>(5, 7);
+   ColArray2D<T> B = A;
+   ASSERT(B == A);
+   ASSERT(B.layout() == ColMajor && A.layout() == RowMajor);
+
+   // Storage is ordered by columns, linear indexing is ordered by rows.
+   for(index_t i = 0_sl; i < A.rows(); ++i) {
+      for(index_t j = 0_sl; j < A.cols(); ++j) {
+         ASSERT(B.data()[(j * A.rows() + i).val()] == A(i, j));
+         ASSERT(B.un(i * A.cols() + j) == A.un(i, j));
+      }
+   }
+   ASSERT(B.view1D() == A.view1D());
+
+   // Large arrays are copied by blocks.
+   Array2D<T> C = random<T>(131, 77);
+   ColArray2D<T> D(131, 77);
+   D = C;
+   ASSERT(D == C);
+   Array2D<T> E(131, 77);
+   E = D;
+   ASSERT(E == C);
+   ColArray2D<T> F = D;
+   ASSERT(F == C);
+
+   // Expressions mixing layouts.
+   ColArray2D<T> G = C + D;
+   ASSERT(G == C * Strict{T(2)});
+   Array2D<T> H = exp(G - D);
+   ASSERT(H == exp(C));
+   D += C;
+   ASSERT(D == C * Strict{T(2)});
+}
+
+
+template <typename T>
+void test_col_major_views() {
+   Array2D<T> A = random<T>(4, 6);
+   ColArray2D<T> B = A;
+
+   ASSERT(B.row(1) == A.row(1) && B.row(last) == A.row(last));
+   ASSERT(B.col(2) == A.col(2) && B.col(last) == A.col(last));
+   ASSERT(B.diag() == A.diag());
+   for(long int i = -3; i < 6; ++i) {
+      ASSERT(B.diag(i) == A.diag(i));
+   }
+   ASSERT(B(seqN{1, 2}, seqN{2, 3}) == A(seqN{1, 2}, seqN{2, 3}));
+
+   B.row(0) = Zero<T>;
+   B.col(5) = One<T>;
+   A.row(0) = Zero<T>;
+   A.col(5) = One<T>;
+   ASSERT(B == A);
+
+   const ColArray2D<T>& Bc = B;
+   ASSERT(Bc.col(0) == A.col(0) && Bc.row(3) == A.row(3) && Bc.diag(1) == A.diag(1));
+   ASSERT(col_reduce(B, [](auto col) { return sum(col); })
+          == col_reduce(A, [](auto col) { return sum(col); }));
+   ASSERT(row_reduce(B, [](auto row) { return sum(row); })
+          == row_reduce(A, [](auto row) { return sum(row); }));
+
+   auto rit = RowIt{B};
+   auto cit = ColIt{B};
+   ASSERT(*(rit.begin() + 2) == A.row(2));
+   ASSERT(*(cit.begin() + 4) == A.col(4));
+   ASSERT(*cit.rbegin() == A.col(last));
+}
+
+
+template <typename T>
+void test_col_major_resize() {
+   Array2D<T> A = random<T>(3, 4);
+   ColArray2D<T> B = A;
+
+   B.insert_col_back(A.col(0));
+   A.insert_col_back(A.col(0));
+   ASSERT(B == A);
+   B.insert_rows(1, A(seqN{0, 2}, place::all));
+   A.insert_rows(1, A(seqN{0, 2}, place::all));
+   ASSERT(B == A);
+   B.remove_cols(1, 2);
+   A.remove_cols(1, 2);
+   ASSERT(B == A);
+   B.remove_row(0);
+   A.remove_row(0);
+   ASSERT(B == A);
+
+   B.resize(6, 3);
+   A.resize(6, 3);
+   ASSERT(B == A);
+   B.remove_cols_front(3);
+   ASSERT(B.empty() && B.rows() == 0_sl);
+}
+
+
+template <typename T>
+bool is_transpose(const auto& A, const auto& B) {
+   if(A.rows() != B.cols() || A.cols() != B.rows()) {
+      return false;
+   }
+   for(index_t i = 0_sl; i < A.rows(); ++i) {
+      for(index_t j = 0_sl; j < A.cols(); ++j) {
+         if(A(i, j) != B(j, i)) {
+            return false;
+         }
+      }
+   }
+   return true;
+}
+
+
+template <typename T>
+void test_transpose() {
+   Array2D<T> A = random<T>(131, 77);
+   ColArray2D<T> C = A;
+
+   // Copied by tiles and blocks, including the remainders.
+   Array2D<T> B = transpose(A);
+   ASSERT(is_transpose<T>(A, B));
+   ColArray2D<T> D = transpose(A);
+   ASSERT(D == B);
+   B = transpose(C);
+   ASSERT(is_transpose<T>(A, B));
+   D = transpose(C);
+   ASSERT(is_transpose<T>(A, D));
+
+   auto S = A(seqN{3, 45}, seqN{1, 70});
+   Array2D<T> E = transpose(S);
+   ASSERT(is_transpose<T>(S, E));
+   Array2D<T> E2 = transpose(A + C);
+   ASSERT(is_transpose<T>(A + A, E2));
+   ASSERT(transpose(A).layout() == ColMajor && transpose(C).layout() == RowMajor);
+
+   Array2D<T> F = A(seqN{0, 77}, place::all);
+   Array2D<T> G = transpose(F);
+   transpose_in_place(F);
+   ASSERT(F == G);
+   ColArray2D<T> D2 = F;
+   transpose_in_place(D2);
+   ASSERT(is_transpose<T>(D2, G));
+
+   auto H = F(seqN{5, 40}, seqN{10, 40});
+   Array2D<T> H0 = H;
+   transpose_in_place(H);
+   ASSERT(is_transpose<T>(H, H0));
+}
+
+
+void test_col_major_io() {
+   std::stringstream ss;
+   ss << "1 2 3\n4 5 6\n";
+   ColArray2D<int> A;
+   ss >> A;
+   ASSERT(A == sequence<int>(6, 1_si).view2D(2, 3));
+   const auto* p = A.data();
+   ASSERT(p[0] == 1_si && p[1] == 4_si && p[2] == 2_si && p[5] == 6_si);
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+int main() {
+   TEST_ALL_FLOAT_TYPES(test_col_major);
+   TEST_ALL_REAL_TYPES(test_col_major_views);
+   TEST_ALL_REAL_TYPES(test_col_major_resize);
+   TEST_ALL_REAL_TYPES(test_transpose);
+   test_col_major_io();
+   return EXIT_SUCCESS;
+}
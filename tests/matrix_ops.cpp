@@ -0,0 +1,128 @@
+#include "test.hpp"
+
+#include <cstdlib>
+
+
+using namespace spp;
+
+
+// Small integers, so that products are exact in any order of summation.
+template <typename T>
+Array2D<T> small_ints(long int m, long int n, long int seed) {
+   Array2D<T> A(m, n);
+   for(long int i = 0; i < m; ++i) {
+      for(long int j = 0; j < n; ++j) {
+         A(i, j) = Strict{T((i * 7 + j * 3 + seed) % 5)};
+      }
+   }
+   return A;
+}
+
+
+template <typename T>
+Array2D<T> naive_prod(const auto& A, const auto& B) {
+   Array2D<T> C(A.rows(), B.cols());
+   for(index_t i = 0_sl; i < A.rows(); ++i) {
+      for(index_t j = 0_sl; j < B.cols(); ++j) {
+         for(index_t p = 0_sl; p < A.cols(); ++p) {
+            C(i, j) += A(i, p) * B(p, j);
+         }
+      }
+   }
+   return C;
+}
+
+
+template <typename T>
+void test_matrix_prod() {
+   // Sizes that cross the blocks and are not multiples of the register tile.
+   for(auto [m, k, n] : {std::tuple{0L, 0L, 0L}, {1L, 1L, 1L}, {7L, 5L, 9L},
+                         {101L, 300L, 37L}, {5L, 3L, 2'100L}}) {
+      auto A = small_ints<T>(m, k, 0);
+      auto B = small_ints<T>(k, n, 1);
+      ASSERT(matrix_prod(A, B) == naive_prod<T>(A, B));
+
+      Array2D<T, Unaligned, ColMajor> AC = A;
+      Array2D<T, Unaligned, ColMajor> C(m, n);
+      matrix_prod(AC, B, C);
+      ASSERT(C == naive_prod<T>(A, B));
+   }
+
+   // Slices, expressions, and the destination being a slice.
+   auto A = small_ints<T>(40, 50, 2);
+   auto B = small_ints<T>(60, 30, 3);
+   auto S = B(seqN{5, 50}, seqN{0, 15, 2});
+   ASSERT(matrix_prod(A + A, S) == naive_prod<T>(A + A, S));
+   auto AS = naive_prod<T>(A, S);
+   ASSERT(matrix_prod(transpose(S), transpose(A)) == transpose(AS));
+
+   Array2D<T> C(50, 50);
+   matrix_prod(A(seqN{0, 20}, place::all), S, C(seqN{10, 20}, seqN{5, 15}));
+   ASSERT(C(seqN{10, 20}, seqN{5, 15}) == naive_prod<T>(A(seqN{0, 20}, place::all), S));
+   ASSERT(all_zeros(C(seqN{0, 10}, place::all)) && all_zeros(C(place::all, seqN{0, 5})));
+
+   FixedArray2D<T, 3, 4> F1 = small_ints<T>(3, 4, 1);
+   FixedArray2D<T, 4, 2> F2 = small_ints<T>(4, 2, 2);
+   FixedArray2D<T, 3, 2> F3;
+   matrix_prod(F1, F2, F3);
+   ASSERT(F3 == naive_prod<T>(F1, F2));
+}
+
+
+template <typename T>
+void test_matrix_vector_prod() {
+   for(auto [m, n] : {std::pair{1L, 1L}, {37L, 101L}, {300L, 17L}}) {
+      auto A = small_ints<T>(m, n, 0);
+      auto x = small_ints<T>(n, 1, 1);
+      auto Ax = naive_prod<T>(A, x);
+      auto y = Ax.view1D();
+      ASSERT(matrix_vector_prod(A, x.view1D()) == y);
+
+      Array2D<T, Unaligned, ColMajor> AC = A;
+      ASSERT(matrix_vector_prod(AC, x.view1D()) == y);
+      ASSERT(matrix_vector_prod(A + A, x.col(0)) == y + y);
+   }
+
+   ASSERT(matrix_vector_prod(Array2D<T>{}, Array1D<T>{}).empty());
+
+   auto A = small_ints<T>(30, 40, 2);
+   auto X = small_ints<T>(1, 80, 3);
+   auto x = X.row(0)(seqN{0, 40, 2});
+   Array1D<T> y(60);
+   matrix_vector_prod(A, x, y(seqN{10, 30}));
+   Array1D<T> x_copy = x;
+   auto Ax = naive_prod<T>(A, x_copy.view2D(40, 1));
+   ASSERT(y(seqN{10, 30}) == Ax.view1D());
+   ASSERT(all_zeros(y(seqN{0, 10})) && all_zeros(y(seqN{40, 20})));
+}
+
+
+template <typename T>
+void test_parallel_prod() {
+   execution.parallel(true).threads(4).threshold(0);
+   auto A = small_ints<T>(133, 70, 0);
+   auto B = small_ints<T>(70, 45, 1);
+   auto AB = naive_prod<T>(A, B);
+   ASSERT(matrix_prod(A, B) == AB);
+   ASSERT(matrix_vector_prod(A, B.col(3)) == AB.col(3));
+   execution.reset();
+}
+
+
+template <typename T>
+constexpr bool constexpr_prod() {
+   auto A = small_ints<T>(3, 4, 0);
+   auto B = small_ints<T>(4, 2, 1);
+   auto AB = naive_prod<T>(A, B);
+   return bool{matrix_prod(A, B) == AB} && bool{matrix_vector_prod(A, B.col(0)) == AB.col(0)};
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+int main() {
+   TEST_ALL_REAL_TYPES(test_matrix_prod);
+   TEST_ALL_REAL_TYPES(test_matrix_vector_prod);
+   TEST_ALL_REAL_TYPES(test_parallel_prod);
+   ASSERT(constexpr_prod<double>());
+   return EXIT_SUCCESS;
+}
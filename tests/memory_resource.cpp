@@ -0,0 +1,134 @@
+#include "test.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory_resource>
+#include <thread>
+
+
+using namespace spp;
+
+
+class TrackingResource : public std::pmr::memory_resource {
+public:
+   long int allocations = 0;
+   long int bytes = 0;
+   std::size_t max_alignment = 0;
+
+private:
+   void* do_allocate(std::size_t n, std::size_t alignment) override {
+      ++allocations;
+      bytes += static_cast<long int>(n);
+      max_alignment = std::max(max_alignment, alignment);
+      return std::pmr::new_delete_resource()->allocate(n, alignment);
+   }
+
+   void do_deallocate(void* p, std::size_t n, std::size_t alignment) override {
+      --allocations;
+      bytes -= static_cast<long int>(n);
+      std::pmr::new_delete_resource()->deallocate(p, n, alignment);
+   }
+
+   bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+      return this == &other;
+   }
+};
+
+
+bool is_aligned(const void* p, std::size_t alignment) {
+   return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+
+
+template <typename T>
+void test_array_resource1D() {
+   TrackingResource mr;
+   {
+      Array1D<T> A(10, &mr);
+      Array1D<T, Aligned> B(10, &mr);
+      ASSERT(A.resource() == &mr && B.resource() == &mr);
+      ASSERT(mr.allocations == 2);
+      ASSERT(mr.max_alignment == 64);
+      ASSERT(is_aligned(B.data(), 64));
+      ASSERT(all_zeros(A) && all_zeros(B));
+
+      // Reallocations use the resource of the array.
+      A.resize(20);
+      A.insert_back(One<T>);
+      A.remove_front();
+      A.resize_and_assign(Array1D<T>(7, One<T>));
+      ASSERT(A.resource() == &mr && A.size() == 7_sl);
+      ASSERT(mr.allocations == 2);
+      ASSERT(mr.bytes == 7 * long(sizeof(T)) + 10 * long(sizeof(T)));
+
+      // Copies use the default resource.
+      Array1D<T> C = A;
+      ASSERT(C.resource() == nullptr && C == A);
+
+      Array1D<T> D = std::move(A);
+      ASSERT(D.resource() == &mr);
+   }
+   ASSERT(mr.allocations == 0 && mr.bytes == 0);
+
+   Array1D<T> E(0, &mr);
+   ASSERT(E.empty() && mr.allocations == 0);
+}
+
+
+template <typename T>
+void test_array_resource2D() {
+   TrackingResource mr;
+   {
+      Array2D<T> A(3, 4, &mr);
+      Array2D<T, Aligned> B(3, 4, &mr);
+      ASSERT(A.resource() == &mr && B.resource() == &mr);
+      ASSERT(is_aligned(B.data(), 64));
+
+      A.resize(5, 5);
+      A.remove_row(0);
+      A.insert_col_back(Array1D<T>(4));
+      A.resize_and_assign(const2D<T>(2, 2, One<T>));
+      ASSERT(A.resource() == &mr);
+      ASSERT(A == const2D<T>(2, 2, One<T>));
+      ASSERT(mr.allocations == 2);
+   }
+   ASSERT(mr.allocations == 0);
+}
+
+
+template <typename T>
+void test_default_resource() {
+   ASSERT(get_default_array_resource() == nullptr);
+
+   std::pmr::monotonic_buffer_resource arena;
+   {
+      ScopedArrayResource scope(&arena);
+      ASSERT(get_default_array_resource() == &arena);
+
+      Array1D<T> A(100);
+      Array2D<T, Aligned> B(10, 10);
+      Array1D<T> C = A + A;
+      ASSERT(A.resource() == &arena && B.resource() == &arena && C.resource() == &arena);
+      ASSERT(is_aligned(B.data(), 64));
+
+      // The default resource is local to each thread.
+      std::thread t([]() { ASSERT(Array1D<T>(10).resource() == nullptr); });
+      t.join();
+
+      TrackingResource mr;
+      Array1D<T> D(10, &mr);
+      ASSERT(D.resource() == &mr);
+   }
+
+   ASSERT(get_default_array_resource() == nullptr);
+   ASSERT(Array1D<T>(10).resource() == nullptr);
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+int main() {
+   TEST_ALL_REAL_TYPES(test_array_resource1D);
+   TEST_ALL_REAL_TYPES(test_array_resource2D);
+   TEST_ALL_REAL_TYPES(test_default_resource);
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,300 @@
+#include "test.hpp"
+
+#include <bit>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+using namespace spp;
+
+
+#define TEST_NPY_TYPES(function_name)                                      \
+   PERFORM_FUNCTION_CALLS(function_name, function_name<bool>();            \
+                          function_name<int>();                            \
+                          function_name<long int>();                       \
+                          function_name<unsigned int>();                   \
+                          function_name<unsigned long int>();              \
+                          function_name<float>();                          \
+                          function_name<double>();                         \
+                          function_name<long double>())
+
+
+static std::string temp_file(const std::string& name) {
+   return (std::filesystem::temp_directory_path() / ("strictpp_" + name)).string();
+}
+
+
+template <typename T>
+Array2D<T> values(long int m, long int n) {
+   Array2D<T> A(m, n);
+   for(long int i = 0; i < m; ++i) {
+      for(long int j = 0; j < n; ++j) {
+         A(i, j) = Strict{T((i * 5 + j * 3) % 7)};
+      }
+   }
+   return A;
+}
+
+
+static std::string read_file(const std::string& file_path) {
+   std::ifstream ifs{file_path, std::ios::binary};
+   return {std::istreambuf_iterator<char>{ifs}, std::istreambuf_iterator<char>{}};
+}
+
+
+static void write_file(const std::string& file_path, const std::string& s) {
+   std::ofstream{file_path, std::ios::binary}.write(s.data(), long(s.size()));
+}
+
+
+// .npy file of the given version with the header padded to the given size of the preamble.
+static std::string npy_file(std::string dict, const std::string& data, int version = 1,
+                            long int preamble_size = 128) {
+   const long int prefix = version == 1 ? 10 : 12;
+   dict.append(std::size_t(preamble_size - prefix - long(dict.size()) - 1), ' ');
+   dict += '\n';
+   std::string s = "\x93NUMPY";
+   s += char(version);
+   s += '\0';
+   for(int k = 0; k < prefix - 8; ++k) {
+      s += char(dict.size() >> (8 * k));
+   }
+   return s + dict + data;
+}
+
+
+template <typename T>
+void test_round_trip() {
+   const auto file = temp_file("round_trip.npy");
+
+   for(long int n : {0L, 1L, 7L, 1'000L}) {
+      Array1D<T> A(n);
+      for(long int i = 0; i < n; ++i) {
+         A[i] = Strict{T(i % 7)};
+      }
+      save_npy(file, A);
+      ASSERT(long(read_file(file).size()) % 64 == n * long(sizeof(T)) % 64);
+      Array1D<T, Aligned> B(3);
+      load_npy(file, B);
+      ASSERT(B == A);
+   }
+
+   auto A = values<T>(13, 17);
+   Array2D<T, Unaligned, ColMajor> AC = A;
+   save_npy(file, AC);
+   ASSERT(read_file(file).find("'fortran_order': True, 'shape': (13, 17)") != std::string::npos);
+   Array2D<T> B;
+   Array2D<T, Aligned, ColMajor> BC;
+   load_npy(file, B);
+   load_npy(file, BC);
+   ASSERT(B == A && BC == A);
+
+   save_npy(file, transpose(A));
+   load_npy(file, B);
+   ASSERT(B == transpose(A));
+   std::filesystem::remove(file);
+}
+
+
+// Files written by NumPy with various header formats, C and Fortran order, and byte orders.
+void test_numpy_files() {
+   const auto file = temp_file("numpy.npy");
+   std::string data;
+   for(char k = 0; k < 6; ++k) {
+      data += std::string(7, '\0') + char(k + 1);
+   }
+
+   write_file(file, npy_file("{\"shape\": (2, 3), \"fortran_order\": True, \"descr\": \">i8\"}",
+                             data, 2, 128));
+   Array2D<long int> A;
+   load_npy(file, A);
+   ASSERT((A == Array2D<long int>{{1_sl, 3_sl, 5_sl}, {2_sl, 4_sl, 6_sl}}));
+
+   write_file(file, npy_file("{'descr': '>i8', 'fortran_order': False, 'shape': (6L,), }", data));
+   Array1D<long int> x;
+   load_npy(file, x);
+   ASSERT((x == Array1D<long int>{1_sl, 2_sl, 3_sl, 4_sl, 5_sl, 6_sl}));
+
+   if constexpr(std::endian::native == std::endian::little) {
+      write_file(file, npy_file("{'descr': '<f8', 'fortran_order': False, 'shape': (1,), }",
+                                std::string("\0\0\0\0\0\0\xF8\x3F", 8), 3, 192));
+      Array1D<double> y;
+      load_npy(file, y);
+      ASSERT(y == Array1D<double>{1.5_sd});
+   }
+   std::filesystem::remove(file);
+}
+
+
+void test_errors() {
+   const auto file = temp_file("errors.npy");
+   Array1D<double> x;
+   Array2D<double> A;
+   save_npy(file, Array1D<double>{1._sd, 2._sd, 3._sd});
+   REQUIRE_NOT_THROW(load_npy(file, x));
+   Array1D<float> y;
+   REQUIRE_THROW(load_npy(file, y));
+   REQUIRE_THROW(load_npy(file, A));
+   REQUIRE_THROW(load_npy(temp_file("does_not_exist.npy"), x));
+
+   auto s = read_file(file);
+   write_file(file, s.substr(0, s.size() - 1));
+   REQUIRE_THROW(load_npy(file, x));
+   write_file(file, "NUMPY" + s);
+   REQUIRE_THROW(load_npy(file, x));
+
+   const std::string data(24, '\0');
+   write_file(file, npy_file("{'descr': '<f8', 'fortran_order': False, 'shape': (1, 1, 3), }",
+                             data));
+   REQUIRE_THROW(load_npy(file, A));
+   write_file(file, npy_file("{'descr': [('a', '<f8')], 'fortran_order': False, 'shape': (3,), }",
+                             data));
+   REQUIRE_THROW(load_npy(file, x));
+   write_file(file, npy_file("{'descr': '<f8', 'shape': (3,), }", data));
+   REQUIRE_THROW(load_npy(file, x));
+   std::filesystem::remove(file);
+}
+
+
+template <typename T>
+void test_npz() {
+   const auto file = temp_file("arrays.npz");
+   auto A = values<T>(9, 4);
+   Array2D<T, Unaligned, ColMajor> AC = A;
+   Array1D<T> x = A.view1D();
+   {
+      NpzWriter npz{file};
+      npz.add("x", x);
+      npz.add("A", A);
+      npz.add("AC", AC);
+      npz.add("empty", Array1D<T>{});
+      npz.close();
+      REQUIRE_THROW(npz.add("y", x));
+   }
+   ASSERT((npz_names(file) == std::vector<std::string>{"x", "A", "AC", "empty"}));
+
+   Array1D<T> y, e(3);
+   Array2D<T> B, BC;
+   load_npz(file, "x", y);
+   load_npz(file, "A", B);
+   load_npz(file, "AC", BC);
+   load_npz(file, "empty", e);
+   ASSERT(y == x && B == A && BC == A && e.empty());
+   REQUIRE_THROW(load_npz(file, "z", y));
+   REQUIRE_THROW(load_npz(file, "A", y));
+   std::filesystem::remove(file);
+}
+
+
+void test_npz_errors() {
+   const auto file = temp_file("errors.npz");
+   {
+      NpzWriter npz{file};
+      npz.add("x", Array1D<double>{1._sd, 2._sd, 3._sd});
+   }
+   const auto s = read_file(file);
+   Array1D<double> x;
+   load_npz(file, "x", x);
+   ASSERT((x == Array1D<double>{1._sd, 2._sd, 3._sd}));
+
+   // Elements are protected by the CRC-32 of the member.
+   auto t = s;
+   t[t.find('\n', t.find("\x93NUMPY")) + 1] ^= 1;
+   write_file(file, t);
+   REQUIRE_THROW(load_npz(file, "x", x));
+
+   // Compressed members are not supported.
+   t = s;
+   t[8] = t[s.rfind("PK\x01\x02", std::string::npos) + 10] = 8;
+   write_file(file, t);
+   REQUIRE_THROW(load_npz(file, "x", x));
+
+   write_file(file, s.substr(0, s.size() - 10));
+   REQUIRE_THROW(load_npz(file, "x", x));
+   REQUIRE_THROW(npz_names(file));
+   std::filesystem::remove(file);
+}
+
+
+#ifdef STRICT_HAS_MMAP
+template <typename T>
+void test_mapped() {
+   const auto npy = temp_file("mapped.npy");
+   const auto npz = temp_file("mapped.npz");
+   auto A = values<T>(31, 9);
+   Array2D<T, Unaligned, ColMajor> AC = A;
+   save_npy(npy, A);
+   {
+      NpzWriter w{npz};
+      w.add("A", A);
+      w.add("AC", AC);
+      w.add("x", A.row(3));
+   }
+
+   MappedArray<T> M{npy};
+   ASSERT(M.dims() == 2_sl && M.rows() == 31_sl && M.cols() == 9_sl && M.layout() == RowMajor);
+   ASSERT(M.view2D() == A);
+   REQUIRE_THROW(M.verify());
+
+   MappedArray<T> N{npz, "A"};
+   ASSERT(N.view2D() == A && N.verify());
+   MappedArray<T> NC{npz, "AC"};
+   Array2D<T> ACT = transpose(AC);
+   ASSERT(NC.layout() == ColMajor && NC.view1D() == ACT.view1D() && NC.verify());
+   REQUIRE_THROW(NC.view2D());
+   MappedArray<T> x{npz, "x"};
+   ASSERT(x.dims() == 1_sl && x.view1D() == A.row(3));
+   REQUIRE_THROW((MappedArray<T>{npz, "y"}));
+
+   std::filesystem::remove(npy);
+   std::filesystem::remove(npz);
+}
+
+
+void test_mapped_errors() {
+   const auto file = temp_file("mapped_errors.npy");
+   const std::string data(24, '\0');
+   write_file(file, npy_file("{'descr': '<f8', 'fortran_order': False, 'shape': (3,), }", data,
+                             1, 68));
+   Array1D<double> x;
+   load_npy(file, x);
+   ASSERT((x == Array1D<double>{0._sd, 0._sd, 0._sd}));
+   // Elements start at offset 68, which is not aligned.
+   REQUIRE_THROW(MappedArray<double>{file});
+
+   write_file(file, npy_file("{'descr': '>f8', 'fortran_order': False, 'shape': (3,), }", data));
+   if constexpr(std::endian::native == std::endian::little) {
+      REQUIRE_THROW(MappedArray<double>{file});
+   }
+   REQUIRE_THROW(MappedArray<long int>{file});
+
+   // Corrupted rows, the numbers of elements or bytes overflow.
+   for(const auto* shape : {"(2305843009213693952,)", "(4294967296, 4294967296)", "(4,)"}) {
+      write_file(file, npy_file("{'descr': '<f8', 'fortran_order': False, 'shape': "
+                                   + std::string{shape} + ", }",
+                                data));
+      REQUIRE_THROW(MappedArray<double>{file});
+      REQUIRE_THROW(load_npy(file, x));
+      ASSERT(x.size() == 3_sl);
+   }
+   std::filesystem::remove(file);
+}
+#endif
+
+
+int main() {
+   TEST_NPY_TYPES(test_round_trip);
+   TEST_NON_TYPE(test_numpy_files);
+   TEST_NON_TYPE(test_errors);
+   TEST_NPY_TYPES(test_npz);
+   TEST_NON_TYPE(test_npz_errors);
+#ifdef STRICT_HAS_MMAP
+   TEST_NPY_TYPES(test_mapped);
+   TEST_NON_TYPE(test_mapped_errors);
+#endif
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,279 @@
+#include "test.hpp"
+
+#include <cstdlib>
+#include <tuple>
+
+
+using namespace spp;
+using namespace spp::place;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename T>
+void test_parallel_assign1D() {
+   execution.parallel(true).threads(4).threshold(0);
+
+   // Sizes that do not split evenly into cache lines and threads.
+   for(auto n : {0_sl, 1_sl, 7_sl, 100_sl, 1'001_sl}) {
+      auto A = sequence<T>(n, Zero<T>, One<T>);
+      auto B = const1D<T>(n, Strict{T(2)});
+
+      Array1D<T> C(n);
+      C = A * B + One<T>;
+      ASSERT(C == A * B + One<T>);
+
+      Array1D<T, Aligned> D = A + B;
+      ASSERT(D == A + B);
+
+      D += A;
+      ASSERT(D == A + A + B);
+
+      D = One<T>;
+      ASSERT(D == const1D<T>(n, One<T>));
+   }
+
+   execution.reset();
+}
+
+
+template <typename T>
+void test_parallel_assign2D() {
+   execution.parallel(true).threads(3).threshold(0);
+
+   for(auto [m, n] : {std::pair{0_sl, 0_sl}, std::pair{1_sl, 5_sl}, std::pair{37_sl, 11_sl}}) {
+      Array2D<T> A = const2D<T>(m, n, One<T>);
+      Array2D<T> B(m, n);
+      B = transpose(transpose(A)) + A;
+      ASSERT(B == A + A);
+
+      Array2D<T> C(m, n);
+      C(all, all) = B;
+      C = B(all, all) + A(all, all);
+      ASSERT(C == A + A + A);
+   }
+
+   execution.reset();
+}
+
+
+template <typename T>
+void test_parallel_par() {
+   ASSERT(!execution.is_parallel());
+   execution.threads(4).threshold(0);
+
+   auto A = sequence<T>(1'000, Zero<T>, One<T>);
+   Array1D<T> B(A.size());
+   B.par() = A + A;
+   ASSERT(B == A + A);
+
+   B.par() += A;
+   ASSERT(B == A + A + A);
+
+   B.par() = Zero<T>;
+   ASSERT(all_zeros(B));
+
+   Array2D<T> C(17, 19);
+   C.par() = const2D<T>(17, 19, One<T>);
+   ASSERT(C == const2D<T>(17, 19, One<T>));
+
+   // Random expressions are evaluated in parallel.
+   B.par() = random(1'000, Zero<T>, One<T>);
+   ASSERT(all_of(B, [](auto x) { return x >= Zero<T> && x <= One<T>; }));
+
+   ASSERT(!execution.is_parallel());
+   execution.reset();
+}
+
+
+template <typename T>
+void test_parallel_threshold() {
+   execution.parallel(true).threads(2).threshold(100);
+
+   auto A = sequence<T>(99, Zero<T>, One<T>);
+   Array1D<T> B = A + A;
+   ASSERT(B == A + A);
+
+   auto C = sequence<T>(100, Zero<T>, One<T>);
+   Array1D<T> D = C + C;
+   ASSERT(D == C + C);
+
+   execution.reset();
+}
+
+
+void test_parallel_exceptions() {
+   execution.parallel(true).threads(4).threshold(0);
+
+   Array1D<int> A(1'000, 1_si);
+   Array1D<int> B(1'000, 1_si);
+   B[999] = 0_si;
+   Array1D<int> C(1'000);
+   REQUIRE_THROW(C = A / B);
+
+   // The pool must remain usable after an exception.
+   C = A + B;
+   ASSERT(C[998] == 2_si && C[999] == 1_si);
+
+   execution.reset();
+}
+
+
+void test_parallel_nested() {
+   execution.parallel(true).threads(4).threshold(0);
+
+   Array2D<double> A = const2D<double>(100, 100, 1._sd);
+   Array1D<double> x = row_reduce(A, [](auto const& row) { return sum(row); });
+   ASSERT(x == const1D<double>(100, 100._sd));
+
+   execution.reset();
+}
+
+
+template <typename T>
+void test_parallel_reductions() {
+   Array1D<T> A = random(10'000, Zero<T>, One<T>);
+   Array1D<T> B = random(10'000, Zero<T>, One<T>);
+   Array2D<T> C = random(101, 99, Zero<T>, One<T>);
+
+   auto reduce_all = [&]() {
+      return std::tuple{sum(A * B + A),
+                        sum(A(skipN{3})),
+                        dot_prod(A, B),
+                        prod(A(seqN{0, 10})),
+                        min(A * B),
+                        max(C),
+                        min_index(A + B),
+                        max_index(A(reverse)),
+                        min_index(C),
+                        max_index(transpose(C)),
+                        sum(C)};
+   };
+
+   // Blocked reductions are bit-identical for any number of threads.
+   execution.parallel(true).threshold(0).threads(1);
+   auto r1 = reduce_all();
+   for(auto nthreads : {2, 3, 4, 7}) {
+      execution.threads(nthreads);
+      ASSERT(reduce_all() == r1);
+   }
+
+   // Minimum and maximum are not affected by the order of reduction.
+   execution.reset();
+   auto r = reduce_all();
+   ASSERT(std::get<4>(r) == std::get<4>(r1));
+   ASSERT(std::get<5>(r) == std::get<5>(r1));
+   ASSERT(std::get<6>(r) == std::get<6>(r1));
+   ASSERT(std::get<7>(r) == std::get<7>(r1));
+   ASSERT(std::get<8>(r) == std::get<8>(r1));
+   ASSERT(std::get<9>(r) == std::get<9>(r1));
+   if constexpr(Integer<T>) {
+      ASSERT(r == r1);
+   } else {
+      ASSERT(within_tol_rel(std::get<0>(r), std::get<0>(r1)));
+      ASSERT(within_tol_rel(std::get<2>(r), std::get<2>(r1)));
+      ASSERT(within_tol_rel(std::get<10>(r), std::get<10>(r1)));
+   }
+}
+
+
+template <typename T>
+void test_parallel_reduction_ties() {
+   execution.parallel(true).threshold(0).threads(4);
+
+   Array1D<T> A(20'000, One<T>);
+   A[5'000] = Zero<T>;
+   A[15'000] = Zero<T>;
+   ASSERT(min_index(A).first == 5'000_sl);
+
+   A = Zero<T>;
+   ASSERT(max_index(A).first == 0_sl);
+   ASSERT(min_index(A).first == 0_sl);
+
+   execution.reset();
+}
+
+
+template <typename T>
+void test_parallel_random() {
+   auto generate_all = [](Seed seed, Stream stream) {
+      Array1D<T> A = random<T>(1'001, Zero<T>, Strict{T(100)}, seed, stream);
+      Array1D<T> B(1'001);
+      random(B, Zero<T>, Strict{T(100)}, seed, stream);
+      Array2D<T> C = random_not0<T>(37, 27, Zero<T>, One<T>, seed, stream);
+      return std::tuple{A, B, C};
+   };
+
+   // The same seed and stream generate the same numbers for any number of threads.
+   execution.parallel(true).threshold(0).threads(1);
+   auto r1 = generate_all(Seed{7u}, Stream{});
+   for(auto nthreads : {2, 3, 4}) {
+      execution.threads(nthreads);
+      ASSERT(generate_all(Seed{7u}, Stream{}) == r1);
+   }
+   execution.reset();
+   auto [A, B, C] = r1;
+   ASSERT(generate_all(Seed{7u}, Stream{}) == r1);
+   ASSERT(A == B);
+   ASSERT(all_of(A, [](auto x) { return x >= Zero<T> && x <= Strict{T(100)}; }));
+   ASSERT(all_of(C, [](auto x) { return x > Zero<T> && x <= One<T>; }));
+
+   // Element i only depends on i, slices and rows of 2D arrays generate the same numbers.
+   Array1D<T> D(1'001);
+   random(D(seqN(0, 500)), Zero<T>, Strict{T(100)}, Seed{7u});
+   random(D(seqN(500, 501)), Zero<T>, Strict{T(100)}, Seed{7u});
+   ASSERT(D(seqN(0, 500)) == A(seqN(0, 500)));
+   ASSERT(D(seqN(500, 501)) == A(seqN(0, 501)));
+   Array2D<T> E = random<T>(7, 143, Zero<T>, Strict{T(100)}, Seed{7u});
+   ASSERT(E.view1D() == A);
+
+   // Other seeds and streams generate other numbers.
+   ASSERT(std::get<0>(generate_all(Seed{8u}, Stream{})) != A);
+   ASSERT(std::get<0>(generate_all(Seed{7u}, Stream{1u})) != A);
+
+   if constexpr(Integer<T>) {
+      Array1D<T> F = random<T>(1'000, Zero<T>, One<T>, Seed{3u});
+      ASSERT(any_of(F, [](auto x) { return x == Zero<T>; }));
+      ASSERT(any_of(F, [](auto x) { return x == One<T>; }));
+   }
+}
+
+
+void test_philox() {
+   using detail::philox4x32;
+   using W = detail::PhiloxWords<std::uint64_t>;
+   // Known answers of Random123.
+   ASSERT((philox4x32<std::uint64_t>(W{}, {})
+           == W{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+   ASSERT((philox4x32<std::uint64_t>(W{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+                                     {0xffffffff, 0xffffffff})
+           == W{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+   ASSERT((philox4x32<std::uint64_t>(W{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+                                     {0xa4093822, 0x299f31d0})
+           == W{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+
+   // Packets generate the numbers of several counters.
+   using PU = detail::Packet<std::uint64_t, 4>;
+   const auto w = philox4x32<PU>({PU::iota(5), PU{}, PU{}, PU{}}, {1, 2});
+   for(long int k = 0; k < 4; ++k) {
+      const auto v = philox4x32<std::uint64_t>(W{std::uint64_t(5 + k), 0, 0, 0}, {1, 2});
+      for(std::size_t j = 0; j < 4; ++j) {
+         ASSERT(w[j].v[k] == v[j]);
+      }
+   }
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+int main() {
+   TEST_ALL_REAL_TYPES(test_parallel_assign1D);
+   TEST_ALL_REAL_TYPES(test_parallel_assign2D);
+   TEST_ALL_REAL_TYPES(test_parallel_par);
+   TEST_ALL_REAL_TYPES(test_parallel_threshold);
+   TEST_NON_TYPE(test_parallel_exceptions);
+   TEST_NON_TYPE(test_parallel_nested);
+   TEST_ALL_REAL_TYPES(test_parallel_reductions);
+   TEST_ALL_REAL_TYPES(test_parallel_reduction_ties);
+   TEST_ALL_REAL_TYPES(test_parallel_random);
+   TEST_NON_TYPE(test_philox);
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,95 @@
+#define STRICT_PROFILE
+#include "test.hpp"
+
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+
+using namespace spp;
+
+
+// Number of calls of the region in the report, or 0 if the region is not listed.
+long int calls(const std::string& region) {
+   std::ostringstream os;
+   profiler.report(os);
+   std::istringstream is{os.str()};
+   for(std::string name; is >> name;) {
+      long int count;
+      if(name == region && is >> count) {
+         return count;
+      }
+      is.ignore(1'000, '\n');
+   }
+   return 0;
+}
+
+
+constexpr long int twice(long int x) {
+   STRICT_PROFILE_SCOPE("test/twice");
+   return 2 * x;
+}
+
+
+template <typename T>
+void test_library_regions() {
+   profiler.reset();
+   Array1D<T> A = random(1'000, Strict<T>{T(0)}, Strict<T>{T(1)});
+   Array1D<T> B(1'000);
+   for(int i = 0; i < 3; ++i) {
+      B = A + A;
+   }
+   ASSERT(sum(B) == sum(A + A));
+   ASSERT(calls("assign") >= 3);
+   ASSERT(calls("reduce/sum") == 2);
+   ASSERT(calls("reduce/max") == 0);
+
+   std::ostringstream os;
+   os << A;
+   ASSERT(calls("io/write") == 1);
+
+   profiler.reset();
+   ASSERT(calls("assign") == 0 && calls("reduce/sum") == 0);
+}
+
+
+void test_user_regions() {
+   profiler.reset();
+   static_assert(twice(2) == 4);
+   ASSERT(calls("test/twice") == 0);
+   for(long int i = 0; i < 10; ++i) {
+      ASSERT(twice(i) == 2 * i);
+   }
+   ASSERT(calls("test/twice") == 10);
+
+   {
+      STRICT_PROFILE_SCOPE("test/outer");
+      STRICT_PROFILE_SCOPE("test/inner");
+   }
+   ASSERT(calls("test/outer") == 1 && calls("test/inner") == 1);
+}
+
+
+// Regions timed by worker threads are included in the report.
+void test_parallel_regions() {
+   profiler.reset();
+   execution.parallel(true).threads(4).threshold(0);
+   Array1D<double> A(100'000), B(100'000);
+   B = generate(A, [](auto x) {
+      STRICT_PROFILE_SCOPE("test/element");
+      return x + 1._sd;
+   });
+   ASSERT(all_pos(B));
+   ASSERT(calls("test/element") == 100'000);
+   ASSERT(calls("parallel_for") == 1 && calls("assign") == 1);
+   execution.reset();
+}
+
+
+int main() {
+   profiler.report_at_exit(false);
+   TEST_ALL_FLOAT_TYPES(test_library_regions);
+   test_user_regions();
+   test_parallel_regions();
+   return EXIT_SUCCESS;
+}
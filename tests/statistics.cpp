@@ -0,0 +1,103 @@
+#define STRICT_STATISTICS
+#include "test.hpp"
+
+#include <cstdlib>
+#include <utility>
+
+
+using namespace spp;
+
+
+template <typename T>
+void test_allocations() {
+   ArrayStatisticsScope s;
+   {
+      Array1D<T> A(100);
+      ASSERT(s.count().allocations == 1);
+      ASSERT(s.count().bytes_allocated == 100 * long(sizeof(T)));
+      Array2D<T> B(10, 20);
+      ASSERT(s.count().allocations == 2);
+      ASSERT(s.count().bytes_allocated == 300 * long(sizeof(T)));
+      Array1D<T> C;
+      ASSERT(s.count().allocations == 2);
+   }
+   ASSERT(s.count().deallocations == 2);
+
+   s.reset();
+   Array1D<T> A(10);
+   A.resize(5);
+   A.resize(10);
+   ASSERT(s.count().allocations == 1);
+   A.resize(20);
+   ASSERT(s.count().allocations == 2 && s.count().deallocations == 1);
+}
+
+
+template <typename T>
+void test_copies_and_moves() {
+   Array1D<T> A(100), B(100);
+   Array2D<T> M(10, 10);
+   ArrayStatisticsScope s;
+
+   Array1D<T> C = A;
+   ASSERT((s.count() == ArrayStatistics{1, 100 * long(sizeof(T)), 0, 1, 0, 1}));
+   C = B;
+   ASSERT(s.count().copies == 2 && s.count().allocations == 1);
+
+   s.reset();
+   Array1D<T> D = std::move(C);
+   C.resize_and_assign(std::move(D));
+   ASSERT((s.count() == ArrayStatistics{0, 0, 0, 0, 2, 0}));
+
+   s.reset();
+   Array2D<T> N = M;
+   ASSERT(s.count().copies == 1 && s.count().allocations == 1);
+   Array2D<T> P = std::move(N);
+   ASSERT(s.count().moves == 1 && s.count().allocations == 1);
+}
+
+
+template <typename T>
+void test_evaluations() {
+   Array1D<T> A(100), B(100), C(100);
+   Array2D<T> M(10, 10), N(10, 10);
+   ArrayStatisticsScope s;
+
+   // Expressions are evaluated in a single pass without temporaries.
+   C = A + B * Strict<T>{T(2)} - exp(A);
+   C += A;
+   M = N + N;
+   M = transpose(N);
+   ASSERT((s.count() == ArrayStatistics{0, 0, 0, 0, 0, 4}));
+
+   s.reset();
+   C = Zero<T>;
+   [[maybe_unused]] auto x = sum(A + B) + dot_prod(A, B) + max(A);
+   ASSERT((s.count() == ArrayStatistics{0, 0, 0, 0, 0, 1}));
+
+   // Partial sums of pairwise sums are kept on the stack.
+   s.reset();
+   x = semi_stable_sum(A) + sum(A, PairwiseSum);
+   ASSERT(s.count().allocations == 0);
+
+   s.reset();
+   Array1D<T> D = A + B;
+   ASSERT((s.count() == ArrayStatistics{1, 100 * long(sizeof(T)), 0, 0, 0, 1}));
+}
+
+
+void test_reset() {
+   Array1D<double> A(10);
+   ASSERT(array_statistics().allocations > 0);
+   reset_array_statistics();
+   ASSERT(array_statistics() == ArrayStatistics{});
+}
+
+
+int main() {
+   TEST_ALL_FLOAT_TYPES(test_allocations);
+   TEST_ALL_FLOAT_TYPES(test_copies_and_moves);
+   TEST_ALL_FLOAT_TYPES(test_evaluations);
+   test_reset();
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,275 @@
+#include "test.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+
+
+using namespace spp;
+
+
+static std::string temp_file(const std::string& name) {
+   return (std::filesystem::temp_directory_path() / ("strictpp_" + name)).string();
+}
+
+
+static void write_file(const std::string& file_path, const std::string& s) {
+   std::ofstream{file_path, std::ios::binary} << s;
+}
+
+
+template <typename T>
+Array2D<T> values(long int m, long int n) {
+   Array2D<T> A(m, n);
+   for(long int i = 0; i < m; ++i) {
+      for(long int j = 0; j < n; ++j) {
+         A(i, j) = Strict{T((i * 5 + j * 3) % 7)};
+      }
+   }
+   return A;
+}
+
+
+template <typename T>
+void test_round_trip() {
+   auto A = values<T>(23, 11);
+   Array1D<T> x = A.view1D();
+   std::stringstream ss1, ss2;
+   ss1 << x;
+   ss2 << A;
+
+   Array1D<T> y;
+   Array2D<T> B;
+   Array2D<T, Aligned, ColMajor> BC;
+   ss1 >> y;
+   ASSERT(y == x && ss1.good());
+   ss2 >> B;
+   ASSERT(B == A && ss2.eof());
+   std::stringstream ss3{ss2.str()};
+   ss3 >> BC;
+   ASSERT(BC == A);
+
+   const auto file = temp_file("round_trip.txt");
+   print_to_file(file, A);
+   read_from_file(file, y);
+   read_from_file(file, B);
+   ASSERT(y == x && B == A);
+   std::filesystem::remove(file);
+}
+
+
+void test_formats() {
+   std::stringstream ss{" +1 -2\t3e2 \n\n  4.5 .5 nan \r\n"};
+   Array1D<double> x;
+   ss >> x;
+   ASSERT(x.size() == 6_sl && x[0] == 1._sd && x[1] == -2._sd && x[2] == 300._sd);
+   ASSERT(x[3] == 4.5_sd && x[4] == 0.5_sd && std::isnan(x[5].val()));
+
+   std::stringstream sb{"true 0 1 false"};
+   Array1D<bool> b;
+   sb >> b;
+   ASSERT((b == Array1D<bool>{true_sb, false_sb, true_sb, false_sb}));
+
+   std::stringstream sm{"\n  \n1 2 3\n \n4 5 6\n\n"};
+   Array2D<long int> A;
+   sm >> A;
+   ASSERT((A == Array2D<long int>{{1_sl, 2_sl, 3_sl}, {4_sl, 5_sl, 6_sl}}));
+
+   std::stringstream se{"  \n\n"};
+   se >> A;
+   ASSERT(A.empty());
+   se.clear();
+   se.str("");
+   se >> x;
+   ASSERT(x.empty());
+
+#ifdef STRICT_QUAD_PRECISION
+   std::stringstream sq{"1.5 +2.25\n-3e1"};
+   Array1D<float128> q;
+   sq >> q;
+   ASSERT((q == Array1D<float128>{Strict{float128(1.5)}, Strict{float128(2.25)},
+                                  Strict{float128(-30)}}));
+#endif
+}
+
+
+void test_invalid_input() {
+   Array1D<int> x{1_si};
+   Array1D<unsigned> u;
+   Array2D<double> A;
+   for(const char* s : {"1 2.5", "1 a", "1 +-2", "1,2", "99999999999"}) {
+      std::stringstream ss{s};
+      REQUIRE_THROW(ss >> x);
+   }
+   ASSERT(x == Array1D<int>{1_si});
+
+   std::stringstream su{"1 -1"};
+   REQUIRE_THROW(su >> u);
+   std::stringstream sa{"1 2\n3 4 5\n"};
+   REQUIRE_THROW(sa >> A);
+   REQUIRE_THROW(read_from_file(temp_file("does_not_exist.txt"), A));
+}
+
+
+void test_csv() {
+   const auto file = temp_file("values.csv");
+   write_file(file, "1.5, 2,3\n\n4 ,5,   6\n");
+   Array2D<double> A;
+   Array2D<double, Aligned, ColMajor> AC;
+   Array1D<double> x;
+   read_from_csv(file, A);
+   read_from_csv(file, AC);
+   read_from_csv(file, x);
+   ASSERT((A == Array2D<double>{{1.5_sd, 2._sd, 3._sd}, {4._sd, 5._sd, 6._sd}}));
+   ASSERT(AC == A && x == A.view1D());
+
+   write_file(file, "1;2\n3;4\n");
+   read_from_csv(file, A, ';');
+   ASSERT((A == Array2D<double>{{1._sd, 2._sd}, {3._sd, 4._sd}}));
+   REQUIRE_THROW(read_from_csv(file, A));
+   REQUIRE_THROW(read_from_csv(file, A, ' '));
+   REQUIRE_THROW(read_from_csv(file, A, '-'));
+
+   for(const char* s : {"1,,2\n", "1,2,\n", ",1\n", "1 2,3\n", "1,2\n3\n"}) {
+      write_file(file, s);
+      REQUIRE_THROW(read_from_csv(file, A));
+   }
+
+   write_file(file, "");
+   read_from_csv(file, A);
+   read_from_file(file, x);
+   ASSERT(A.empty() && x.empty());
+   std::filesystem::remove(file);
+}
+
+
+// Large inputs are split into chunks parsed by different threads.
+void test_parallel() {
+   const auto file = temp_file("parallel.csv");
+   auto A = values<long int>(1'000, 37);
+   {
+      std::ofstream ofs{file};
+      for(long int i = 0; i < 1'000; ++i) {
+         for(long int j = 0; j < 37; ++j) {
+            ofs << A(i, j) << (j < 36 ? ", " : "\n");
+         }
+      }
+   }
+
+   Array2D<long int> B, C;
+   Array1D<long int> x, y;
+   read_from_csv(file, B);
+   read_from_csv(file, x);
+   execution.parallel(true).threads(4).threshold(0);
+   read_from_csv(file, C);
+   read_from_csv(file, y);
+   ASSERT(B == A && C == A && x == A.view1D() && y == x);
+
+   std::stringstream ss;
+   ss << A.view1D();
+   ss >> y;
+   ASSERT(y == x);
+
+   {
+      std::ofstream ofs{file, std::ios::app};
+      ofs << "1, 2\n";
+   }
+   REQUIRE_THROW(read_from_csv(file, C));
+   execution.reset();
+   REQUIRE_THROW(read_from_csv(file, C));
+   std::filesystem::remove(file);
+}
+
+
+// Inputs shorter than the number of threads are split into fewer chunks.
+void test_parallel_short() {
+   const auto file = temp_file("short.txt");
+   execution.parallel(true).threads(4).threshold(0);
+   for(const char* s : {"", "7", "1 2", "1 2\n"}) {
+      std::istringstream is{s};
+      Array1D<double> x;
+      is >> x;
+      write_file(file, s);
+      Array1D<double> y;
+      read_from_file(file, y);
+      ASSERT(x == y && x.size() == (s[0] == '\0' ? 0_sl : s[0] == '7' ? 1_sl : 2_sl));
+   }
+   write_file(file, "1,2\n");
+   Array2D<double> A;
+   read_from_csv(file, A);
+   ASSERT(A.rows() == 1_sl && A.cols() == 2_sl);
+   execution.reset();
+   std::filesystem::remove(file);
+}
+
+
+// Shortest representation is read back exactly.
+template <typename T>
+void test_shortest() {
+   const auto file = temp_file("shortest.txt");
+   Array2D<T> A(17, 5);
+   for(long int i = 0; i < A.rows().val(); ++i) {
+      for(long int j = 0; j < A.cols().val(); ++j) {
+         A(i, j) = Strict{T(i - 8) / T(j + 3) * T(1e-3)};
+      }
+   }
+   A(0, 0) = Strict{std::numeric_limits<T>::max()};
+   A(0, 1) = Strict{std::numeric_limits<T>::min()};
+   A(0, 2) = Strict{-T(0)};
+
+   format.shortest(true);
+   print_to_file(file, A);
+   std::stringstream ss;
+   ss << Strict{T(1) / T(10)} << ' ' << Strict{T(-1.5)};
+   format.reset();
+
+   Array2D<T> B;
+   read_from_file(file, B);
+   ASSERT(B == A && std::signbit(B(0, 2).val()));
+   ASSERT(ss.str() == "+0.1 -1.5");
+   std::filesystem::remove(file);
+}
+
+
+// Text formatted in parallel is identical to the one formatted serially.
+void test_parallel_write() {
+   auto A = values<double>(3'001, 13);
+   A(7, 3) = -1._sd / 3._sd;
+   std::stringstream s1, s2, s3, s4;
+   array_format.detailed(true);
+   s1 << A << A.view1D();
+   array_format.reset().row_style();
+   s3 << A.view1D();
+   array_format.reset();
+
+   execution.parallel(true).threads(4).threshold(0);
+   array_format.detailed(true);
+   s2 << A << A.view1D();
+   array_format.reset().row_style();
+   s4 << A.view1D();
+   array_format.reset();
+   execution.reset();
+   ASSERT(s1.str() == s2.str() && s3.str() == s4.str());
+
+   std::stringstream s5;
+   Array2D<int> C{{1_si, -20_si}, {300_si, 4_si}};
+   s5 << C;
+   ASSERT(s5.str() == "   +1    -20\n +300     +4\n");
+}
+
+
+int main() {
+   TEST_ALL_TYPES(test_round_trip);
+   TEST_NON_TYPE(test_formats);
+   TEST_NON_TYPE(test_invalid_input);
+   TEST_NON_TYPE(test_csv);
+   TEST_NON_TYPE(test_parallel);
+   TEST_NON_TYPE(test_parallel_short);
+   TEST_STANDARD_FLOAT_TYPES(test_shortest);
+   TEST_NON_TYPE(test_parallel_write);
+   return EXIT_SUCCESS;
+}
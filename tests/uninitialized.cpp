@@ -0,0 +1,82 @@
+#include "test.hpp"
+
+#include <cstdlib>
+#include <memory_resource>
+
+
+using namespace spp;
+
+
+template <typename T>
+void test_uninitialized1D() {
+   Array1D<T> A(100, uninitialized);
+   ASSERT(A.size() == 100_sl);
+   A = One<T>;
+   ASSERT(A == const1D<T>(100, One<T>));
+
+   Array1D<T, Aligned> B(Size{100}, uninitialized);
+   B = A + A;
+   ASSERT(B == A + A);
+   ASSERT(Array1D<T>(0, uninitialized).empty());
+
+   // Old elements are preserved, new elements are uninitialized.
+   A.resize(150, uninitialized);
+   ASSERT(A(seqN{0, 100}) == const1D<T>(100, One<T>));
+   A.resize(50, uninitialized);
+   ASSERT(A == const1D<T>(50, One<T>));
+
+   std::pmr::monotonic_buffer_resource arena;
+   Array1D<T> C(10, uninitialized, &arena);
+   ASSERT(C.resource() == &arena);
+   C = Zero<T>;
+   ASSERT(all_zeros(C));
+}
+
+
+template <typename T>
+void test_uninitialized2D() {
+   Array2D<T> A(7, 9, uninitialized);
+   A = One<T>;
+   ASSERT(A == const2D<T>(7, 9, One<T>));
+
+   Array2D<T, Aligned> B(Rows{3}, Cols{4}, uninitialized);
+   ASSERT(B.rows() == 3_sl && B.cols() == 4_sl);
+
+   A.resize(10, 10, uninitialized);
+   ASSERT(A(seqN{0, 7}, seqN{0, 9}) == const2D<T>(7, 9, One<T>));
+   A.resize(5, 5, uninitialized, false);
+   ASSERT(A.rows() == 5_sl && A.cols() == 5_sl);
+}
+
+
+template <typename T>
+void test_first_touch() {
+   execution.threads(4);
+   for(auto n : {0_sl, 1_sl, 17_sl, 10'001_sl}) {
+      Array1D<T> A(n, first_touch);
+      Array1D<T, Aligned> B(Size{n}, first_touch);
+      ASSERT(A.size() == n && all_zeros(A, true_sb) && all_zeros(B, true_sb));
+   }
+
+   Array2D<T> C(33, 65, first_touch);
+   Array2D<T, Aligned> D(Rows{33}, Cols{65}, first_touch);
+   ASSERT(all_zeros(C) && all_zeros(D));
+
+   // The pool is not used inside of parallel regions.
+   execution.parallel(true).threshold(0);
+   Array1D<T> E = row_reduce(C, [](const auto& row) {
+      return sum(Array1D<T>(row.size(), first_touch), Zero<T>);
+   });
+   ASSERT(all_zeros(E));
+
+   execution.reset();
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+int main() {
+   TEST_ALL_REAL_TYPES(test_uninitialized1D);
+   TEST_ALL_REAL_TYPES(test_uninitialized2D);
+   TEST_ALL_REAL_TYPES(test_first_touch);
+   return EXIT_SUCCESS;
+}